@@ -0,0 +1,128 @@
+#include <benchmark/benchmark.h>
+
+#include "bench_utils.h"
+#include "core/GraphValidator.h"
+#include "core/ReachabilityIndex.h"
+#include "core/Room.h"
+#include "core/RunGraph.h"
+
+/**
+ * Benchmarks: Room
+ */
+
+static void BM_RoomConstruction(benchmark::State& state) {
+  for (auto _ : state) {
+    Room room("room_42", Room::Type::Combat);
+    benchmark::DoNotOptimize(room);
+  }
+  BenchUtils::SetRoomCounters(state, 1);
+}
+BENCHMARK(BM_RoomConstruction);
+
+/**
+ * Benchmarks: RunGraph construction
+ */
+
+static void BM_RunGraphAddRoom(benchmark::State& state) {
+  const int64_t roomCount = state.range(0);
+  for (auto _ : state) {
+    RunGraph graph;
+    for (int64_t i = 0; i < roomCount; ++i) {
+      benchmark::DoNotOptimize(graph.AddRoom("room_" + std::to_string(i + 1), Room::Type::Combat));
+    }
+  }
+  BenchUtils::SetRoomCounters(state, roomCount);
+}
+BENCHMARK(BM_RunGraphAddRoom)->Apply(BenchUtils::GraphSizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_RunGraphConnectChain(benchmark::State& state) {
+  const int64_t roomCount = state.range(0);
+  for (auto _ : state) {
+    auto graph = BenchUtils::BuildChain(roomCount, false);
+    benchmark::DoNotOptimize(graph.GetStartNode());
+  }
+  BenchUtils::SetRoomCounters(state, roomCount);
+}
+BENCHMARK(BM_RunGraphConnectChain)->Apply(BenchUtils::GraphSizes)->Unit(benchmark::kMicrosecond);
+
+static void BM_RunGraphFinalize(benchmark::State& state) {
+  const int64_t roomCount = state.range(0);
+  for (auto _ : state) {
+    state.PauseTiming();
+    auto graph = BenchUtils::BuildChain(roomCount, false);
+    state.ResumeTiming();
+
+    graph.Finalize();
+    benchmark::DoNotOptimize(graph.GetStartNode());
+
+    state.PauseTiming();
+    { auto discard = std::move(graph); }
+    state.ResumeTiming();
+  }
+  BenchUtils::SetRoomCounters(state, roomCount);
+}
+BENCHMARK(BM_RunGraphFinalize)->Apply(BenchUtils::GraphSizes)->Unit(benchmark::kMicrosecond);
+
+/**
+ * Benchmarks: GraphValidator
+ */
+
+static void BM_Validate(benchmark::State& state) {
+  const int64_t roomCount = state.range(0);
+  const bool finalized = state.range(1) != 0;
+  auto graph = BenchUtils::BuildChain(roomCount, finalized);
+
+  GraphValidator validator;
+  for (auto _ : state) {
+    auto result = validator.Validate(graph);
+    benchmark::DoNotOptimize(result.isValid);
+  }
+  BenchUtils::SetRoomCounters(state, roomCount);
+}
+BENCHMARK(BM_Validate)
+    ->ArgsProduct({{50, 1'000, 10'000, 100'000, 1'000'000}, {0, 1}})
+    ->ArgNames({"rooms", "finalized"})
+    ->Unit(benchmark::kMicrosecond);
+
+/**
+ * Benchmarks: ReachabilityIndex
+ */
+
+// Building the index; mode 0 forces the closure, 1 forces intervals
+static void BM_ReachabilityBuild(benchmark::State& state) {
+  const int64_t roomCount = state.range(0);
+  const size_t budget = state.range(1) == 0 ? SIZE_MAX : 0;
+  auto graph = BenchUtils::BuildChain(roomCount, true);
+
+  size_t bytes = 0;
+  for (auto _ : state) {
+    ReachabilityIndex index(graph, budget);
+    bytes = index.GetMemoryBytes();
+    benchmark::DoNotOptimize(bytes);
+  }
+  state.counters["index_bytes"] = static_cast<double>(bytes);
+  BenchUtils::SetRoomCounters(state, roomCount);
+}
+BENCHMARK(BM_ReachabilityBuild)
+    ->ArgsProduct({{50, 1'000, 30'000}, {0, 1}})
+    ->ArgNames({"rooms", "intervals"})
+    ->Unit(benchmark::kMicrosecond);
+
+// Random pair queries against a prebuilt index
+static void BM_ReachabilityQuery(benchmark::State& state) {
+  const int64_t roomCount = state.range(0);
+  const size_t budget = state.range(1) == 0 ? SIZE_MAX : 0;
+  auto graph = BenchUtils::BuildChain(roomCount, true);
+  ReachabilityIndex index(graph, budget);
+
+  uint64_t pair = BenchUtils::BENCH_SEED;
+  for (auto _ : state) {
+    pair = pair * 6364136223846793005ULL + 1442695040888963407ULL;
+    const auto from = static_cast<RunGraph::NodeIndex>((pair >> 32) % roomCount);
+    const auto to = static_cast<RunGraph::NodeIndex>((pair & 0xffffffff) % roomCount);
+    benchmark::DoNotOptimize(index.CanReach(from, to));
+  }
+}
+BENCHMARK(BM_ReachabilityQuery)
+    ->ArgsProduct({{1'000, 30'000}, {0, 1}})
+    ->ArgNames({"rooms", "intervals"});
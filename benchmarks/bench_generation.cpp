@@ -0,0 +1,419 @@
+#include <benchmark/benchmark.h>
+
+#include <algorithm>
+#include <chrono>
+#include <random>
+#include <vector>
+
+#include "../tests/allocation_counter.h"
+#include "analytics/RunAnalytics.h"
+#include "bench_utils.h"
+#include "core/PathCounter.h"
+#include "generation/PathGenerator.h"
+#include "generation/RunCache.h"
+#include "generation/SeedSearch.h"
+
+/**
+ * Benchmarks: PathGenerator
+ */
+
+// Default config (40-50 rooms), reported as runs per second
+static void BM_GeneratePathDefault(benchmark::State& state) {
+  std::mt19937 rng(BenchUtils::BENCH_SEED);
+  PathGenerator generator(rng);
+
+  int64_t rooms = 0;
+  TestUtils::AllocationScope allocations;
+  for (auto _ : state) {
+    auto graph = generator.GeneratePath();
+    rooms += static_cast<int64_t>(graph.GetNodeCount());
+    benchmark::DoNotOptimize(graph.GetStartNode());
+  }
+  state.counters["runs_per_second"] =
+      benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+  state.counters["time_per_room"] = benchmark::Counter(
+      static_cast<double>(rooms), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+  state.counters["allocs_per_run"] = benchmark::Counter(
+      static_cast<double>(allocations.GetAllocations()), benchmark::Counter::kAvgIterations);
+}
+BENCHMARK(BM_GeneratePathDefault);
+
+// Fixed-length runs from 50 rooms up to stress sizes
+static void BM_GeneratePath(benchmark::State& state) {
+  const int64_t roomCount = state.range(0);
+  std::mt19937 rng(BenchUtils::BENCH_SEED);
+  PathGenerator generator(rng);
+
+  PathGenerator::Config config;
+  config.minRooms = static_cast<int>(roomCount);
+  config.maxRooms = static_cast<int>(roomCount);
+  generator.SetConfig(config);
+
+  for (auto _ : state) {
+    auto graph = generator.GeneratePath();
+    benchmark::DoNotOptimize(graph.GetStartNode());
+  }
+  state.counters["runs_per_second"] =
+      benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+  BenchUtils::SetRoomCounters(state, roomCount);
+}
+BENCHMARK(BM_GeneratePath)->Apply(BenchUtils::GraphSizes)->Unit(benchmark::kMicrosecond);
+
+// 50-room runs, linear (branchProbability 0) vs branched (default 0.3);
+// the branched run also builds its extra rooms, reported per room
+static void BM_GeneratePathBranching(benchmark::State& state) {
+  std::mt19937 rng(BenchUtils::BENCH_SEED);
+  PathGenerator generator(rng);
+
+  PathGenerator::Config config;
+  config.minRooms = 50;
+  config.maxRooms = 50;
+  config.branchProbability = static_cast<float>(state.range(0)) / 100.0f;
+  generator.SetConfig(config);
+
+  int64_t rooms = 0;
+  for (auto _ : state) {
+    auto graph = generator.GeneratePath();
+    rooms += static_cast<int64_t>(graph.GetNodeCount());
+    benchmark::DoNotOptimize(graph.GetStartNode());
+  }
+  state.counters["runs_per_second"] =
+      benchmark::Counter(static_cast<double>(state.iterations()), benchmark::Counter::kIsRate);
+  state.counters["time_per_room"] = benchmark::Counter(
+      static_cast<double>(rooms), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK(BM_GeneratePathBranching)->Arg(0)->Arg(30)->ArgName("branch_percent");
+
+// Time until a streamed run yields its start room, against the run length
+static void BM_StreamFirstRoom(benchmark::State& state) {
+  PathGenerator generator(uint64_t{BenchUtils::BENCH_SEED});
+  PathGenerator::Config config;
+  config.minRooms = static_cast<int>(state.range(0));
+  config.maxRooms = static_cast<int>(state.range(0));
+  generator.SetConfig(config);
+
+  for (auto _ : state) {
+    RunStream stream = generator.GenerateStream();
+    stream.Next();
+    benchmark::DoNotOptimize(stream.Get().type);
+  }
+}
+BENCHMARK(BM_StreamFirstRoom)->Apply(BenchUtils::GraphSizes)->Unit(benchmark::kMicrosecond);
+
+// Whole streamed run, comparable with BM_GeneratePath
+static void BM_StreamWholeRun(benchmark::State& state) {
+  PathGenerator generator(uint64_t{BenchUtils::BENCH_SEED});
+  PathGenerator::Config config;
+  config.minRooms = static_cast<int>(state.range(0));
+  config.maxRooms = static_cast<int>(state.range(0));
+  generator.SetConfig(config);
+
+  for (auto _ : state) {
+    RunStream stream = generator.GenerateStream();
+    size_t events = 0;
+    while (stream.Next()) ++events;
+    benchmark::DoNotOptimize(events);
+    benchmark::DoNotOptimize(stream.TakeGraph().GetStartNode());
+  }
+  BenchUtils::SetRoomCounters(state, state.range(0));
+}
+BENCHMARK(BM_StreamWholeRun)->Apply(BenchUtils::GraphSizes)->Unit(benchmark::kMicrosecond);
+
+// Batch of default-config runs; thread count is the second argument
+static void BM_GenerateBatch(benchmark::State& state) {
+  std::vector<uint64_t> seeds(static_cast<size_t>(state.range(0)));
+  for (size_t i = 0; i < seeds.size(); ++i) {
+    seeds[i] = BenchUtils::BENCH_SEED + i;
+  }
+  const auto threadCount = static_cast<unsigned>(state.range(1));
+
+  for (auto _ : state) {
+    auto runs = PathGenerator::GenerateBatch(seeds, PathGenerator::Config{}, threadCount);
+    benchmark::DoNotOptimize(runs.data());
+  }
+  state.counters["runs_per_second"] = benchmark::Counter(
+      static_cast<double>(seeds.size()), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_GenerateBatch)
+    ->ArgsProduct({{1'000}, {1, 2, 4, 8}})
+    ->ArgNames({"runs", "threads"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+// Alias-table sampling of one run's worth of room types from a word block
+static void BM_RoomTypeSampleBulk(benchmark::State& state) {
+  RoomTypeSampler sampler(PathGenerator::DEFAULT_ROOM_TYPE_WEIGHTS);
+  std::vector<uint32_t> words(static_cast<size_t>(state.range(0)));
+  CounterRng rng(BenchUtils::BENCH_SEED, 0);
+  for (uint32_t& word : words) word = rng();
+  std::vector<Room::Type> types(words.size());
+
+  for (auto _ : state) {
+    sampler.SampleBulk(words, types);
+    benchmark::DoNotOptimize(types.data());
+  }
+  BenchUtils::SetRoomCounters(state, state.range(0));
+}
+BENCHMARK(BM_RoomTypeSampleBulk)->Arg(50)->Arg(100'000);
+
+/**
+ * Benchmarks: RunAnalytics
+ */
+
+// Generating and reducing runs across threads, reported as seeds per second
+static void BM_RunAnalyticsCollect(benchmark::State& state) {
+  const auto seedCount = static_cast<uint64_t>(state.range(0));
+  const auto threadCount = static_cast<unsigned>(state.range(1));
+  const PathGenerator::Config config;
+
+  for (auto _ : state) {
+    auto analytics = RunAnalytics::Collect(config, BenchUtils::BENCH_SEED, seedCount, threadCount);
+    benchmark::DoNotOptimize(analytics.GetRoomCount());
+  }
+  state.counters["seeds_per_second"] = benchmark::Counter(
+      static_cast<double>(seedCount), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_RunAnalyticsCollect)
+    ->ArgsProduct({{10'000}, {1, 2, 4, 8}})
+    ->ArgNames({"seeds", "threads"})
+    ->Unit(benchmark::kMillisecond)
+    ->UseRealTime();
+
+/**
+ * Benchmarks: PathCounter
+ */
+
+// Counting routes of a branching run of the given critical length
+static void BM_PathCount(benchmark::State& state) {
+  PathGenerator::Config config;
+  config.minRooms = config.maxRooms = static_cast<int>(state.range(0));
+  config.branchProbability = 0.3f;
+  PathGenerator generator(uint64_t{BenchUtils::BENCH_SEED});
+  generator.SetConfig(config);
+  const RunGraph graph = generator.GeneratePath();
+
+  for (auto _ : state) {
+    PathCounter counter(graph);
+    benchmark::DoNotOptimize(counter.GetPathCount());
+  }
+  BenchUtils::SetRoomCounters(state, static_cast<int64_t>(graph.GetNodeCount()));
+}
+BENCHMARK(BM_PathCount)->Arg(50)->Arg(300)->Unit(benchmark::kMicrosecond);
+
+// Uniform route sampling; 300 rooms has more than 2^64 routes (wide path)
+static void BM_PathSampleBatch(benchmark::State& state) {
+  PathGenerator::Config config;
+  config.minRooms = config.maxRooms = static_cast<int>(state.range(0));
+  config.branchProbability = 0.3f;
+  PathGenerator generator(uint64_t{BenchUtils::BENCH_SEED});
+  generator.SetConfig(config);
+  const RunGraph graph = generator.GeneratePath();
+  const PathCounter counter(graph);
+
+  constexpr size_t BATCH = 10'000;
+  std::vector<RunGraph::NodeIndex> nodes;
+  std::vector<uint32_t> offsets;
+  for (auto _ : state) {
+    counter.SampleBatch(BenchUtils::BENCH_SEED, BATCH, nodes, offsets);
+    benchmark::DoNotOptimize(nodes.data());
+  }
+  state.counters["paths_per_second"] =
+      benchmark::Counter(static_cast<double>(BATCH), benchmark::Counter::kIsIterationInvariantRate);
+}
+BENCHMARK(BM_PathSampleBatch)->Arg(50)->Arg(300)->Unit(benchmark::kMillisecond);
+
+// A typical designer query: 3+ Fountains before depth 20 and no Elite in
+// the first 5 rooms. Args = matches wanted, threads
+static void BM_SeedSearch(benchmark::State& state) {
+  const PathGenerator::Config config;
+  const RunPredicate query = RunPredicate::AtLeast(Room::Type::Fountain, 3, 0, 20) &&
+                             RunPredicate::AtMost(Room::Type::Elite, 0, 0, 5);
+  SeedSearch::Options options;
+  options.firstSeed = BenchUtils::BENCH_SEED;
+  options.maxMatches = static_cast<size_t>(state.range(0));
+  options.threadCount = static_cast<unsigned>(state.range(1));
+
+  uint64_t generated = 0;
+  for (auto _ : state) {
+    auto result = SeedSearch::Find(config, query, options);
+    generated += result.seedsGenerated;
+    benchmark::DoNotOptimize(result.seeds.data());
+  }
+  state.counters["seeds_per_second"] =
+      benchmark::Counter(static_cast<double>(generated), benchmark::Counter::kIsRate);
+}
+BENCHMARK(BM_SeedSearch)
+    ->ArgNames({"matches", "threads"})
+    ->Args({100, 1})
+    ->Args({100, 4})
+    ->Unit(benchmark::kMillisecond);
+
+// Baseline for BM_SeedSearch: generate every seed fully, then inspect the graph
+static void BM_SeedSearchFullGeneration(benchmark::State& state) {
+  const PathGenerator::Config config;
+  const RunPredicate query = RunPredicate::AtLeast(Room::Type::Fountain, 3, 0, 20) &&
+                             RunPredicate::AtMost(Room::Type::Elite, 0, 0, 5);
+  const auto wanted = static_cast<size_t>(state.range(0));
+  PathGenerator generator(BenchUtils::BENCH_SEED);
+
+  for (auto _ : state) {
+    std::vector<uint64_t> seeds;
+    for (uint64_t seed = BenchUtils::BENCH_SEED; seeds.size() < wanted; ++seed) {
+      generator.SetSeed(seed);
+      if (query.Matches(generator.GeneratePath())) seeds.push_back(seed);
+    }
+    benchmark::DoNotOptimize(seeds.data());
+  }
+}
+BENCHMARK(BM_SeedSearchFullGeneration)->Arg(100)->Unit(benchmark::kMillisecond);
+
+/**
+ * Benchmarks: RunCache
+ * Hit latency over a warm working set, against BM_GeneratePathDefault for a miss
+ */
+
+static void BM_RunCacheHit(benchmark::State& state) {
+  constexpr uint64_t SEEDS = 256;
+  static RunCache cache(64 << 20);
+  const PathGenerator::Config config;
+  const uint64_t hash = RunCache::HashConfig(config);
+  if (state.thread_index() == 0) {
+    for (uint64_t seed = 0; seed < SEEDS; ++seed) {
+      cache.GetOrGenerate(seed, config, hash);
+    }
+  }
+
+  uint64_t seed = static_cast<uint64_t>(state.thread_index()) * 31;
+  for (auto _ : state) {
+    auto run = cache.GetOrGenerate(seed, config, hash);
+    benchmark::DoNotOptimize(run.get());
+    seed = (seed + 1) % SEEDS;
+  }
+}
+BENCHMARK(BM_RunCacheHit)->Threads(1)->Threads(4);
+
+/**
+ * Benchmarks: Policy-based generation
+ * The runtime PathGenerator against StaticPathGenerator compiled for the
+ * same (default) config; both counter-based and reseeded per run
+ */
+
+using DefaultStaticGenerator = StaticPathGenerator<StaticGeneratorConfig{}>;
+
+template <typename Generator>
+static void BM_PolicyGeneratePath(benchmark::State& state) {
+  Generator generator(uint64_t{BenchUtils::BENCH_SEED});
+  uint64_t seed = BenchUtils::BENCH_SEED;
+  int64_t rooms = 0;
+  for (auto _ : state) {
+    generator.SetSeed(seed++);
+    auto graph = generator.GeneratePath();
+    rooms += static_cast<int64_t>(graph.GetNodeCount());
+    benchmark::DoNotOptimize(graph.GetStartNode());
+  }
+  state.counters["time_per_room"] = benchmark::Counter(
+      static_cast<double>(rooms), benchmark::Counter::kIsRate | benchmark::Counter::kInvert);
+}
+BENCHMARK_TEMPLATE(BM_PolicyGeneratePath, PathGenerator);
+BENCHMARK_TEMPLATE(BM_PolicyGeneratePath, DefaultStaticGenerator);
+
+// Time one run spends in a phase the policies specialize. RoomTypes is
+// timed around GeneratePathIf() stopping once types are final (length
+// draw, bulk sampling, structural rooms and the shared placement solve),
+// so it needs no stats timers and runs with stats off; BranchPlan can
+// only be read from the GenerationStats phase timers.
+template <GenerationStats::Phase PHASE, typename Generator>
+static uint64_t TimePolicyPhase(Generator& generator, const GenerationStats& stats, uint64_t seed) {
+  generator.SetSeed(seed);
+  if constexpr (PHASE == GenerationStats::Phase::RoomTypes) {
+    static const RunPredicate rejectAtTypes =
+        RunPredicate::Custom([](const RunPredicate::View& view) {
+          return view.stage == RunPredicate::Stage::Length ? RunPredicate::Verdict::Pending
+                                                           : RunPredicate::Verdict::Reject;
+        });
+    const auto start = std::chrono::steady_clock::now();
+    benchmark::DoNotOptimize(generator.GeneratePathIf(rejectAtTypes));
+    const auto elapsed = std::chrono::steady_clock::now() - start;
+    return static_cast<uint64_t>(
+        std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+  } else {
+    benchmark::DoNotOptimize(generator.GeneratePath());
+    return stats.GetPhaseNanos(PHASE);
+  }
+}
+
+template <GenerationStats::Phase PHASE>
+static constexpr bool NeedsStats() {
+  return PHASE != GenerationStats::Phase::RoomTypes;
+}
+
+template <typename Generator, GenerationStats::Phase PHASE>
+static void BM_PolicyPhase(benchmark::State& state) {
+  if constexpr (NeedsStats<PHASE>() && !Stats::ENABLED) {
+    state.SkipWithError("Built with TARTARUS_ENABLE_STATS=OFF");
+    return;
+  }
+  GenerationStats stats;
+  Generator generator(uint64_t{BenchUtils::BENCH_SEED});
+  if constexpr (NeedsStats<PHASE>()) generator.SetStats(&stats);
+  uint64_t seed = BenchUtils::BENCH_SEED;
+  for (auto _ : state) {
+    const uint64_t nanos = TimePolicyPhase<PHASE>(generator, stats, seed++);
+    state.SetIterationTime(static_cast<double>(nanos) * 1e-9);
+  }
+}
+BENCHMARK_TEMPLATE(BM_PolicyPhase, PathGenerator, GenerationStats::Phase::RoomTypes)
+    ->UseManualTime();
+BENCHMARK_TEMPLATE(BM_PolicyPhase, DefaultStaticGenerator, GenerationStats::Phase::RoomTypes)
+    ->UseManualTime();
+BENCHMARK_TEMPLATE(BM_PolicyPhase, PathGenerator, GenerationStats::Phase::BranchPlan)
+    ->UseManualTime();
+BENCHMARK_TEMPLATE(BM_PolicyPhase, DefaultStaticGenerator, GenerationStats::Phase::BranchPlan)
+    ->UseManualTime();
+
+// Both generators on the same seed each iteration, so machine drift hits
+// them alike. Which one runs first alternates, as the second reuses the
+// first's warm caches (worth far more than either phase saves). saved_ns
+// is the runtime generator's time minus the static one's per run; for
+// RoomTypes the shared placement solve dominates both times, so it is the
+// clearer figure there than speedup.
+template <GenerationStats::Phase PHASE>
+static void BM_PolicyPhaseSpeedup(benchmark::State& state) {
+  if constexpr (NeedsStats<PHASE>() && !Stats::ENABLED) {
+    state.SkipWithError("Built with TARTARUS_ENABLE_STATS=OFF");
+    return;
+  }
+  GenerationStats runtimeStats;
+  GenerationStats staticStats;
+  PathGenerator runtimeGenerator(uint64_t{BenchUtils::BENCH_SEED});
+  DefaultStaticGenerator staticGenerator(uint64_t{BenchUtils::BENCH_SEED});
+  if constexpr (NeedsStats<PHASE>()) {
+    runtimeGenerator.SetStats(&runtimeStats);
+    staticGenerator.SetStats(&staticStats);
+  }
+
+  uint64_t seed = BenchUtils::BENCH_SEED;
+  uint64_t runtimeNanos = 0;
+  uint64_t staticNanos = 0;
+  for (auto _ : state) {
+    if (seed % 2 == 0) {
+      runtimeNanos += TimePolicyPhase<PHASE>(runtimeGenerator, runtimeStats, seed);
+      staticNanos += TimePolicyPhase<PHASE>(staticGenerator, staticStats, seed);
+    } else {
+      staticNanos += TimePolicyPhase<PHASE>(staticGenerator, staticStats, seed);
+      runtimeNanos += TimePolicyPhase<PHASE>(runtimeGenerator, runtimeStats, seed);
+    }
+    ++seed;
+  }
+  state.counters["runtime_ns"] =
+      benchmark::Counter(static_cast<double>(runtimeNanos), benchmark::Counter::kAvgIterations);
+  state.counters["static_ns"] =
+      benchmark::Counter(static_cast<double>(staticNanos), benchmark::Counter::kAvgIterations);
+  state.counters["saved_ns"] = benchmark::Counter(
+      static_cast<double>(runtimeNanos) - static_cast<double>(staticNanos),
+      benchmark::Counter::kAvgIterations);
+  state.counters["speedup"] =
+      static_cast<double>(runtimeNanos) / static_cast<double>(std::max<uint64_t>(staticNanos, 1));
+}
+BENCHMARK_TEMPLATE(BM_PolicyPhaseSpeedup, GenerationStats::Phase::RoomTypes);
+BENCHMARK_TEMPLATE(BM_PolicyPhaseSpeedup, GenerationStats::Phase::BranchPlan);
@@ -0,0 +1,139 @@
+#include <benchmark/benchmark.h>
+
+#include <random>
+#include <string>
+#include <vector>
+
+#include "../tests/test_utils.h"
+#include "bench_utils.h"
+#include "generation/PathGenerator.h"
+#include "io/PackedRunArchive.h"
+#include "io/RunGraphBinary.h"
+#include "io/RunJson.h"
+
+/**
+ * Benchmarks: JSON export/import
+ */
+
+static void BM_JsonWriteRuns(benchmark::State& state) {
+  const auto runs = TestUtils::GenerateRuns(BenchUtils::BENCH_SEED, 256);
+  std::string out;
+  for (auto _ : state) {
+    out.clear();
+    for (const auto& run : runs) {
+      RunJson::AppendRun(out, run);
+      out.push_back('\n');
+    }
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * out.size()));
+}
+BENCHMARK(BM_JsonWriteRuns);
+
+static void BM_JsonParseRun(benchmark::State& state) {
+  const auto runs = TestUtils::GenerateRuns(BenchUtils::BENCH_SEED, 1);
+  std::string json;
+  RunJson::AppendRun(json, runs[0]);
+
+  for (auto _ : state) {
+    auto graph = RunJson::ParseRun(json);
+    benchmark::DoNotOptimize(graph.GetStartNode());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * json.size()));
+}
+BENCHMARK(BM_JsonParseRun);
+
+/**
+ * Benchmarks: Binary format
+ */
+
+static void BM_BinarySerializeRun(benchmark::State& state) {
+  const auto runs = TestUtils::GenerateRuns(BenchUtils::BENCH_SEED, 1);
+  std::vector<std::byte> out;
+  for (auto _ : state) {
+    out.clear();
+    RunGraphBinary::AppendTo(runs[0], out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.SetBytesProcessed(static_cast<int64_t>(state.iterations() * out.size()));
+}
+BENCHMARK(BM_BinarySerializeRun);
+
+static void BM_BinaryViewTraverse(benchmark::State& state) {
+  const auto runs = TestUtils::GenerateRuns(BenchUtils::BENCH_SEED, 1);
+  const auto bytes = RunGraphBinary::Serialize(runs[0]);
+
+  for (auto _ : state) {
+    RunGraphView view(bytes);
+    int bosses = 0;
+    for (RunGraph::NodeIndex i = 0; i < view.GetNodeCount(); ++i) {
+      bosses += view.GetNode(i).GetType() == Room::Type::Boss;
+      for (uint32_t e = 0; e < view.GetDegree(i); ++e) {
+        benchmark::DoNotOptimize(view.GetSuccessor(i, e));
+      }
+    }
+    benchmark::DoNotOptimize(bosses);
+  }
+  BenchUtils::SetRoomCounters(state, static_cast<int64_t>(runs[0].GetNodeCount()));
+}
+BENCHMARK(BM_BinaryViewTraverse);
+
+/**
+ * Benchmarks: Packed runs
+ * Decode cost compared against regenerating the same run from its seed
+ */
+
+static void BM_PackedEncodeRun(benchmark::State& state) {
+  const auto runs = TestUtils::GenerateRuns(BenchUtils::BENCH_SEED, 1);
+  std::vector<std::byte> out;
+  for (auto _ : state) {
+    out.clear();
+    PackedRunFormat::AppendTo(runs[0], out);
+    benchmark::DoNotOptimize(out.data());
+  }
+  state.counters["bytes"] = static_cast<double>(out.size());
+  state.counters["binaryBytes"] = static_cast<double>(RunGraphBinary::Serialize(runs[0]).size());
+  BenchUtils::SetRoomCounters(state, static_cast<int64_t>(runs[0].GetNodeCount()));
+}
+BENCHMARK(BM_PackedEncodeRun);
+
+static void BM_PackedDecodeColumns(benchmark::State& state) {
+  const auto runs = TestUtils::GenerateRuns(BenchUtils::BENCH_SEED, 1);
+  std::vector<std::byte> bytes;
+  PackedRunFormat::AppendTo(runs[0], bytes);
+  PackedRun run;
+  for (auto _ : state) {
+    PackedRunFormat::Decode(bytes, run);
+    benchmark::DoNotOptimize(run.edgeTargets.data());
+  }
+  BenchUtils::SetRoomCounters(state, static_cast<int64_t>(runs[0].GetNodeCount()));
+}
+BENCHMARK(BM_PackedDecodeColumns);
+
+static void BM_PackedDecodeRunGraph(benchmark::State& state) {
+  const auto runs = TestUtils::GenerateRuns(BenchUtils::BENCH_SEED, 1);
+  std::vector<std::byte> bytes;
+  PackedRunFormat::AppendTo(runs[0], bytes);
+  PackedRun run;
+  for (auto _ : state) {
+    PackedRunFormat::Decode(bytes, run);
+    RunGraph graph = run.ToRunGraph();
+    benchmark::DoNotOptimize(graph.GetStartNode());
+  }
+  BenchUtils::SetRoomCounters(state, static_cast<int64_t>(runs[0].GetNodeCount()));
+}
+BENCHMARK(BM_PackedDecodeRunGraph);
+
+static void BM_RegenerateRun(benchmark::State& state) {
+  std::mt19937 rng;
+  PathGenerator generator(rng);
+  size_t rooms = 0;
+  for (auto _ : state) {
+    rng.seed(BenchUtils::BENCH_SEED);
+    RunGraph graph = generator.GeneratePath();
+    rooms = graph.GetNodeCount();
+    benchmark::DoNotOptimize(graph.GetStartNode());
+  }
+  BenchUtils::SetRoomCounters(state, static_cast<int64_t>(rooms));
+}
+BENCHMARK(BM_RegenerateRun);
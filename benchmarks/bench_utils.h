@@ -0,0 +1,59 @@
+#pragma once
+#include <benchmark/benchmark.h>
+
+#include <cstdint>
+#include <string>
+
+#include "core/RunGraph.h"
+
+namespace BenchUtils {
+/**
+ * Fixed seed so every benchmark run measures the same rooms
+ */
+constexpr uint32_t BENCH_SEED = 42;
+
+/**
+ * Builds start -> ... -> boss with the given number of rooms
+ */
+inline RunGraph BuildChain(int64_t roomCount, bool finalize) {
+  RunGraph graph;
+  graph.Reserve(static_cast<size_t>(roomCount));
+
+  RunGraph::Node* previous = nullptr;
+  for (int64_t i = 0; i < roomCount; ++i) {
+    auto type = (i == roomCount - 1) ? Room::Type::Boss : Room::Type::Combat;
+    auto* node = graph.AddRoom("room_" + std::to_string(i + 1), type);
+    if (previous) {
+      graph.Connect(previous, node);
+    } else {
+      graph.SetStartNode(node);
+    }
+    previous = node;
+  }
+
+  if (finalize) {
+    graph.Finalize();
+  }
+  return graph;
+}
+
+/**
+ * Reports rooms/second and time per room for a benchmark that processes
+ * roomsPerIteration rooms in each iteration
+ */
+inline void SetRoomCounters(benchmark::State& state, int64_t roomsPerIteration) {
+  state.SetItemsProcessed(state.iterations() * roomsPerIteration);
+  state.counters["time_per_room"] = benchmark::Counter(
+      static_cast<double>(roomsPerIteration),
+      benchmark::Counter::kIsIterationInvariantRate | benchmark::Counter::kInvert);
+}
+
+/**
+ * Graph sizes from a typical run up to stress-test graphs
+ */
+inline void GraphSizes(benchmark::internal::Benchmark* bench) {
+  for (int64_t size : {50, 1'000, 10'000, 100'000, 1'000'000}) {
+    bench->Arg(size);
+  }
+}
+}  // namespace BenchUtils
@@ -0,0 +1,182 @@
+#include "analytics/RunAnalytics.h"
+
+#include <algorithm>
+#include <cmath>
+
+#include "util/WorkStealingPool.h"
+
+// RoomTable implementation
+void RoomTable::Assign(const RunGraph& graph) {
+  const size_t count = graph.GetNodeCount();
+  types.resize(count);
+  depths.resize(count);
+  difficulties.resize(count);
+  critical.resize(count);
+  rewards.clear();
+  criticalLength = 0;
+
+  for (size_t i = 0; i < count; ++i) {
+    const RunGraph::Node* node = graph.GetNode(static_cast<RunGraph::NodeIndex>(i));
+    const Room* room = node->GetRoom();
+    types[i] = static_cast<uint8_t>(room->GetType());
+    depths[i] = static_cast<uint32_t>(std::max(node->GetDepth(), 0));
+    difficulties[i] =
+        std::llround(static_cast<double>(room->GetDifficulty()) * DIFFICULTY_SCALE);
+    critical[i] = node->IsOnCriticalPath() ? 1 : 0;
+    criticalLength += critical[i];
+    for (const Reward::Data& reward : room->GetRewards()) {
+      rewards.push_back(static_cast<uint8_t>(reward.type));
+    }
+  }
+}
+
+// RunAnalytics implementation
+RunAnalytics RunAnalytics::Collect(const PathGenerator::Config& config, uint64_t firstSeed,
+                                   uint64_t seedCount, unsigned threadCount) {
+  // Validates the config once, before any worker starts
+  PathGenerator prototype(firstSeed);
+  prototype.SetConfig(config);
+
+  // Padded so one worker's counters never share a cache line with another's
+  struct alignas(64) Worker {
+    explicit Worker(const PathGenerator& generator) : generator(generator) {}
+
+    PathGenerator generator;
+    RoomTable table;
+    RunAnalytics analytics;
+  };
+
+  WorkStealingPool pool(threadCount);
+  std::vector<Worker> workers;
+  workers.reserve(pool.GetThreadCount());
+  for (unsigned i = 0; i < pool.GetThreadCount(); ++i) {
+    workers.emplace_back(prototype);
+  }
+
+  const uint64_t taskCount = (seedCount + SEEDS_PER_TASK - 1) / SEEDS_PER_TASK;
+  pool.ParallelFor(static_cast<size_t>(taskCount), [&](size_t task, unsigned index) {
+    Worker& worker = workers[index];
+    const uint64_t begin = task * SEEDS_PER_TASK;
+    const uint64_t end = std::min(begin + SEEDS_PER_TASK, seedCount);
+    for (uint64_t i = begin; i < end; ++i) {
+      worker.generator.SetSeed(firstSeed + i);
+      const RunGraph graph = worker.generator.GeneratePath();
+      worker.table.Assign(graph);
+      worker.analytics.Add(worker.table);
+    }
+  });
+
+  RunAnalytics result;
+  for (const Worker& worker : workers) {
+    result.Merge(worker.analytics);
+  }
+  return result;
+}
+
+void RunAnalytics::Add(const RunGraph& graph) {
+  RoomTable table;
+  table.Assign(graph);
+  Add(table);
+}
+
+void RunAnalytics::Add(const RoomTable& table) {
+  const size_t count = table.GetRoomCount();
+  ++runCount_;
+  roomCount_ += count;
+  branchRoomCount_ += count - table.criticalLength;
+  CountInto(pathLengths_, table.criticalLength);
+  if (count == 0) return;
+
+  const uint32_t deepest = *std::max_element(table.depths.begin(), table.depths.end());
+  EnsureDepths(static_cast<size_t>(deepest) + 1);
+
+  for (size_t i = 0; i < count; ++i) {
+    const size_t depth = table.depths[i];
+    ++typeByDepth_[depth * Room::TYPE_COUNT + table.types[i]];
+    ++depthRoomCounts_[depth];
+    difficultyByDepth_[depth] += table.difficulties[i];
+  }
+
+  // Critical rooms are in depth order, so consecutive mini-bosses are neighbours here
+  constexpr auto MINI_BOSS = static_cast<uint8_t>(Room::Type::MiniBoss);
+  int64_t previous = -1;
+  for (size_t i = 0; i < count; ++i) {
+    if (!table.critical[i] || table.types[i] != MINI_BOSS) continue;
+    const auto depth = static_cast<int64_t>(table.depths[i]);
+    if (previous >= 0) {
+      CountInto(miniBossSpacing_, static_cast<size_t>(std::max<int64_t>(depth - previous, 0)));
+    }
+    previous = depth;
+  }
+
+  for (const uint8_t reward : table.rewards) {
+    ++rewardCounts_[reward];
+  }
+}
+
+void RunAnalytics::Merge(const RunAnalytics& other) {
+  runCount_ += other.runCount_;
+  roomCount_ += other.roomCount_;
+  branchRoomCount_ += other.branchRoomCount_;
+
+  EnsureDepths(other.GetDepthCount());
+  for (size_t i = 0; i < other.typeByDepth_.size(); ++i) {
+    typeByDepth_[i] += other.typeByDepth_[i];
+  }
+  for (size_t depth = 0; depth < other.GetDepthCount(); ++depth) {
+    depthRoomCounts_[depth] += other.depthRoomCounts_[depth];
+    difficultyByDepth_[depth] += other.difficultyByDepth_[depth];
+  }
+
+  auto mergeHistogram = [](std::vector<uint64_t>& into, const std::vector<uint64_t>& from) {
+    if (into.size() < from.size()) into.resize(from.size(), 0);
+    for (size_t i = 0; i < from.size(); ++i) into[i] += from[i];
+  };
+  mergeHistogram(pathLengths_, other.pathLengths_);
+  mergeHistogram(miniBossSpacing_, other.miniBossSpacing_);
+
+  for (size_t i = 0; i < Reward::TYPE_COUNT; ++i) {
+    rewardCounts_[i] += other.rewardCounts_[i];
+  }
+}
+
+uint64_t RunAnalytics::GetRoomCountAtDepth(size_t depth) const {
+  return depth < GetDepthCount() ? depthRoomCounts_[depth] : 0;
+}
+
+uint64_t RunAnalytics::GetTypeCount(size_t depth, Room::Type type) const {
+  if (depth >= GetDepthCount()) return 0;
+  return typeByDepth_[depth * Room::TYPE_COUNT + static_cast<size_t>(type)];
+}
+
+uint64_t RunAnalytics::GetTypeCount(Room::Type type) const {
+  uint64_t total = 0;
+  for (size_t depth = 0; depth < GetDepthCount(); ++depth) {
+    total += GetTypeCount(depth, type);
+  }
+  return total;
+}
+
+double RunAnalytics::GetTypeFrequency(size_t depth, Room::Type type) const {
+  const uint64_t rooms = GetRoomCountAtDepth(depth);
+  return rooms ? static_cast<double>(GetTypeCount(depth, type)) / rooms : 0.0;
+}
+
+double RunAnalytics::GetMeanDifficulty(size_t depth) const {
+  const uint64_t rooms = GetRoomCountAtDepth(depth);
+  if (rooms == 0) return 0.0;
+  return static_cast<double>(difficultyByDepth_[depth]) /
+         (static_cast<double>(rooms) * RoomTable::DIFFICULTY_SCALE);
+}
+
+void RunAnalytics::EnsureDepths(size_t depthCount) {
+  if (depthCount <= GetDepthCount()) return;
+  typeByDepth_.resize(depthCount * Room::TYPE_COUNT, 0);
+  depthRoomCounts_.resize(depthCount, 0);
+  difficultyByDepth_.resize(depthCount, 0);
+}
+
+void RunAnalytics::CountInto(std::vector<uint64_t>& histogram, size_t value) {
+  if (histogram.size() <= value) histogram.resize(value + 1, 0);
+  ++histogram[value];
+}
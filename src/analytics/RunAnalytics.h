@@ -0,0 +1,105 @@
+#pragma once
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "core/Reward.h"
+#include "core/Room.h"
+#include "core/RunGraph.h"
+#include "generation/PathGenerator.h"
+
+/**
+ * Flat per-room layout of one run, for reductions
+ *
+ * Column i describes node i of the run. Critical rooms come first, in
+ * depth order, followed by branch rooms. Rewards of all rooms are
+ * concatenated into one column.
+ */
+struct RoomTable {
+  std::vector<uint8_t> types;         // Room::Type
+  std::vector<uint32_t> depths;
+  std::vector<int64_t> difficulties;  // Fixed point, DIFFICULTY_SCALE = 1.0
+  std::vector<uint8_t> critical;      // 1 for critical-path rooms
+  std::vector<uint8_t> rewards;       // Reward::Type
+  size_t criticalLength = 0;
+
+  static constexpr int64_t DIFFICULTY_SCALE = 1 << 16;
+
+  size_t GetRoomCount() const { return types.size(); }
+
+  // Overwrites the table with graph's rooms, reusing its capacity
+  void Assign(const RunGraph& graph);
+};
+
+/**
+ * Distributions over many generated runs
+ *
+ * Collects room types by depth, critical path lengths, spacing between
+ * mini-bosses, reward frequencies and mean difficulty by depth. Every
+ * accumulator is an integer (difficulty is summed in fixed point), so
+ * Merge() is exact and the result of Collect() does not depend on how
+ * seeds were split across threads.
+ */
+class RunAnalytics {
+ public:
+  /**
+   * Generates runs for seeds [firstSeed, firstSeed + seedCount) and
+   * reduces them into one RunAnalytics
+   *
+   * Each worker owns a PathGenerator, a RoomTable and an accumulator;
+   * workers are merged in index order at the end.
+   * @param threadCount Worker threads including the caller (0 = hardware concurrency)
+   * @throws std::invalid_argument if config is invalid
+   */
+  static RunAnalytics Collect(const PathGenerator::Config& config, uint64_t firstSeed,
+                              uint64_t seedCount, unsigned threadCount = 0);
+
+  static constexpr uint64_t SEEDS_PER_TASK = 256;
+
+  void Add(const RunGraph& graph);
+  void Add(const RoomTable& table);
+  void Merge(const RunAnalytics& other);
+
+  uint64_t GetRunCount() const { return runCount_; }
+  uint64_t GetRoomCount() const { return roomCount_; }
+  uint64_t GetBranchRoomCount() const { return branchRoomCount_; }
+
+  // Depths seen so far are [0, GetDepthCount())
+  size_t GetDepthCount() const { return depthRoomCounts_.size(); }
+  uint64_t GetRoomCountAtDepth(size_t depth) const;
+  uint64_t GetTypeCount(size_t depth, Room::Type type) const;
+  uint64_t GetTypeCount(Room::Type type) const;
+  // Share of rooms at depth that have type (0 when no room reached depth)
+  double GetTypeFrequency(size_t depth, Room::Type type) const;
+  double GetMeanDifficulty(size_t depth) const;
+
+  // Histograms indexed by value: critical path length, and depth gap
+  // between consecutive mini-bosses on the critical path
+  std::span<const uint64_t> GetPathLengthHistogram() const { return pathLengths_; }
+  std::span<const uint64_t> GetMiniBossSpacingHistogram() const { return miniBossSpacing_; }
+
+  uint64_t GetRewardCount(Reward::Type type) const {
+    return rewardCounts_[static_cast<size_t>(type)];
+  }
+
+  bool operator==(const RunAnalytics& other) const = default;
+
+ private:
+  void EnsureDepths(size_t depthCount);
+  static void CountInto(std::vector<uint64_t>& histogram, size_t value);
+
+  uint64_t runCount_ = 0;
+  uint64_t roomCount_ = 0;
+  uint64_t branchRoomCount_ = 0;
+
+  // Row per depth, one column per room type
+  std::vector<uint64_t> typeByDepth_;
+  std::vector<uint64_t> depthRoomCounts_;
+  std::vector<int64_t> difficultyByDepth_;
+
+  std::vector<uint64_t> pathLengths_;
+  std::vector<uint64_t> miniBossSpacing_;
+  std::array<uint64_t, Reward::TYPE_COUNT> rewardCounts_{};
+};
@@ -1,4 +1,5 @@
 #pragma once
+#include <cstddef>
 
 /**
  * Biomes in Hades, each with distinct visual style and enemy types
@@ -10,6 +11,7 @@ enum class Type {
   Elysium,   // Third biome (gold/white, elite enemies)
   Styx       // Final biome (green poison, stealth sections)
 };
+constexpr size_t COUNT = static_cast<size_t>(Type::Styx) + 1;
 
 const char* ToString(Type type);
 }  // namespace Biome
\ No newline at end of file
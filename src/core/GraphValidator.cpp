@@ -1,7 +1,44 @@
 #include "core/GraphValidator.h"
 
 #include <algorithm>
-#include <unordered_set>
+
+namespace {
+using NodeIndex = RunGraph::NodeIndex;
+
+/**
+ * Adjacency over a finalized graph's CSR arrays
+ */
+struct PackedAdjacency {
+  std::span<const NodeIndex> offsets;
+  std::span<const NodeIndex> targets;
+
+  uint32_t Degree(NodeIndex node) const { return offsets[node + 1] - offsets[node]; }
+  NodeIndex Target(NodeIndex node, uint32_t edge) const { return targets[offsets[node] + edge]; }
+};
+
+/**
+ * Adjacency over a graph still in building mode (per-node edge lists)
+ */
+struct PointerAdjacency {
+  const RunGraph& graph;
+
+  uint32_t Degree(NodeIndex node) const {
+    return static_cast<uint32_t>(graph.GetNode(node)->GetNextRooms().size());
+  }
+  NodeIndex Target(NodeIndex node, uint32_t edge) const {
+    const RunGraph::Node* next = graph.GetNode(node)->GetNextRooms()[edge];
+    const NodeIndex index = next->GetIndex();
+    if (index >= graph.GetNodeCount() || graph.GetNode(index) != next) {
+      return RunGraph::INVALID_INDEX;
+    }
+    return index;
+  }
+};
+
+bool IsBoss(const RunGraph& graph, NodeIndex node) {
+  return graph.GetNode(node)->GetRoom()->GetType() == Room::Type::Boss;
+}
+}  // namespace
 
 bool GraphValidator::ValidationResult::HasError(ValidationError error) const {
   return std::find(errors.begin(), errors.end(), error) != errors.end();
@@ -14,124 +51,122 @@ void GraphValidator::ValidationResult::AddError(ValidationError error, const std
 }
 
 GraphValidator::ValidationResult GraphValidator::Validate(const RunGraph& graph) {
-  ValidationResult result;
+  Stats::PhaseTimer timer(stats_, GenerationStats::Phase::Validate);
+  Summary summary;
 
   // Check for start node
-  if (graph.GetStartNode() == nullptr) {
+  const RunGraph::Node* startNode = graph.GetStartNode();
+  if (startNode == nullptr) {
+    summary.hasStart = false;
+    return Report(summary);  // Can't continue without start node
+  }
+
+  const NodeIndex start = startNode->GetIndex();
+  if (start >= graph.GetNodeCount() || graph.GetNode(start) != startNode) {
+    summary.startInGraph = false;
+    return Report(summary);
+  }
+
+  const PassResult pass =
+      graph.IsFinalized()
+          ? RunPass(graph, PackedAdjacency{graph.GetEdgeOffsets(), graph.GetEdgeTargets()}, start)
+          : RunPass(graph, PointerAdjacency{graph}, start);
+
+  summary.hasBoss = pass.hasBoss;
+  summary.hasCycle = pass.hasCycle;
+  summary.allReachable = pass.reachableCount == graph.GetNodeCount() && !pass.hasForeignEdge;
+  summary.hasDeadEnd = pass.hasDeadEnd;
+  return Report(summary);
+}
+
+GraphValidator::ValidationResult GraphValidator::Report(const Summary& summary) {
+  ValidationResult result;
+
+  if (!summary.hasStart) {
     result.AddError(ValidationError::NoStartNode, "Graph has no start node");
-    return result;  // Can't continue without start node
+    return result;
+  }
+  if (!summary.startInGraph) {
+    result.AddError(ValidationError::NoStartNode, "Start node does not belong to the graph");
+    return result;
   }
 
   // Check for boss room
-  if (!HasBossRoom(graph)) {
+  if (!summary.hasBoss) {
     result.AddError(ValidationError::NoBossRoom, "Graph has no boss room");
   }
 
   // Check for cycles
-  if (HasCycles(graph)) {
+  if (summary.hasCycle) {
     result.AddError(ValidationError::CycleDetected, "Graph contains cycles");
   }
 
   // Check all nodes are reachable
-  if (!AllNodesReachable(graph)) {
+  if (!summary.allReachable) {
     result.AddError(ValidationError::DisconnectedNode,
                     "Some nodes are not reachable from the start");
   }
 
   // Check for dead ends (non-boss rooms with no exits)
-  if (HasDeadEnds(graph)) {
+  if (summary.hasDeadEnd) {
     result.AddError(ValidationError::DeadEnd, "Found dead-end rooms (non-boss with no exits)");
   }
 
   return result;
 }
 
-bool GraphValidator::HasBossRoom(const RunGraph& graph) {
-  for (const auto* node : graph.GetAllNodes()) {
-    if (node->GetRoom()->GetType() == Room::Type::Boss) {
-      return true;
+template <typename Adjacency>
+GraphValidator::PassResult GraphValidator::RunPass(const RunGraph& graph,
+                                                   const Adjacency& adjacency, NodeIndex start) {
+  PassResult pass;
+  const size_t nodeCount = graph.GetNodeCount();
+
+  colors_.assign(nodeCount, Color::White);
+  stack_.clear();
+
+  // Boss and dead-end checks run as each node is first discovered
+  auto discover = [&](NodeIndex node) {
+    colors_[node] = Color::Gray;
+    ++pass.reachableCount;
+    if (IsBoss(graph, node)) {
+      pass.hasBoss = true;
+    } else if (adjacency.Degree(node) == 0) {
+      pass.hasDeadEnd = true;
+    }
+    stack_.push_back({node, 0});
+  };
+
+  // Iterative DFS from the start; a Gray successor is a back edge (cycle)
+  discover(start);
+  while (!stack_.empty()) {
+    Frame& frame = stack_.back();
+    if (frame.nextEdge == adjacency.Degree(frame.node)) {
+      colors_[frame.node] = Color::Black;
+      stack_.pop_back();
+      continue;
     }
-  }
-  return false;
-}
-
-bool GraphValidator::HasCycles(const RunGraph& graph) {
-  std::vector<const RunGraph::Node*> visited;
-  std::vector<const RunGraph::Node*> recursionStack;
-
-  return HasCyclesHelper(graph.GetStartNode(), visited, recursionStack);
-}
-
-bool GraphValidator::HasCyclesHelper(const RunGraph::Node* node,
-                                     std::vector<const RunGraph::Node*>& visited,
-                                     std::vector<const RunGraph::Node*>& recursionStack) {
-  if (!node) return false;
-
-  // If in recustion stack, we found a cycle
-  if (std::find(recursionStack.begin(), recursionStack.end(), node) != recursionStack.end()) {
-    return true;
-  }
-
-  // If already fully explored, no cycles here
-  if (std::find(visited.begin(), visited.end(), node) != visited.end()) {
-    return false;
-  }
-
-  // Mark as being explored
-  recursionStack.push_back(node);
 
-  // Check all children
-  for (const auto* next : node->GetNextRooms()) {
-    if (HasCyclesHelper(next, visited, recursionStack)) {
-      return true;
+    const NodeIndex next = adjacency.Target(frame.node, frame.nextEdge++);
+    if (next == RunGraph::INVALID_INDEX) {
+      pass.hasForeignEdge = true;
+    } else if (colors_[next] == Color::White) {
+      discover(next);  // May reallocate stack_; frame is not used afterwards
+    } else if (colors_[next] == Color::Gray) {
+      pass.hasCycle = true;
     }
   }
 
-  // Done exploring this node
-  recursionStack.erase(std::remove(recursionStack.begin(), recursionStack.end(), node),
-                       recursionStack.end());
-  visited.push_back(node);
-
-  return false;
-}
-
-bool GraphValidator::AllNodesReachable(const RunGraph& graph) {
-  if (graph.GetNodeCount() == 0) return true;
-  if (!graph.GetStartNode()) return false;
-
-  std::unordered_set<const RunGraph::Node*> reachable;
-  std::vector<const RunGraph::Node*> toVisit;
-
-  toVisit.push_back(graph.GetStartNode());
-
-  while (!toVisit.empty()) {
-    const auto* current = toVisit.back();
-    toVisit.pop_back();
-
-    if (reachable.count(current)) continue;
-    reachable.insert(current);
-
-    for (const auto* next : current->GetNextRooms()) {
-      if (!reachable.count(next)) {
-        toVisit.push_back(next);
+  // Nodes the DFS never reached still count towards boss and dead-end checks
+  if (pass.reachableCount != nodeCount) {
+    for (NodeIndex node = 0; node < nodeCount; ++node) {
+      if (colors_[node] != Color::White) continue;
+      if (IsBoss(graph, node)) {
+        pass.hasBoss = true;
+      } else if (adjacency.Degree(node) == 0) {
+        pass.hasDeadEnd = true;
       }
     }
   }
 
-  return reachable.size() == graph.GetNodeCount();
+  return pass;
 }
-
-bool GraphValidator::HasDeadEnds(const RunGraph& graph) {
-  for (const auto* node : graph.GetAllNodes()) {
-    // Boss rooms are allowed to have no exits
-    if (node->GetRoom()->GetType() == Room::Type::Boss) {
-      continue;
-    }
-
-    // Non-boss rooms must have at least one exit
-    if (node->GetNextRooms().empty()) {
-      return true;
-    }
-  }
-  return false;
-}
\ No newline at end of file
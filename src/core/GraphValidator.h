@@ -1,8 +1,10 @@
 #pragma once
+#include <cstdint>
 #include <string>
 #include <vector>
 
 #include "core/RunGraph.h"
+#include "util/GenerationStats.h"
 
 /**
  * Validates RunGraph structure for correctness
@@ -12,6 +14,11 @@
  * - All nodes are reachable from start
  * - Boss room exists and is reachable
  * - No disconnecte components
+ *
+ * All checks are fused into a single iterative depth-first pass that runs
+ * in O(V + E) and never recurses, so arbitrarily long runs are safe.
+ * Scratch buffers are kept between calls; reuse one validator to avoid
+ * reallocating them.
  */
 class GraphValidator {
  public:
@@ -34,14 +41,48 @@ class GraphValidator {
     void AddError(ValidationError error, const std::string& message);
   };
 
+  /**
+   * Outcome of the structural checks; Report() turns it into a result so
+   * every validator produces the same errors and messages
+   */
+  struct Summary {
+    bool hasStart = true;
+    bool startInGraph = true;
+    bool hasBoss = false;
+    bool hasCycle = false;
+    bool allReachable = false;
+    bool hasDeadEnd = false;
+  };
+
   ValidationResult Validate(const RunGraph& graph);
 
+  // Each Validate() adds its time to the Validate phase of stats (nullptr detaches)
+  void SetStats(GenerationStats* stats) { stats_ = stats; }
+
+  static ValidationResult Report(const Summary& summary);
+
  private:
-  bool HasCycles(const RunGraph& graph);
-  bool AllNodesReachable(const RunGraph& graph);
-  bool HasBossRoom(const RunGraph& graph);
-  bool HasDeadEnds(const RunGraph& graph);
-
-  bool HasCyclesHelper(const RunGraph::Node* node, std::vector<const RunGraph::Node*>& visited,
-                       std::vector<const RunGraph::Node*>& recursionStack);
-};
\ No newline at end of file
+  // DFS colours: White = unvisited, Gray = on the current path, Black = done
+  enum class Color : uint8_t { White, Gray, Black };
+
+  struct Frame {
+    RunGraph::NodeIndex node;
+    uint32_t nextEdge;
+  };
+
+  struct PassResult {
+    size_t reachableCount = 0;
+    bool hasBoss = false;
+    bool hasCycle = false;
+    bool hasDeadEnd = false;
+    bool hasForeignEdge = false;
+  };
+
+  template <typename Adjacency>
+  PassResult RunPass(const RunGraph& graph, const Adjacency& adjacency,
+                     RunGraph::NodeIndex start);
+
+  std::vector<Color> colors_;
+  std::vector<Frame> stack_;
+  GenerationStats* stats_ = nullptr;
+};
@@ -0,0 +1,227 @@
+#include "core/IncrementalValidator.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+IncrementalValidator::IncrementalValidator(RunGraph& graph) : graph_(&graph) {
+  if (graph.GetMutationObserver() != nullptr) {
+    throw std::logic_error("RunGraph already has a mutation observer");
+  }
+
+  // Replay the existing contents as if they had been added one by one
+  const size_t nodeCount = graph.GetNodeCount();
+  for (size_t i = 0; i < nodeCount; ++i) {
+    const NodeIndex index = static_cast<NodeIndex>(i);
+    OnRoomAdded(index, *graph.GetNode(index)->GetRoom());
+  }
+
+  const RunGraph::Node* start = graph.GetStartNode();
+  OnStartNodeChanged(start, graph.Contains(start) ? start->GetIndex() : RunGraph::INVALID_INDEX);
+
+  for (size_t i = 0; i < nodeCount; ++i) {
+    const NodeIndex index = static_cast<NodeIndex>(i);
+    for (const RunGraph::Node* next : graph.GetNode(index)->GetNextRooms()) {
+      OnConnected(index, graph.Contains(next) ? next->GetIndex() : RunGraph::INVALID_INDEX);
+    }
+  }
+
+  graph.SetMutationObserver(this);
+}
+
+IncrementalValidator::~IncrementalValidator() {
+  if (graph_->GetMutationObserver() == this) {
+    graph_->SetMutationObserver(nullptr);
+  }
+}
+
+GraphValidator::ValidationResult IncrementalValidator::Validate() const {
+  GraphValidator::Summary summary;
+  summary.hasStart = hasStart_;
+  summary.startInGraph = start_ != RunGraph::INVALID_INDEX;
+  summary.hasBoss = bossCount_ > 0;
+  summary.hasCycle = cyclic_ && summary.startInGraph && HasReachableCycle();
+  summary.allReachable = reachableCount_ == GetNodeCount() && foreignEdgeCount_ == 0;
+  summary.hasDeadEnd = deadEndCount_ > 0;
+  return GraphValidator::Report(summary);
+}
+
+std::vector<IncrementalValidator::NodeIndex> IncrementalValidator::GetTopologicalOrder() const {
+  if (cyclic_) return {};
+
+  std::vector<NodeIndex> order(GetNodeCount());
+  for (size_t node = 0; node < order.size(); ++node) {
+    order[order_[node]] = static_cast<NodeIndex>(node);
+  }
+  return order;
+}
+
+void IncrementalValidator::OnRoomAdded(NodeIndex index, const Room& room) {
+  const bool isBoss = room.GetType() == Room::Type::Boss;
+
+  successors_.emplace_back();
+  predecessors_.emplace_back();
+  outDegree_.push_back(0);
+  isBoss_.push_back(isBoss);
+  reachable_.push_back(0);
+  order_.push_back(index);  // New nodes have no edges and go last
+  visited_.push_back(0);
+
+  if (isBoss) {
+    ++bossCount_;
+  } else {
+    ++deadEndCount_;
+  }
+}
+
+void IncrementalValidator::OnConnected(NodeIndex from, NodeIndex to) {
+  if (outDegree_[from]++ == 0 && !isBoss_[from]) {
+    --deadEndCount_;
+  }
+
+  if (to == RunGraph::INVALID_INDEX) {
+    ++foreignEdgeCount_;
+    return;
+  }
+
+  successors_[from].push_back(to);
+  predecessors_[to].push_back(from);
+
+  if (!cyclic_ && !Reorder(from, to)) {
+    cyclic_ = true;
+  }
+
+  if (reachable_[from] && !reachable_[to]) {
+    MarkReachableFrom(to);
+  }
+}
+
+void IncrementalValidator::OnStartNodeChanged(const RunGraph::Node* node, NodeIndex index) {
+  hasStart_ = node != nullptr;
+  start_ = index;
+
+  std::fill(reachable_.begin(), reachable_.end(), 0);
+  reachableCount_ = 0;
+  if (start_ != RunGraph::INVALID_INDEX) {
+    MarkReachableFrom(start_);
+  }
+}
+
+bool IncrementalValidator::Reorder(NodeIndex from, NodeIndex to) {
+  if (from == to) return false;
+
+  const uint32_t lowerBound = order_[to];
+  const uint32_t upperBound = order_[from];
+  if (lowerBound > upperBound) return true;  // Already in order
+
+  // Forward search from to over nodes ordered before from; reaching from
+  // means the new edge closes a cycle
+  forward_.clear();
+  stack_.assign(1, to);
+  visited_[to] = 1;
+  bool closesCycle = false;
+  while (!stack_.empty() && !closesCycle) {
+    const NodeIndex node = stack_.back();
+    stack_.pop_back();
+    forward_.push_back(node);
+    for (const NodeIndex next : successors_[node]) {
+      if (next == from) {
+        closesCycle = true;
+        break;
+      }
+      if (!visited_[next] && order_[next] < upperBound) {
+        visited_[next] = 1;
+        stack_.push_back(next);
+      }
+    }
+  }
+  if (closesCycle) {
+    for (const NodeIndex node : stack_) visited_[node] = 0;
+    for (const NodeIndex node : forward_) visited_[node] = 0;
+    return false;
+  }
+
+  // Backward search from from over nodes ordered after to
+  backward_.clear();
+  stack_.assign(1, from);
+  visited_[from] = 1;
+  while (!stack_.empty()) {
+    const NodeIndex node = stack_.back();
+    stack_.pop_back();
+    backward_.push_back(node);
+    for (const NodeIndex previous : predecessors_[node]) {
+      if (!visited_[previous] && order_[previous] > lowerBound) {
+        visited_[previous] = 1;
+        stack_.push_back(previous);
+      }
+    }
+  }
+
+  // Ancestors of from take the lowest freed positions, descendants of to the rest
+  auto byOrder = [this](NodeIndex a, NodeIndex b) { return order_[a] < order_[b]; };
+  std::sort(backward_.begin(), backward_.end(), byOrder);
+  std::sort(forward_.begin(), forward_.end(), byOrder);
+
+  pool_.clear();
+  for (const NodeIndex node : backward_) pool_.push_back(order_[node]);
+  for (const NodeIndex node : forward_) pool_.push_back(order_[node]);
+  std::sort(pool_.begin(), pool_.end());
+
+  size_t slot = 0;
+  for (const NodeIndex node : backward_) {
+    order_[node] = pool_[slot++];
+    visited_[node] = 0;
+  }
+  for (const NodeIndex node : forward_) {
+    order_[node] = pool_[slot++];
+    visited_[node] = 0;
+  }
+  return true;
+}
+
+void IncrementalValidator::MarkReachableFrom(NodeIndex node) {
+  stack_.assign(1, node);
+  reachable_[node] = 1;
+  ++reachableCount_;
+  while (!stack_.empty()) {
+    const NodeIndex current = stack_.back();
+    stack_.pop_back();
+    for (const NodeIndex next : successors_[current]) {
+      if (!reachable_[next]) {
+        reachable_[next] = 1;
+        ++reachableCount_;
+        stack_.push_back(next);
+      }
+    }
+  }
+}
+
+bool IncrementalValidator::HasReachableCycle() const {
+  // Iterative three-colour DFS, as in GraphValidator
+  enum class Color : uint8_t { White, Gray, Black };
+  struct Frame {
+    NodeIndex node;
+    uint32_t nextEdge;
+  };
+
+  std::vector<Color> colors(GetNodeCount(), Color::White);
+  std::vector<Frame> stack;
+  colors[start_] = Color::Gray;
+  stack.push_back({start_, 0});
+  while (!stack.empty()) {
+    Frame& frame = stack.back();
+    const auto& successors = successors_[frame.node];
+    if (frame.nextEdge == successors.size()) {
+      colors[frame.node] = Color::Black;
+      stack.pop_back();
+      continue;
+    }
+
+    const NodeIndex next = successors[frame.nextEdge++];
+    if (colors[next] == Color::Gray) return true;
+    if (colors[next] == Color::White) {
+      colors[next] = Color::Gray;
+      stack.push_back({next, 0});
+    }
+  }
+  return false;
+}
@@ -0,0 +1,89 @@
+#pragma once
+#include <cstdint>
+#include <vector>
+
+#include "core/GraphValidator.h"
+#include "core/RunGraph.h"
+
+/**
+ * Keeps GraphValidator's verdict up to date while a RunGraph is edited
+ *
+ * Attaches itself as the graph's mutation observer and maintains:
+ * - the set of nodes reachable from the start
+ * - a topological order (Pearce-Kelly dynamic topological sort)
+ * - boss and dead-end counts
+ *
+ * AddRoom is O(1); Connect costs time proportional to the newly reachable
+ * nodes plus the part of the order that has to be shuffled; Validate() is
+ * O(1) and reports exactly what GraphValidator::Validate would. Once an edge
+ * closes a cycle the order is abandoned and Validate() falls back to an
+ * O(V + E) cycle check, since cycles are never removed again.
+ * SetStartNode recomputes reachability in O(V + E).
+ *
+ * The graph must outlive the validator and must not be moved while it is
+ * attached.
+ */
+class IncrementalValidator : public RunGraph::MutationObserver {
+ public:
+  using NodeIndex = RunGraph::NodeIndex;
+
+  /**
+   * Builds the state for the graph's current contents and attaches to it
+   * @throws std::logic_error if the graph already has an observer
+   */
+  explicit IncrementalValidator(RunGraph& graph);
+  ~IncrementalValidator() override;
+
+  IncrementalValidator(const IncrementalValidator&) = delete;
+  IncrementalValidator& operator=(const IncrementalValidator&) = delete;
+
+  GraphValidator::ValidationResult Validate() const;
+
+  size_t GetNodeCount() const { return successors_.size(); }
+  size_t GetReachableCount() const { return reachableCount_; }
+  bool IsReachable(NodeIndex node) const { return reachable_[node] != 0; }
+  size_t GetBossCount() const { return bossCount_; }
+  size_t GetDeadEndCount() const { return deadEndCount_; }
+  bool HasCycle() const { return cyclic_; }
+
+  /**
+   * Nodes sorted so every edge points forward (empty once cyclic)
+   */
+  std::vector<NodeIndex> GetTopologicalOrder() const;
+
+  // RunGraph::MutationObserver
+  void OnRoomAdded(NodeIndex index, const Room& room) override;
+  void OnConnected(NodeIndex from, NodeIndex to) override;
+  void OnStartNodeChanged(const RunGraph::Node* node, NodeIndex index) override;
+
+ private:
+  // Pearce-Kelly: restores the order after inserting from -> to, or
+  // returns false if the edge closes a cycle
+  bool Reorder(NodeIndex from, NodeIndex to);
+  void MarkReachableFrom(NodeIndex node);
+  bool HasReachableCycle() const;
+
+  RunGraph* graph_;
+
+  std::vector<std::vector<NodeIndex>> successors_;
+  std::vector<std::vector<NodeIndex>> predecessors_;
+  std::vector<uint32_t> outDegree_;  // Includes edges to foreign nodes
+  std::vector<uint8_t> isBoss_;
+  std::vector<uint8_t> reachable_;
+  std::vector<uint32_t> order_;  // Position of each node in the topological order
+
+  NodeIndex start_ = RunGraph::INVALID_INDEX;
+  bool hasStart_ = false;
+  size_t reachableCount_ = 0;
+  size_t bossCount_ = 0;
+  size_t deadEndCount_ = 0;
+  size_t foreignEdgeCount_ = 0;
+  bool cyclic_ = false;
+
+  // Scratch for Reorder
+  std::vector<uint8_t> visited_;
+  std::vector<NodeIndex> stack_;
+  std::vector<NodeIndex> forward_;
+  std::vector<NodeIndex> backward_;
+  std::vector<uint32_t> pool_;
+};
@@ -0,0 +1,70 @@
+#include "core/PathCounter.h"
+
+PathCounter::PathCounter(const RunGraph& graph) : counts_(graph.GetNodeCount()) {
+  const std::span<const int> longest = graph.GetDistances(RunGraph::DepthMetric::Longest);
+  const size_t nodeCount = graph.GetNodeCount();
+  start_ = graph.GetStartNode()->GetIndex();
+
+  // Bucket reachable nodes by longest distance; every edge between them
+  // goes to a strictly larger distance
+  int maxDistance = 0;
+  for (const int distance : longest) maxDistance = std::max(maxDistance, distance);
+  std::vector<uint32_t> bucketStart(static_cast<size_t>(maxDistance) + 2, 0);
+  for (const int distance : longest) {
+    if (distance != RunGraph::UNREACHABLE) ++bucketStart[static_cast<size_t>(distance) + 1];
+  }
+  for (size_t i = 1; i < bucketStart.size(); ++i) bucketStart[i] += bucketStart[i - 1];
+  std::vector<NodeIndex> order(bucketStart.back());
+  for (size_t node = 0; node < nodeCount; ++node) {
+    if (longest[node] != RunGraph::UNREACHABLE) {
+      order[bucketStart[static_cast<size_t>(longest[node])]++] = static_cast<NodeIndex>(node);
+    }
+  }
+
+  // Deepest first, so successors are counted before their predecessors
+  for (size_t i = order.size(); i-- > 0;) {
+    const NodeIndex node = order[i];
+    const RunGraph::Node* graphNode = graph.GetNode(node);
+    if (graphNode->GetRoom()->GetType() == Room::Type::Boss) {
+      counts_[node] = 1;
+      continue;
+    }
+    for (const RunGraph::Node* next : graphNode->GetNextRooms()) {
+      if (graph.Contains(next)) counts_[node] += counts_[next->GetIndex()];
+    }
+  }
+  total_ = counts_[start_];
+
+  // Successor lists keep only edges that lead to a boss; bosses end a route
+  successorOffsets_.reserve(nodeCount + 1);
+  for (size_t node = 0; node < nodeCount; ++node) {
+    successorOffsets_.push_back(static_cast<uint32_t>(successors_.size()));
+    const RunGraph::Node* graphNode = graph.GetNode(static_cast<NodeIndex>(node));
+    if (counts_[node].IsZero() || graphNode->GetRoom()->GetType() == Room::Type::Boss) continue;
+    for (const RunGraph::Node* next : graphNode->GetNextRooms()) {
+      if (graph.Contains(next) && !counts_[next->GetIndex()].IsZero()) {
+        successors_.push_back(next->GetIndex());
+      }
+    }
+  }
+  successorOffsets_.push_back(static_cast<uint32_t>(successors_.size()));
+
+  if (total_.FitsUint64()) {
+    smallCounts_.resize(nodeCount);
+    for (size_t node = 0; node < nodeCount; ++node) {
+      smallCounts_[node] = counts_[node].ToUint64();
+    }
+  }
+}
+
+void PathCounter::SampleBatch(uint64_t seed, size_t count, std::vector<NodeIndex>& nodes,
+                              std::vector<uint32_t>& offsets) const {
+  nodes.clear();
+  offsets.assign(1, 0);
+  offsets.reserve(count + 1);
+  for (size_t i = 0; i < count; ++i) {
+    CounterRng rng(seed, static_cast<uint32_t>(i));
+    Sample(rng, nodes);
+    offsets.push_back(static_cast<uint32_t>(nodes.size()));
+  }
+}
@@ -0,0 +1,129 @@
+#pragma once
+#include <algorithm>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "core/RunGraph.h"
+#include "util/CounterRng.h"
+#include "util/WideUint.h"
+
+/**
+ * Counts and samples the distinct routes from the start room to a boss
+ *
+ * A route is a path from the start node that ends at the first Boss room
+ * it enters. Counts come from one dynamic-programming pass: paths(u) is 1
+ * for a boss and the sum over u's successors otherwise, evaluated in
+ * decreasing longest distance from the start (a topological order of the
+ * reachable nodes, taken from RunGraph's cached distances). Counts are
+ * exact up to 256 bits.
+ *
+ * Sampling draws r uniformly in [0, paths(start)) and walks down, taking
+ * the successor whose count range holds r. Every route is equally likely
+ * and a sample costs O(route length) successor steps (with one 64-bit
+ * word per step while the total fits in 64 bits).
+ *
+ * The counter snapshots the graph; rebuild it after the graph changes.
+ */
+class PathCounter {
+ public:
+  using NodeIndex = RunGraph::NodeIndex;
+  using PathCount = WideUint<4>;
+
+  /**
+   * @throws std::logic_error if the graph has no start node or has a cycle
+   * @throws std::overflow_error if a count needs more than 256 bits
+   */
+  explicit PathCounter(const RunGraph& graph);
+
+  const PathCount& GetPathCount() const { return total_; }
+  // Routes from node to a boss (0 if node is unreachable from the start)
+  const PathCount& GetPathCountFrom(NodeIndex node) const { return counts_[node]; }
+
+  /**
+   * Appends one uniformly random route (start first) to path
+   * @return false (path unchanged) if no route exists
+   */
+  template <typename Engine>
+  bool Sample(Engine& engine, std::vector<NodeIndex>& path) const;
+
+  /**
+   * Samples routes 0..count-1 of a reproducible batch; route i is drawn
+   * from CounterRng(seed, i), so any route can be regenerated alone.
+   * Routes are concatenated into nodes; route i occupies
+   * nodes[offsets[i] .. offsets[i + 1]). Both vectors are overwritten.
+   */
+  void SampleBatch(uint64_t seed, size_t count, std::vector<NodeIndex>& nodes,
+                   std::vector<uint32_t>& offsets) const;
+
+ private:
+  // Successors with a non-zero count, as CSR
+  std::vector<uint32_t> successorOffsets_;
+  std::vector<NodeIndex> successors_;
+
+  std::vector<PathCount> counts_;
+  std::vector<uint64_t> smallCounts_;  // Low words of counts_, used while total_ fits
+  PathCount total_;
+  NodeIndex start_ = RunGraph::INVALID_INDEX;
+};
+
+template <typename Engine>
+bool PathCounter::Sample(Engine& engine, std::vector<NodeIndex>& path) const {
+  if (total_.IsZero()) return false;
+
+  auto draw64 = [&engine] {
+    const uint64_t low = static_cast<uint32_t>(engine());
+    return (uint64_t{static_cast<uint32_t>(engine())} << 32) | low;
+  };
+
+  if (total_.FitsUint64()) {
+    // Uniform in [0, total) by rejection below the largest multiple of total
+    const uint64_t total = total_.ToUint64();
+    const uint64_t limit = UINT64_MAX - (UINT64_MAX % total + 1) % total;
+    uint64_t r = draw64();
+    while (r > limit) r = draw64();
+    r %= total;
+
+    NodeIndex node = start_;
+    path.push_back(node);
+    while (successorOffsets_[node] != successorOffsets_[node + 1]) {
+      for (uint32_t e = successorOffsets_[node];; ++e) {
+        const NodeIndex next = successors_[e];
+        if (r < smallCounts_[next]) {
+          node = next;
+          break;
+        }
+        r -= smallCounts_[next];
+      }
+      path.push_back(node);
+    }
+    return true;
+  }
+
+  // Wide total: draw words up to its bit width and reject values >= total
+  const size_t bits = total_.BitWidth();
+  PathCount r;
+  do {
+    for (size_t word = 0; word < (bits + 63) / 64; ++word) {
+      const size_t used = std::min<size_t>(64, bits - word * 64);
+      const uint64_t value = draw64();
+      r.SetWord(word, used == 64 ? value : value & ((uint64_t{1} << used) - 1));
+    }
+  } while (r >= total_);
+
+  NodeIndex node = start_;
+  path.push_back(node);
+  while (successorOffsets_[node] != successorOffsets_[node + 1]) {
+    for (uint32_t e = successorOffsets_[node];; ++e) {
+      const NodeIndex next = successors_[e];
+      if (r < counts_[next]) {
+        node = next;
+        break;
+      }
+      r -= counts_[next];
+    }
+    path.push_back(node);
+  }
+  return true;
+}
@@ -0,0 +1,148 @@
+#include "core/ReachabilityIndex.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+struct ReachabilityIndex::Snapshot {
+  std::vector<NodeIndex> offsets;  // CSR adjacency
+  std::vector<NodeIndex> targets;
+  std::vector<NodeIndex> byPost;  // Node at each post-order position
+  std::vector<uint32_t> post;     // Post-order number of each node
+  std::vector<uint32_t> low;      // Smallest post-order number in the node's DFS subtree
+};
+
+ReachabilityIndex::ReachabilityIndex(const RunGraph& graph, size_t memoryBudget)
+    : nodeCount_(graph.GetNodeCount()) {
+  Snapshot snapshot;
+
+  // Adjacency: the packed arrays when finalized, otherwise the node edge lists
+  if (graph.IsFinalized()) {
+    snapshot.offsets.assign(graph.GetEdgeOffsets().begin(), graph.GetEdgeOffsets().end());
+    snapshot.targets.assign(graph.GetEdgeTargets().begin(), graph.GetEdgeTargets().end());
+  } else {
+    snapshot.offsets.reserve(nodeCount_ + 1);
+    for (size_t i = 0; i < nodeCount_; ++i) {
+      snapshot.offsets.push_back(static_cast<NodeIndex>(snapshot.targets.size()));
+      for (const RunGraph::Node* next : graph.GetNode(static_cast<NodeIndex>(i))->GetNextRooms()) {
+        // Foreign targets cannot be queried
+        if (graph.Contains(next)) snapshot.targets.push_back(next->GetIndex());
+      }
+    }
+    snapshot.offsets.push_back(static_cast<NodeIndex>(snapshot.targets.size()));
+  }
+  if (nodeCount_ == 0) snapshot.offsets.assign(1, 0);
+
+  // Iterative DFS over every root in index order; post-order is a reverse
+  // topological order, and each subtree occupies a contiguous number range
+  enum class Color : uint8_t { White, Gray, Black };
+  struct Frame {
+    NodeIndex node;
+    NodeIndex nextEdge;
+  };
+  std::vector<Color> colors(nodeCount_, Color::White);
+  std::vector<Frame> stack;
+  snapshot.byPost.reserve(nodeCount_);
+  snapshot.post.resize(nodeCount_);
+  snapshot.low.resize(nodeCount_);
+
+  for (size_t root = 0; root < nodeCount_; ++root) {
+    if (colors[root] != Color::White) continue;
+    colors[root] = Color::Gray;
+    snapshot.low[root] = static_cast<uint32_t>(snapshot.byPost.size());
+    stack.push_back({static_cast<NodeIndex>(root), snapshot.offsets[root]});
+
+    while (!stack.empty()) {
+      Frame& frame = stack.back();
+      if (frame.nextEdge == snapshot.offsets[frame.node + 1]) {
+        colors[frame.node] = Color::Black;
+        snapshot.post[frame.node] = static_cast<uint32_t>(snapshot.byPost.size());
+        snapshot.byPost.push_back(frame.node);
+        stack.pop_back();
+        continue;
+      }
+
+      const NodeIndex next = snapshot.targets[frame.nextEdge++];
+      if (colors[next] == Color::Gray) {
+        throw std::invalid_argument("ReachabilityIndex requires an acyclic graph");
+      }
+      if (colors[next] == Color::White) {
+        colors[next] = Color::Gray;
+        snapshot.low[next] = static_cast<uint32_t>(snapshot.byPost.size());
+        stack.push_back({next, snapshot.offsets[next]});
+      }
+    }
+  }
+
+  if (ClosureBytes(nodeCount_) <= memoryBudget) {
+    BuildClosure(snapshot);
+  } else {
+    BuildIntervals(snapshot);
+  }
+}
+
+void ReachabilityIndex::BuildClosure(const Snapshot& snapshot) {
+  mode_ = Mode::Closure;
+  wordsPerRow_ = (nodeCount_ + 63) / 64;
+  closure_.assign(nodeCount_ * wordsPerRow_, 0);
+
+  // Successors finish first in post-order, so their rows are complete
+  for (const NodeIndex node : snapshot.byPost) {
+    uint64_t* row = closure_.data() + node * wordsPerRow_;
+    row[node / 64] |= uint64_t{1} << (node % 64);
+    for (NodeIndex e = snapshot.offsets[node]; e < snapshot.offsets[node + 1]; ++e) {
+      const uint64_t* from = closure_.data() + snapshot.targets[e] * wordsPerRow_;
+      for (size_t word = 0; word < wordsPerRow_; ++word) {
+        row[word] |= from[word];
+      }
+    }
+  }
+}
+
+void ReachabilityIndex::BuildIntervals(const Snapshot& snapshot) {
+  mode_ = Mode::Intervals;
+  postOrder_ = snapshot.post;
+  intervalOffsets_.reserve(nodeCount_ + 1);
+
+  // A node reaches its own DFS subtree plus whatever its successors reach;
+  // lists are stored by post-order position, so successors' lists are final
+  std::vector<Interval> merged;
+  for (const NodeIndex node : snapshot.byPost) {
+    intervalOffsets_.push_back(static_cast<uint32_t>(intervals_.size()));
+    merged.clear();
+    merged.push_back({snapshot.low[node], snapshot.post[node]});
+    for (NodeIndex e = snapshot.offsets[node]; e < snapshot.offsets[node + 1]; ++e) {
+      const uint32_t position = snapshot.post[snapshot.targets[e]];
+      merged.insert(merged.end(), intervals_.begin() + intervalOffsets_[position],
+                    intervals_.begin() + intervalOffsets_[position + 1]);
+    }
+
+    std::sort(merged.begin(), merged.end(),
+              [](const Interval& a, const Interval& b) { return a.begin < b.begin; });
+    for (const Interval& interval : merged) {
+      if (intervals_.size() > intervalOffsets_.back() &&
+          interval.begin <= intervals_.back().end + 1) {
+        intervals_.back().end = std::max(intervals_.back().end, interval.end);
+      } else {
+        intervals_.push_back(interval);
+      }
+    }
+  }
+  intervalOffsets_.push_back(static_cast<uint32_t>(intervals_.size()));
+  intervals_.shrink_to_fit();
+}
+
+bool ReachabilityIndex::IntervalsContain(NodeIndex from, uint32_t post) const {
+  const uint32_t position = postOrder_[from];
+  const Interval* begin = intervals_.data() + intervalOffsets_[position];
+  const Interval* end = intervals_.data() + intervalOffsets_[position + 1];
+
+  // Last interval starting at or before post
+  const Interval* after = std::upper_bound(
+      begin, end, post, [](uint32_t value, const Interval& interval) { return value < interval.begin; });
+  return after != begin && (after - 1)->end >= post;
+}
+
+size_t ReachabilityIndex::GetMemoryBytes() const {
+  return closure_.size() * sizeof(uint64_t) + postOrder_.size() * sizeof(uint32_t) +
+         intervalOffsets_.size() * sizeof(uint32_t) + intervals_.size() * sizeof(Interval);
+}
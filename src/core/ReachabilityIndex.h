@@ -0,0 +1,80 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "core/RunGraph.h"
+
+/**
+ * Answers "can room A reach room B" without a graph search per query
+ *
+ * Built once from a snapshot of an acyclic RunGraph (rebuild it after the
+ * graph changes). Two representations, chosen by a memory budget:
+ * - Closure: one bitset row per node holding every node it reaches. Rows
+ *   are filled in reverse topological order by OR-ing successor rows a
+ *   64-bit word at a time (the loop vectorizes). Queries are one bit test.
+ *   Needs V * ceil(V / 64) * 8 bytes, so 32768 nodes fit in 128 MiB.
+ * - Intervals: above the budget, tree-cover interval labelling. Nodes are
+ *   numbered in DFS post-order; each node keeps the merged post-order
+ *   intervals it reaches, so a query is a binary search over its intervals.
+ *   Run graphs are chains with short merging branches, which leaves one or
+ *   two intervals per node.
+ *
+ * A node always reaches itself.
+ */
+class ReachabilityIndex {
+ public:
+  using NodeIndex = RunGraph::NodeIndex;
+
+  enum class Mode { Closure, Intervals };
+
+  static constexpr size_t DEFAULT_MEMORY_BUDGET = size_t{128} << 20;
+
+  /**
+   * @param memoryBudget Largest closure to build, in bytes (0 = always intervals)
+   * @throws std::invalid_argument if the graph has a cycle
+   */
+  explicit ReachabilityIndex(const RunGraph& graph, size_t memoryBudget = DEFAULT_MEMORY_BUDGET);
+
+  // from and to must be indices of the indexed graph
+  bool CanReach(NodeIndex from, NodeIndex to) const {
+    if (mode_ == Mode::Closure) {
+      return (closure_[from * wordsPerRow_ + to / 64] >> (to % 64)) & 1;
+    }
+    return IntervalsContain(from, postOrder_[to]);
+  }
+  bool CanReach(const RunGraph::Node* from, const RunGraph::Node* to) const {
+    return CanReach(from->GetIndex(), to->GetIndex());
+  }
+
+  Mode GetMode() const { return mode_; }
+  size_t GetNodeCount() const { return nodeCount_; }
+  size_t GetMemoryBytes() const;
+
+  static size_t ClosureBytes(size_t nodeCount) { return nodeCount * ((nodeCount + 63) / 64) * 8; }
+
+ private:
+  struct Interval {
+    uint32_t begin;  // Inclusive post-order numbers
+    uint32_t end;
+  };
+
+  // Adjacency and DFS numbering, only needed while building
+  struct Snapshot;
+
+  bool IntervalsContain(NodeIndex from, uint32_t post) const;
+
+  void BuildClosure(const Snapshot& snapshot);
+  void BuildIntervals(const Snapshot& snapshot);
+
+  Mode mode_ = Mode::Closure;
+  size_t nodeCount_ = 0;
+
+  std::vector<uint32_t> postOrder_;  // DFS post-order number of each node (intervals only)
+
+  size_t wordsPerRow_ = 0;
+  std::vector<uint64_t> closure_;
+
+  std::vector<uint32_t> intervalOffsets_;
+  std::vector<Interval> intervals_;
+};
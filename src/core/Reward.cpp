@@ -1,5 +1,8 @@
 #include "Reward.h"
 
+#include <stdexcept>
+#include <string>
+
 const char* Reward::ToString(Reward::Type type) {
   switch (type) {
     case Type::Boon:
@@ -29,4 +32,47 @@ const char* Reward::ToString(Reward::Type type) {
     default:
       return "Unknown";
   }
-}
\ No newline at end of file
+}
+
+const char* Reward::ToString(Reward::God god) {
+  switch (god) {
+    case God::None:
+      return "";
+    case God::Zeus:
+      return "Zeus";
+    case God::Poseidon:
+      return "Poseidon";
+    case God::Athena:
+      return "Athena";
+    case God::Ares:
+      return "Ares";
+    case God::Aphrodite:
+      return "Aphrodite";
+    case God::Artemis:
+      return "Artemis";
+    case God::Dionysus:
+      return "Dionysus";
+    case God::Demeter:
+      return "Demeter";
+    case God::Hermes:
+      return "Hermes";
+    case God::Chaos:
+      return "Chaos";
+    default:
+      return "Unknown";
+  }
+}
+
+Reward::God Reward::GodFromString(std::string_view name) {
+  for (uint8_t i = 0; i <= static_cast<uint8_t>(God::Chaos); ++i) {
+    const auto god = static_cast<God>(i);
+    if (name == ToString(god)) {
+      return god;
+    }
+  }
+  throw std::invalid_argument("Unknown god: " + std::string(name));
+}
+
+Reward::Data::Data(Type t, std::string_view god) : type(t), god(GodFromString(god)) {}
+
+std::string_view Reward::Data::GodName() const { return ToString(god); }
\ No newline at end of file
@@ -1,5 +1,9 @@
 #pragma once
-#include <string>
+#include <array>
+#include <cstddef>
+#include <cstdint>
+#include <string_view>
+#include <vector>
 
 /**
  * Reward types available in Hades
@@ -7,7 +11,7 @@
  */
 
 namespace Reward {
-enum class Type {
+enum class Type : uint8_t {
   Boon,          // God blessing (Zeus, Athena, etc.)
   Pom,           // Pomegranate - upgrade existing boon
   Gold,          // Obols (currency)
@@ -21,19 +25,88 @@ enum class Type {
   ErebusGate,    // Challenge gate (not reard, but a choice)
   ChaosGate      // Chaos boon opportunity
 };
+inline constexpr size_t TYPE_COUNT = static_cast<size_t>(Type::ChaosGate) + 1;
+
+/**
+ * Gods that can offer boons
+ */
+enum class God : uint8_t {
+  None,
+  Zeus,
+  Poseidon,
+  Athena,
+  Ares,
+  Aphrodite,
+  Artemis,
+  Dionysus,
+  Demeter,
+  Hermes,
+  Chaos
+};
 
 /**
  * Reward data with type and optional metadata
  */
 struct Data {
-  Type type;
-  std::string godName;  // For boons (eg Zeus, Athena)
+  Type type = Type::Boon;
+  God god = God::None;  // For boons (eg Zeus, Athena)
   int quantity = 1;     // For stackable rewards (gold, gems)
 
-  Data(Type t) : type(t) {}
-  Data(Type t, std::string god) : type(t), godName(std::move(god)) {}
-  Data(Type t, int qty) : type(t), quantity(qty) {}
+  constexpr Data() = default;
+  constexpr Data(Type t) : type(t) {}
+  constexpr Data(Type t, God g) : type(t), god(g) {}
+  // @throws std::invalid_argument if god is not a known god name
+  Data(Type t, std::string_view god);
+  constexpr Data(Type t, int qty) : type(t), quantity(qty) {}
+
+  // Display name of the god ("" when there is none)
+  std::string_view GodName() const;
+};
+
+/**
+ * Small-buffer list of rewards
+ *
+ * Rooms typically offer 1-3 rewards, which are stored inline; only a
+ * list that grows past INLINE_CAPACITY moves to the heap.
+ */
+class List {
+ public:
+  static constexpr size_t INLINE_CAPACITY = 3;
+
+  void push_back(const Data& reward) {
+    if (overflow_.empty() && size_ < INLINE_CAPACITY) {
+      inline_[size_] = reward;
+    } else {
+      if (overflow_.empty()) {
+        overflow_.assign(inline_.begin(), inline_.begin() + size_);
+      }
+      overflow_.push_back(reward);
+    }
+    ++size_;
+  }
+
+  void clear() {
+    overflow_.clear();
+    size_ = 0;
+  }
+
+  size_t size() const { return size_; }
+  bool empty() const { return size_ == 0; }
+  bool IsInline() const { return overflow_.empty(); }
+
+  const Data* data() const { return overflow_.empty() ? inline_.data() : overflow_.data(); }
+  const Data* begin() const { return data(); }
+  const Data* end() const { return data() + size_; }
+  const Data& operator[](size_t index) const { return data()[index]; }
+
+ private:
+  std::array<Data, INLINE_CAPACITY> inline_{};
+  std::vector<Data> overflow_;
+  size_t size_ = 0;
 };
 
 const char* ToString(Type type);
-}  // namespace Reward
\ No newline at end of file
+const char* ToString(God god);
+// @throws std::invalid_argument if name is not a known god
+God GodFromString(std::string_view name);
+}  // namespace Reward
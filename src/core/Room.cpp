@@ -1,7 +1,9 @@
 #include "Room.h"
 
-Room::Room(std::string id, Type type) : id_(std::move(id)), type_(type) {
-  if (id_.empty()) {
+Room::Room(std::string_view id, Type type) : Room(RoomId(id), type) {}
+
+Room::Room(RoomId id, Type type) : id_(id), type_(type) {
+  if (id_.Empty()) {
     throw std::invalid_argument("Room ID cannot be empty");
   }
 }
@@ -29,20 +31,27 @@ const char* Room::TypeToString(Type type) {
   }
 }
 
-void Room::AddExit(glm::vec2 position, Direction direction) {
-  if (exits_.size() >= MAX_EXITS) {
-    throw std::runtime_error("Cannot exceed maximum exit count of " + std::to_string(MAX_EXITS));
+const char* Room::DirectionToString(Direction direction) {
+  switch (direction) {
+    case Direction::North:
+      return "North";
+    case Direction::South:
+      return "South";
+    case Direction::East:
+      return "East";
+    case Direction::West:
+      return "West";
+    default:
+      return "Unknown";
   }
-  exits_.push_back({position, direction});
 }
 
-bool Room::HasExit(Direction direction) const {
-  for (const auto& exit : exits_) {
-    if (exit.direction == direction) {
-      return true;
-    }
+void Room::AddExit(glm::vec2 position, Direction direction) {
+  if (exitCount_ >= MAX_EXITS) {
+    throw std::runtime_error("Cannot exceed maximum exit count of " + std::to_string(MAX_EXITS));
   }
-  return false;
+  exits_[exitCount_++] = {position, direction};
+  exitMask_ |= DirectionBit(direction);
 }
 
 void Room::AddReward(Reward::Type type) { rewards_.push_back(Reward::Data(type)); }
@@ -1,17 +1,22 @@
 #pragma once
+#include <array>
+#include <cstdint>
 #include <glm/glm.hpp>
+#include <span>
 #include <stdexcept>
 #include <string>
+#include <string_view>
 #include <vector>
 
 #include "Biome.h"
 #include "Reward.h"
+#include "RoomId.h"
 
 /**
  * Represents a single room in the dungeon run
  *
  * Each room has:
- * - Unique identifier
+ * - Unique identifier (stored inline, see RoomId)
  * - Type (Combat, Elite, Boss, etc.)
  * - Connections to other rooms (exits)
  * - Metadata (biome, difficulty, rewards)
@@ -28,12 +33,33 @@ class Room {
     Story,     // Narrative/character moment
     Boss       // Biome boss (Meg, Hydra, etc.)
   };
+  static constexpr size_t TYPE_COUNT = static_cast<size_t>(Type::Boss) + 1;
 
   /**
    * Exit direction (Which wall the exit is on)
    */
 
-  enum class Direction { North, South, East, West };
+  enum class Direction : uint8_t { North, South, East, West };
+
+  /**
+   * One bit per Direction, so exit queries are single bit tests
+   */
+  using DirectionMask = uint8_t;
+  static constexpr DirectionMask DirectionBit(Direction direction) {
+    return static_cast<DirectionMask>(1u << static_cast<uint8_t>(direction));
+  }
+  static constexpr Direction Opposite(Direction direction) {
+    switch (direction) {
+      case Direction::North:
+        return Direction::South;
+      case Direction::South:
+        return Direction::North;
+      case Direction::East:
+        return Direction::West;
+      default:
+        return Direction::East;
+    }
+  }
 
   /**
    * Represents an exit point in the room
@@ -48,19 +74,29 @@ class Room {
    * @param id Unique room identifier
    * @param type Room type
    * @throws std::invalid_argument if id is empty
+   * @throws std::length_error if id is longer than RoomId::MAX_LENGTH
    */
-  Room(std::string id, Type type);
+  Room(std::string_view id, Type type);
+  Room(RoomId id, Type type);
 
   // Getters
-  const std::string& GetId() const { return id_; }
+  std::string_view GetId() const { return id_.View(); }
+  const RoomId& GetRoomId() const { return id_; }
   Type GetType() const { return type_; }
   static const char* TypeToString(Type type);
+  static const char* DirectionToString(Direction direction);
 
-  // Exit management
+  // Exit management (inline storage, never allocates)
   void AddExit(glm::vec2 position, Direction direction);
-  size_t GetExitCount() const { return exits_.size(); }
-  bool HasExit(Direction direction) const;
-  const std::vector<Exit>& GetExits() const { return exits_; }
+  size_t GetExitCount() const { return exitCount_; }
+  bool HasExit(Direction direction) const { return (exitMask_ & DirectionBit(direction)) != 0; }
+  DirectionMask GetExitMask() const { return exitMask_; }
+  std::span<const Exit> GetExits() const { return {exits_.data(), exitCount_}; }
+
+  // True if leaving this room through `direction` lands on an exit of `next`
+  bool CanConnectTo(const Room& next, Direction direction) const {
+    return HasExit(direction) && next.HasExit(Opposite(direction));
+  }
 
   // Metadata
   void SetBiome(Biome::Type biome) { biome_ = biome; }
@@ -73,19 +109,21 @@ class Room {
   void AddReward(Reward::Type type);
   void AddReward(const Reward::Data& reward);
   void ClearRewards() { rewards_.clear(); }
-  const std::vector<Reward::Data>& GetRewards() const { return rewards_; }
+  const Reward::List& GetRewards() const { return rewards_; }
 
   // Maximum exits per room (based on 4 cardinal directions)
   static constexpr size_t MAX_EXITS = 4;
 
  private:
-  std::string id_;
+  RoomId id_;
   Type type_;
 
-  std::vector<Exit> exits_;
+  std::array<Exit, MAX_EXITS> exits_{};
+  uint8_t exitCount_ = 0;
+  DirectionMask exitMask_ = 0;
 
   Biome::Type biome_ = Biome::Type::Tartarus;
   float difficulty_ = 1.0f;
 
-  std::vector<Reward::Data> rewards_;
+  Reward::List rewards_;
 };
\ No newline at end of file
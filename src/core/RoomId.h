@@ -0,0 +1,48 @@
+#pragma once
+#include <compare>
+#include <cstdint>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/**
+ * Fixed-capacity room identifier stored inline
+ *
+ * Holds up to MAX_LENGTH characters in place, so creating, copying and
+ * comparing ids never touches the heap. Converts implicitly to
+ * std::string_view for comparisons and display.
+ */
+class RoomId {
+ public:
+  static constexpr size_t MAX_LENGTH = 31;
+
+  RoomId() = default;
+
+  /**
+   * @throws std::length_error if id is longer than MAX_LENGTH
+   */
+  explicit RoomId(std::string_view id) {
+    if (id.size() > MAX_LENGTH) {
+      throw std::length_error("Room ID exceeds " + std::to_string(MAX_LENGTH) + " characters");
+    }
+    std::memcpy(data_, id.data(), id.size());
+    length_ = static_cast<uint8_t>(id.size());
+  }
+
+  std::string_view View() const { return {data_, length_}; }
+  operator std::string_view() const { return View(); }
+
+  size_t Size() const { return length_; }
+  bool Empty() const { return length_ == 0; }
+
+  friend bool operator==(const RoomId& a, const RoomId& b) { return a.View() == b.View(); }
+  friend bool operator==(const RoomId& a, std::string_view b) { return a.View() == b; }
+  friend std::strong_ordering operator<=>(const RoomId& a, const RoomId& b) {
+    return a.View() <=> b.View();
+  }
+
+ private:
+  char data_[MAX_LENGTH] = {};
+  uint8_t length_ = 0;
+};
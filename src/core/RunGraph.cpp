@@ -1,47 +1,342 @@
 #include "RunGraph.h"
 
+#include <algorithm>
+#include <stdexcept>
+
 // Node implementation
-RunGraph::Node::Node(std::unique_ptr<Room> room) : room_(std::move(room)) {}
+RunGraph::Node::Node(std::unique_ptr<Room> room)
+    : room_(room ? std::move(*room) : throw std::invalid_argument("Node requires a room")) {}
+
+RunGraph::Node::Node(Room room) : room_(std::move(room)) {}
 
 void RunGraph::Node::AddConnection(Node* next) {
+  if (packed_) {
+    throw std::logic_error("Cannot add connections to a finalized graph");
+  }
   if (next) {
     next_.push_back(next);
   }
 }
 
 // RunGraph implementation
-RunGraph::Node* RunGraph::AddRoom(std::string id, Room::Type type) {
-  auto room = std::make_unique<Room>(std::move(id), type);
-  return AddRoom(std::move(room));
+RunGraph::Node* RunGraph::AddRoom(std::string_view id, Room::Type type) {
+  return AddRoom(RoomId(id), type);
+}
+
+RunGraph::Node* RunGraph::AddRoom(RoomId id, Room::Type type) {
+  return AddRoom(Room(id, type));
+}
+
+RunGraph::Node* RunGraph::AddRoom(Room room) {
+  ThrowIfFinalized();
+  return PushNode(std::make_unique<Node>(std::move(room)));
 }
 
 RunGraph::Node* RunGraph::AddRoom(std::unique_ptr<Room> room) {
-  auto node = std::make_unique<Node>(std::move(room));
+  ThrowIfFinalized();
+  return PushNode(std::make_unique<Node>(std::move(room)));
+}
+
+RunGraph::Node* RunGraph::PushNode(std::unique_ptr<Node> node) {
+  node->index_ = static_cast<NodeIndex>(nodes_.size());
   Node* nodePtr = node.get();
   nodes_.push_back(std::move(node));
+  InvalidatePaths();
+  if (observer_) {
+    observer_->OnRoomAdded(nodePtr->index_, nodePtr->room_);
+  }
   return nodePtr;
 }
 
 void RunGraph::Connect(Node* from, Node* to) {
+  ThrowIfFinalized();
   if (from && to) {
     from->AddConnection(to);
+    InvalidatePaths();
+    // Edges leaving a foreign node are invisible to this graph
+    if (observer_ && Contains(from)) {
+      observer_->OnConnected(from->index_, Contains(to) ? to->index_ : INVALID_INDEX);
+    }
+  }
+}
+
+void RunGraph::SetStartNode(Node* node) {
+  startNode_ = node;
+  InvalidatePaths();
+  if (observer_) {
+    observer_->OnStartNodeChanged(node, node && Contains(node) ? node->index_ : INVALID_INDEX);
+  }
+}
+
+void RunGraph::Reserve(size_t nodeCount, size_t edgeCount) {
+  ThrowIfFinalized();
+  nodes_.reserve(nodeCount);
+  if (edgeCount > 0) {
+    packedNodes_.reserve(nodeCount);
+    edgeOffsets_.reserve(nodeCount + 1);
+    edgeTargets_.reserve(edgeCount);
+    edgeNodes_.reserve(edgeCount);
+  }
+}
+
+void RunGraph::Finalize() {
+  if (finalized_) return;
+
+  const size_t nodeCount = nodes_.size();
+
+  // Build CSR offsets/targets from the per-node edge lists
+  edgeOffsets_.assign(nodeCount + 1, 0);
+  size_t edgeCount = 0;
+  for (size_t i = 0; i < nodeCount; ++i) {
+    edgeOffsets_[i] = static_cast<NodeIndex>(edgeCount);
+    edgeCount += nodes_[i]->next_.size();
+  }
+  edgeOffsets_[nodeCount] = static_cast<NodeIndex>(edgeCount);
+
+  edgeTargets_.clear();
+  edgeTargets_.reserve(edgeCount);
+  for (const auto& node : nodes_) {
+    for (const Node* next : node->next_) {
+      const NodeIndex target = next->index_;
+      if (target >= nodeCount || nodes_[target].get() != next) {
+        edgeOffsets_.clear();
+        edgeTargets_.clear();
+        throw std::invalid_argument("Edge targets a node that does not belong to this graph");
+      }
+      edgeTargets_.push_back(target);
+    }
+  }
+
+  const NodeIndex startIndex = startNode_ ? startNode_->index_ : INVALID_INDEX;
+  if (startNode_ && (startIndex >= nodeCount || nodes_[startIndex].get() != startNode_)) {
+    edgeOffsets_.clear();
+    edgeTargets_.clear();
+    throw std::invalid_argument("Start node does not belong to this graph");
+  }
+
+  // Move nodes into one contiguous array
+  packedNodes_.clear();
+  packedNodes_.reserve(nodeCount);
+  for (auto& node : nodes_) {
+    packedNodes_.push_back(std::move(*node));
+  }
+  nodes_.clear();
+  nodes_.shrink_to_fit();
+
+  edgeNodes_.resize(edgeCount);
+  for (size_t e = 0; e < edgeCount; ++e) {
+    edgeNodes_[e] = &packedNodes_[edgeTargets_[e]];
+  }
+
+  for (size_t i = 0; i < nodeCount; ++i) {
+    Node& node = packedNodes_[i];
+    std::vector<Node*>().swap(node.next_);
+    node.packedNext_ = std::span<Node* const>(edgeNodes_.data() + edgeOffsets_[i],
+                                              edgeOffsets_[i + 1] - edgeOffsets_[i]);
+    node.packed_ = true;
   }
+
+  startNode_ = startIndex != INVALID_INDEX ? &packedNodes_[startIndex] : nullptr;
+  finalized_ = true;
+}
+
+size_t RunGraph::GetEdgeCount() const {
+  if (finalized_) return edgeTargets_.size();
+
+  size_t count = 0;
+  for (const auto& node : nodes_) {
+    count += node->next_.size();
+  }
+  return count;
+}
+
+size_t RunGraph::GetMemoryUsage() const {
+  size_t bytes = sizeof(RunGraph);
+  const auto nodeBytes = [](const Node& node) {
+    size_t extra = node.next_.capacity() * sizeof(Node*);
+    const Reward::List& rewards = node.room_.GetRewards();
+    if (!rewards.IsInline()) extra += rewards.size() * sizeof(Reward::Data);
+    return extra;
+  };
+
+  bytes += nodes_.capacity() * sizeof(std::unique_ptr<Node>);
+  for (const auto& node : nodes_) {
+    bytes += sizeof(Node) + nodeBytes(*node);
+  }
+  bytes += packedNodes_.capacity() * sizeof(Node);
+  for (const Node& node : packedNodes_) {
+    bytes += nodeBytes(node);
+  }
+
+  bytes += (edgeOffsets_.capacity() + edgeTargets_.capacity()) * sizeof(NodeIndex);
+  bytes += edgeNodes_.capacity() * sizeof(Node*);
+  bytes += distances_.capacity() * sizeof(int);
+  bytes += criticalPath_.capacity() * sizeof(NodeIndex);
+  return bytes;
 }
 
 std::vector<RunGraph::Node*> RunGraph::GetAllNodes() {
   std::vector<Node*> result;
-  result.reserve(nodes_.size());
-  for (auto& node : nodes_) {
-    result.push_back(node.get());
+  result.reserve(GetNodeCount());
+  for (size_t i = 0; i < GetNodeCount(); ++i) {
+    result.push_back(GetNode(static_cast<NodeIndex>(i)));
   }
   return result;
 }
 
 std::vector<const RunGraph::Node*> RunGraph::GetAllNodes() const {
   std::vector<const Node*> result;
-  result.reserve(nodes_.size());
-  for (const auto& node : nodes_) {
-    result.push_back(node.get());
+  result.reserve(GetNodeCount());
+  for (size_t i = 0; i < GetNodeCount(); ++i) {
+    result.push_back(GetNode(static_cast<NodeIndex>(i)));
   }
   return result;
-}
\ No newline at end of file
+}
+
+bool RunGraph::Contains(const Node* node) const {
+  return node && node->index_ < GetNodeCount() && GetNode(node->index_) == node;
+}
+
+void RunGraph::ThrowIfFinalized() const {
+  if (finalized_) {
+    throw std::logic_error("Cannot modify a finalized RunGraph");
+  }
+}
+
+std::span<const int> RunGraph::GetDistances(DepthMetric metric) const {
+  EnsurePaths();
+  const size_t nodeCount = GetNodeCount();
+  return std::span<const int>(distances_).subspan(metric == DepthMetric::Shortest ? 0 : nodeCount,
+                                                  nodeCount);
+}
+
+std::span<const RunGraph::NodeIndex> RunGraph::GetCriticalPath() const {
+  EnsurePaths();
+  return criticalPath_;
+}
+
+void RunGraph::AssignDepths(DepthMetric metric) {
+  const std::span<const int> distances = GetDistances(metric);
+  for (size_t i = 0; i < distances.size(); ++i) {
+    GetNode(static_cast<NodeIndex>(i))->depth_ = distances[i];
+  }
+}
+
+void RunGraph::MarkCriticalPath() {
+  const std::span<const NodeIndex> path = GetCriticalPath();
+  for (size_t i = 0; i < GetNodeCount(); ++i) {
+    GetNode(static_cast<NodeIndex>(i))->onCriticalPath_ = false;
+  }
+  for (const NodeIndex index : path) {
+    GetNode(index)->onCriticalPath_ = true;
+  }
+}
+
+bool RunGraph::PrecomputePaths() const { return pathsValid_ || ComputePaths(); }
+
+void RunGraph::EnsurePaths() const {
+  if (pathsValid_) return;
+  if (!startNode_ || !Contains(startNode_)) {
+    throw std::logic_error("Path analysis requires a start node in the graph");
+  }
+  if (!ComputePaths()) {
+    throw std::logic_error("Path analysis requires an acyclic graph");
+  }
+}
+
+bool RunGraph::ComputePaths() const {
+  if (!startNode_ || !Contains(startNode_)) return false;
+
+  const size_t nodeCount = GetNodeCount();
+  auto forEachSuccessor = [&](NodeIndex node, auto&& visit) {
+    if (finalized_) {
+      for (NodeIndex e = edgeOffsets_[node]; e < edgeOffsets_[node + 1]; ++e) {
+        visit(edgeTargets_[e]);
+      }
+    } else {
+      // Foreign targets are not part of this graph's paths
+      for (const Node* next : nodes_[node]->next_) {
+        if (Contains(next)) visit(next->index_);
+      }
+    }
+  };
+
+  // Scratch: in-degrees, then topological order, then longest-path predecessors
+  std::vector<NodeIndex> scratch(3 * nodeCount);
+  const std::span<NodeIndex> inDegree(scratch.data(), nodeCount);
+  const std::span<NodeIndex> order(scratch.data() + nodeCount, nodeCount);
+  const std::span<NodeIndex> predecessor(scratch.data() + 2 * nodeCount, nodeCount);
+  const NodeIndex start = startNode_->index_;
+
+  // Only nodes reachable from start take part, so a cycle elsewhere does not
+  // block path queries (GraphValidator likewise only reports reachable cycles).
+  // Breadth-first search, using order as the queue and predecessor as the seen flag
+  std::fill(predecessor.begin(), predecessor.end(), INVALID_INDEX);
+  order[0] = start;
+  predecessor[start] = start;
+  size_t reachable = 1;
+  for (size_t head = 0; head < reachable; ++head) {
+    forEachSuccessor(order[head], [&](NodeIndex next) {
+      if (predecessor[next] == INVALID_INDEX) {
+        predecessor[next] = next;
+        order[reachable++] = next;
+      }
+    });
+  }
+
+  // Kahn's algorithm over the reachable nodes, again using order as the queue
+  for (size_t i = 0; i < reachable; ++i) {
+    forEachSuccessor(order[i], [&](NodeIndex next) { ++inDegree[next]; });
+  }
+  if (inDegree[start] != 0) return false;
+  size_t tail = 1;
+  for (size_t head = 0; head < tail; ++head) {
+    forEachSuccessor(order[head], [&](NodeIndex next) {
+      if (--inDegree[next] == 0) order[tail++] = next;
+    });
+  }
+  if (tail != reachable) return false;
+
+  std::vector<int> distances(2 * nodeCount, UNREACHABLE);
+  int* shortest = distances.data();
+  int* longest = distances.data() + nodeCount;
+  std::fill(predecessor.begin(), predecessor.end(), INVALID_INDEX);
+
+  shortest[start] = 0;
+  longest[start] = 0;
+  for (const NodeIndex node : order.first(reachable)) {
+    forEachSuccessor(node, [&](NodeIndex next) {
+      if (shortest[next] == UNREACHABLE || shortest[node] + 1 < shortest[next]) {
+        shortest[next] = shortest[node] + 1;
+      }
+      // Ties keep the lower-index predecessor, so the generator's spine wins over branches
+      if (longest[node] + 1 > longest[next] ||
+          (longest[node] + 1 == longest[next] && node < predecessor[next])) {
+        longest[next] = longest[node] + 1;
+        predecessor[next] = node;
+      }
+    });
+  }
+
+  NodeIndex boss = INVALID_INDEX;
+  for (size_t node = 0; node < nodeCount; ++node) {
+    if (longest[node] == UNREACHABLE ||
+        GetNode(static_cast<NodeIndex>(node))->room_.GetType() != Room::Type::Boss) {
+      continue;
+    }
+    if (boss == INVALID_INDEX || longest[node] > longest[boss]) {
+      boss = static_cast<NodeIndex>(node);
+    }
+  }
+
+  // Walk predecessors back from the boss, filling the path from its end
+  criticalPath_.assign(boss == INVALID_INDEX ? 0 : static_cast<size_t>(longest[boss]) + 1, 0);
+  size_t position = criticalPath_.size();
+  for (NodeIndex node = boss; node != INVALID_INDEX; node = predecessor[node]) {
+    criticalPath_[--position] = node;
+  }
+
+  distances_ = std::move(distances);
+  pathsValid_ = true;
+  return true;
+}
@@ -1,6 +1,8 @@
 #pragma once
 
+#include <cstdint>
 #include <memory>
+#include <span>
 #include <vector>
 
 #include "Room.h"
@@ -13,19 +15,40 @@
  * - Edges represent possible paths
  * - One start node, one or more end nodes (boss)
  * - No cycles (can't go backwards)
+ *
+ * Storage modes:
+ * - Building: nodes are individually owned so Node* handles stay stable
+ *   while rooms and connections are added
+ * - Finalized: after Finalize(), nodes live in one contiguous array in
+ *   index order and edges are packed into a CSR (compressed sparse row)
+ *   array. The graph is read-only from then on.
  */
 class RunGraph {
  public:
+  using NodeIndex = uint32_t;
+  static constexpr NodeIndex INVALID_INDEX = UINT32_MAX;
+
   /**
    * Node in the graph, wrapping a Room
    */
   class Node {
    public:
     explicit Node(std::unique_ptr<Room> room);
+    explicit Node(Room room);
+
+    Node(const Node&) = delete;
+    Node& operator=(const Node&) = delete;
+    Node(Node&&) noexcept = default;
+    Node& operator=(Node&&) noexcept = default;
 
     // Connections
     void AddConnection(Node* next);
-    const std::vector<Node*>& GetNextRooms() const { return next_; }
+    std::span<Node* const> GetNextRooms() const {
+      return packed_ ? packedNext_ : std::span<Node* const>(next_);
+    }
+
+    // Position in the owning graph (INVALID_INDEX for standalone nodes)
+    NodeIndex GetIndex() const { return index_; }
 
     // Metadata
     void SetDepth(int depth) { depth_ = depth; }
@@ -35,14 +58,36 @@ class RunGraph {
     bool IsOnCriticalPath() const { return onCriticalPath_; }
 
     // Room access
-    const Room* GetRoom() const { return room_.get(); }
-    Room* GetRoom() { return room_.get(); }
+    const Room* GetRoom() const { return &room_; }
+    Room* GetRoom() { return &room_; }
 
    private:
-    std::unique_ptr<Room> room_;
-    std::vector<Node*> next_;
+    friend class RunGraph;
+
+    Room room_;
+    std::vector<Node*> next_;            // Building mode edges
+    std::span<Node* const> packedNext_;  // Finalized mode edges (view into the CSR array)
+    NodeIndex index_ = INVALID_INDEX;
     int depth_ = 0;
     bool onCriticalPath_ = false;
+    bool packed_ = false;
+  };
+
+  /**
+   * Receives every structural mutation made through the RunGraph API
+   *
+   * Edges added with Node::AddConnection directly bypass the graph and are
+   * not reported.
+   */
+  class MutationObserver {
+   public:
+    virtual ~MutationObserver() = default;
+
+    virtual void OnRoomAdded(NodeIndex index, const Room& room) = 0;
+    // to is INVALID_INDEX when the target does not belong to the graph
+    virtual void OnConnected(NodeIndex from, NodeIndex to) = 0;
+    // index is INVALID_INDEX when node is null or does not belong to the graph
+    virtual void OnStartNodeChanged(const Node* node, NodeIndex index) = 0;
   };
 
   RunGraph() = default;
@@ -51,25 +96,124 @@ class RunGraph {
   RunGraph(const RunGraph&) = delete;
   RunGraph& operator=(const RunGraph&) = delete;
 
-  // Default move operations ( will move unique ptrs correctly )
+  // Moving keeps a finalized graph valid: edgeNodes_ and each node's
+  // packedNext_ point into vector heap buffers, which a move does not relocate
   RunGraph(RunGraph&&) noexcept = default;
-  RunGraph& operator=(const RunGraph&&) = delete;
+  RunGraph& operator=(RunGraph&&) noexcept = default;
 
   // Graph construction
-  Node* AddRoom(std::string id, Room::Type type);
+  // @throws std::logic_error once the graph has been finalized
+  Node* AddRoom(std::string_view id, Room::Type type);
+  Node* AddRoom(RoomId id, Room::Type type);
   Node* AddRoom(std::unique_ptr<Room> room);
+  Node* AddRoom(Room room);
   void Connect(Node* from, Node* to);
+  // Reserves node storage and, when edgeCount is known, the packed arrays
+  // Finalize() fills, so building and packing a run never reallocates
+  void Reserve(size_t nodeCount, size_t edgeCount = 0);
+
+  /**
+   * Packs nodes into contiguous storage and edges into a CSR array
+   *
+   * Node* handles obtained before this call are invalidated; use
+   * GetNode(index) or GetStartNode() afterwards. Calling it twice is a no-op.
+   * @throws std::invalid_argument if an edge targets a node outside this graph
+   */
+  void Finalize();
+  bool IsFinalized() const { return finalized_; }
 
   // Graph properties
-  size_t GetNodeCount() const { return nodes_.size(); }
+  size_t GetNodeCount() const { return finalized_ ? packedNodes_.size() : nodes_.size(); }
+  size_t GetEdgeCount() const;
+  // Approximate heap and inline bytes held by the graph, caches included
+  size_t GetMemoryUsage() const;
   Node* GetStartNode() const { return startNode_; }
-  void SetStartNode(Node* node) { startNode_ = node; }
+  void SetStartNode(Node* node);
+
+  // Index-based access (valid in both storage modes)
+  Node* GetNode(NodeIndex index) {
+    return finalized_ ? &packedNodes_[index] : nodes_[index].get();
+  }
+  const Node* GetNode(NodeIndex index) const {
+    return finalized_ ? &packedNodes_[index] : nodes_[index].get();
+  }
+
+  // CSR adjacency (empty until finalized): successors of node i are
+  // GetEdgeTargets()[GetEdgeOffsets()[i] .. GetEdgeOffsets()[i + 1])
+  std::span<const NodeIndex> GetEdgeOffsets() const { return edgeOffsets_; }
+  std::span<const NodeIndex> GetEdgeTargets() const { return edgeTargets_; }
 
   // Graph traversal
   std::vector<Node*> GetAllNodes();
   std::vector<const Node*> GetAllNodes() const;
 
+  // True if node is stored in this graph (not merely pointing at it)
+  bool Contains(const Node* node) const;
+
+  /**
+   * Path analysis from the start node
+   *
+   * Distances, in edges, are computed for every node by one dynamic
+   * programming pass in topological order (O(V+E)) and cached until the
+   * next AddRoom, Connect or SetStartNode. Only nodes reachable from start
+   * take part, so cycles elsewhere are ignored. Edges added with
+   * Node::AddConnection directly bypass the graph and do not invalidate the
+   * cache.
+   *
+   * The first query fills the cache even though it is const, so concurrent
+   * queries are only safe once it is filled: call PrecomputePaths() (or
+   * any query) before sharing a finalized graph between threads.
+   */
+  enum class DepthMetric { Shortest, Longest };
+  static constexpr int UNREACHABLE = -1;
+
+  // Distance of each node by index (UNREACHABLE if not reachable from start)
+  // @throws std::logic_error if there is no start node or the graph has a cycle
+  std::span<const int> GetDistances(DepthMetric metric) const;
+
+  // Longest start-to-boss path as node indices, start first; the boss is
+  // the reachable Boss room farthest from start, ties go to lower indices
+  // (empty if no boss is reachable)
+  // @throws std::logic_error if there is no start node or the graph has a cycle
+  std::span<const NodeIndex> GetCriticalPath() const;
+
+  // Fills the path cache now; false without a start node or on a cycle
+  bool PrecomputePaths() const;
+
+  // Writes GetDistances(metric) into every node's depth
+  void AssignDepths(DepthMetric metric = DepthMetric::Longest);
+  // Flags exactly the nodes of GetCriticalPath() as on the critical path
+  void MarkCriticalPath();
+
+  /**
+   * Installs the observer notified by AddRoom, Connect and SetStartNode
+   * (nullptr detaches)
+   */
+  void SetMutationObserver(MutationObserver* observer) { observer_ = observer; }
+  MutationObserver* GetMutationObserver() const { return observer_; }
+
  private:
-  std::vector<std::unique_ptr<Node>> nodes_;
+  void ThrowIfFinalized() const;
+  Node* PushNode(std::unique_ptr<Node> node);
+
+  // Fills the path cache; false (cache untouched) without a start node or on a cycle
+  bool ComputePaths() const;
+  void EnsurePaths() const;
+  void InvalidatePaths() { pathsValid_ = false; }
+
+  std::vector<std::unique_ptr<Node>> nodes_;  // Building mode
+  std::vector<Node> packedNodes_;             // Finalized mode
+
+  std::vector<NodeIndex> edgeOffsets_;
+  std::vector<NodeIndex> edgeTargets_;
+  std::vector<Node*> edgeNodes_;  // Pointer mirror of edgeTargets_ backing Node::GetNextRooms
+
   Node* startNode_ = nullptr;
-};
\ No newline at end of file
+  MutationObserver* observer_ = nullptr;
+  bool finalized_ = false;
+
+  // Path cache: shortest distances in [0, V), longest in [V, 2V)
+  mutable std::vector<int> distances_;
+  mutable std::vector<NodeIndex> criticalPath_;
+  mutable bool pathsValid_ = false;
+};
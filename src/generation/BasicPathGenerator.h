@@ -0,0 +1,622 @@
+#pragma once
+#include <algorithm>
+#include <concepts>
+#include <cstdint>
+#include <optional>
+#include <random>
+#include <span>
+#include <stdexcept>
+#include <string>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+#include "core/RunGraph.h"
+#include "generation/GeneratorPolicies.h"
+#include "generation/PathGeneratorConfig.h"
+#include "generation/PlacementSolver.h"
+#include "generation/RoomTypeSampler.h"
+#include "generation/RunPredicate.h"
+#include "generation/RunStream.h"
+#include "util/GenerationStats.h"
+#include "util/WorkStealingPool.h"
+
+/**
+ * Helpers shared by every BasicPathGenerator instantiation
+ */
+namespace PathGeneration {
+// "room_<index + 1>", formatted without streams or heap
+RoomId MakeRoomId(int index);
+
+// Shop and fountain guarantees followed by the extra constraints
+PlacementSolver MakePlacementSolver(int guaranteedShops, int guaranteedFountains,
+                                    std::span<const PlacementConstraint> extra);
+
+// Start, boss and every miniBossInterval-th room are fixed by the layout
+constexpr bool IsStructuralDepth(int depth, int totalRooms, int miniBossInterval) {
+  return depth == 0 || depth == totalRooms - 1 ||
+         (miniBossInterval > 0 && depth % miniBossInterval == 0);
+}
+
+// The structural type at depth, or sampled for free depths
+constexpr Room::Type SelectRoomType(int depth, int totalRooms, int miniBossInterval,
+                                    Room::Type sampled) {
+  // Last room is always boss
+  if (depth == totalRooms - 1) {
+    return Room::Type::Boss;
+  }
+
+  // First room is always combat
+  if (depth == 0) {
+    return Room::Type::Combat;
+  }
+
+  // Place mini-boss at intervals
+  if (miniBossInterval > 0 && depth % miniBossInterval == 0) {
+    return Room::Type::MiniBoss;
+  }
+
+  // Weighted random selection for variety
+  return sampled;
+}
+
+// @throws std::invalid_argument if solver cannot place a run of minRooms
+//         rooms. Sampled types only widen the solver's choices and longer
+//         runs only add free depths, so that run decides for every seed
+void CheckPlacementFeasible(PlacementSolver& solver, int minRooms, int miniBossInterval);
+}  // namespace PathGeneration
+
+/**
+ * Generates critical paths and branhing structures for dungeon runs
+ *
+ * A run is a critical path of minRooms..maxRooms rooms from the start to
+ * the boss. Each critical room (with probability branchProbability) may
+ * open a side branch of 1..maxBranchLength rooms that merges back into the
+ * critical path right after the rooms it runs alongside, so every branch
+ * is an alternative route and never a dead end. Critical rooms take node
+ * indices 0..length-1 in order; branch rooms follow.
+ *
+ * Assembled from policies (see GeneratorPolicies.h): where the random
+ * words come from, how a word becomes a room type, and whether the config
+ * is a runtime value or a compile-time constant. PathGenerator is the
+ * fully runtime instantiation; StaticPathGenerator fixes everything at
+ * compile time so config branches, the mini-boss modulo and the alias
+ * table fold into the code. Instantiations given the same config and seed
+ * generate identical runs.
+ */
+template <typename RngPolicy, typename SamplerPolicy, typename ConfigPolicy>
+class BasicPathGenerator {
+ public:
+  using Config = PathGeneratorConfig;
+  using Stream = GeneratorStream;
+
+  static constexpr RoomTypeSampler::Weights DEFAULT_ROOM_TYPE_WEIGHTS =
+      PathGeneratorConfig::DEFAULT_ROOM_TYPE_WEIGHTS;
+
+  /**
+   * Draws sequentially from a caller-owned engine
+   */
+  explicit BasicPathGenerator(std::mt19937& rng)
+    requires std::constructible_from<RngPolicy, std::mt19937&>
+      : rng_(rng), sampler_(MakeSampler(config_.Get())), placement_(MakePlacementSolver()) {}
+
+  /**
+   * Draws from CounterRng streams keyed by seed, so each room's choices
+   * are independent of the others and runs reproduce bit-for-bit across
+   * compilers and standard libraries
+   */
+  explicit BasicPathGenerator(uint64_t seed)
+    requires std::constructible_from<RngPolicy, uint64_t>
+      : rng_(seed), sampler_(MakeSampler(config_.Get())), placement_(MakePlacementSolver()) {}
+
+  // Config
+  // @throws std::invalid_argument if minRooms < 1, minRooms > maxRooms, any
+  //         biome's weights give MiniBoss or Boss a non-zero weight, the
+  //         biome's room-type weights or placement constraints are invalid,
+  //         or a run of minRooms rooms cannot meet the placement rules
+  void SetConfig(const Config& config)
+    requires GeneratorPolicy::MutableConfig<ConfigPolicy>
+  {
+    if (config.minRooms < 1 || config.minRooms > config.maxRooms) {
+      throw std::invalid_argument("Run length needs 1 <= minRooms <= maxRooms");
+    }
+    for (const RoomTypeSampler::Weights& weights : config.roomTypeWeights) {
+      if (SamplesStructuralTypes(weights)) {
+        throw std::invalid_argument(
+            "MiniBoss and Boss rooms are placed structurally; their weights must be 0");
+      }
+    }
+    SamplerPolicy sampler = MakeSampler(config);
+    PlacementSolver placement = PathGeneration::MakePlacementSolver(
+        config.guaranteedShops, config.guaranteedFountains, config.GetPlacementConstraints());
+    PathGeneration::CheckPlacementFeasible(placement, config.minRooms, config.miniBossInterval);
+    placement_ = std::move(placement);
+    sampler_ = sampler;
+    config_.Set(config);
+  }
+  // A PathGeneratorConfig, or the StaticGeneratorConfig compiled in
+  decltype(auto) GetConfig() const { return config_.Get(); }
+
+  /**
+   * Attaches a stats record (nullptr detaches); each GeneratePath()
+   * overwrites it with that run's phase timings and counters
+   */
+  void SetStats(GenerationStats* stats) { stats_ = stats; }
+
+  /**
+   * Rekeys a counter-based generator, keeping its config and scratch
+   * buffers, so one generator can produce many seeds
+   * @throws std::logic_error if the generator draws from an engine
+   */
+  void SetSeed(uint64_t seed)
+    requires GeneratorPolicy::ReseedableRng<RngPolicy>
+  {
+    rng_.SetSeed(seed);
+  }
+
+  /**
+   * @throws std::runtime_error if the placement constraints cannot be met
+   *         for the drawn run length
+   */
+  RunGraph GeneratePath() { return *Generate(nullptr); }
+
+  /**
+   * Generates the same run as GeneratePath(), checking predicate after the
+   * length is drawn, after the critical room types are final and once the
+   * graph is finalized. Stops at the first stage that rejects, before the
+   * graph is built when possible.
+   * @return The run, or nullopt if predicate rejects it
+   * @throws std::runtime_error as GeneratePath()
+   */
+  std::optional<RunGraph> GeneratePathIf(const RunPredicate& predicate) {
+    return Generate(&predicate);
+  }
+
+  /**
+   * Streams the run GeneratePath() would return, room by room in depth
+   * order: each critical room, then its incoming edges, then the branch
+   * rooms at that depth. The start room is yielded right after the length
+   * draw; room types and the branch plan are then decided in one linear
+   * pass without building anything, and the graph grows as events are
+   * consumed. Critical rooms enter the graph as they stream and branch
+   * rooms are appended once the boss is reached, so TakeGraph() returns
+   * exactly GeneratePath()'s graph (indices, ids and edge order included).
+   *
+   * The generator must outlive the stream and must not generate anything
+   * else until the stream completes. Build time is not recorded in stats,
+   * since most of it is spent suspended.
+   * @throws std::runtime_error from Next(), as GeneratePath()
+   */
+  RunStream GenerateStream();
+
+  /**
+   * Generates one run per seed across a work-stealing thread pool
+   *
+   * Each worker reuses one counter-based generator, rekeyed with SetSeed,
+   * so results[i] is identical to BasicPathGenerator(seeds[i]).GeneratePath()
+   * (and to SeedSearch and RunCache for that seed), whatever the thread count.
+   * @param threadCount Worker threads including the caller (0 = hardware concurrency)
+   * @param stats Empty, or one record per seed to fill
+   * @throws std::invalid_argument if config is invalid, or stats is
+   *         non-empty and not seeds.size() long
+   */
+  static std::vector<RunGraph> GenerateBatch(std::span<const uint64_t> seeds, const Config& config,
+                                             unsigned threadCount = 0,
+                                             std::span<GenerationStats> stats = {})
+    requires std::constructible_from<RngPolicy, uint64_t> &&
+             GeneratorPolicy::ReseedableRng<RngPolicy> &&
+             GeneratorPolicy::MutableConfig<ConfigPolicy>;
+
+ private:
+  RngPolicy rng_;
+  ConfigPolicy config_;
+  SamplerPolicy sampler_;  // Compiled from the configured biome's weights
+  PlacementSolver placement_;
+  GenerationStats* stats_ = nullptr;
+  uint64_t draws_ = 0;  // RNG words consumed by the current run
+
+  // Per-run scratch for critical room types and the branch plan
+  std::vector<uint32_t> typeWords_;
+  std::vector<Room::Type> roomTypes_;
+  std::vector<uint8_t> lockedTypes_;  // Structural rooms the solver must keep
+  std::vector<int> branchLengths_;  // Per critical room, 0 = no branch
+  std::vector<Room::Type> branchTypes_;  // Branch rooms in node order
+
+  template <typename Settings>
+  static SamplerPolicy MakeSampler(const Settings& config) {
+    if constexpr (std::is_default_constructible_v<SamplerPolicy>) {
+      return SamplerPolicy{};
+    } else {
+      return SamplerPolicy(config.GetBiomeWeights());
+    }
+  }
+  // Checks a compiled-in config here; the runtime default is feasible and
+  // SetConfig() checks its replacements
+  PlacementSolver MakePlacementSolver() const {
+    const auto& config = config_.Get();
+    PlacementSolver placement = PathGeneration::MakePlacementSolver(
+        config.guaranteedShops, config.guaranteedFountains, config.GetPlacementConstraints());
+    if constexpr (!GeneratorPolicy::MutableConfig<ConfigPolicy>) {
+      PathGeneration::CheckPlacementFeasible(placement, config.minRooms, config.miniBossInterval);
+    }
+    return placement;
+  }
+
+  // Shared by GeneratePath() (null predicate) and GeneratePathIf()
+  std::optional<RunGraph> Generate(const RunPredicate* predicate);
+  // Resets the attached stats; returns the allocation counter to diff against
+  uint64_t BeginRunStats();
+  void RecordRunStats(const RunGraph& graph, uint64_t allocationsBefore);
+
+  // Uniform integer in [min, max] for the given room and stream
+  int RandomInt(int min, int max, int room, Stream stream);
+  // Samples a type for every critical room from one block of random words,
+  // places structural rooms and enforces the placement constraints
+  void SelectRoomTypes(int totalRooms);
+  bool IsStructuralDepth(int depth, int totalRooms) const;
+  // Decides every branch and then every branch room's type up front;
+  // returns the number of branch rooms
+  int PlanBranches(int totalRooms);
+  RunGraph::Node* AddCriticalRoom(RunGraph& graph, int depth, RunGraph::Node* previousNode);
+  // Adds a branch whose rooms take branchTypes_[firstType...]
+  void AddBranch(RunGraph& graph, int from, int length, size_t firstType);
+  Room::Type SelectRoomType(int depth, int totalRooms, Room::Type sampled) const;
+};
+
+template <typename RngPolicy, typename SamplerPolicy, typename ConfigPolicy>
+std::optional<RunGraph> BasicPathGenerator<RngPolicy, SamplerPolicy, ConfigPolicy>::Generate(
+    const RunPredicate* predicate) {
+  using Phase = GenerationStats::Phase;
+  using Verdict = RunPredicate::Verdict;
+  const auto& config = config_.Get();
+  const uint64_t allocationsBefore = BeginRunStats();
+  RunGraph graph;
+
+  // Determine path length
+  int totalRooms = 0;
+  {
+    Stats::PhaseTimer timer(stats_, Phase::RoomTypes);
+    totalRooms = RandomInt(config.minRooms, config.maxRooms, 0, Stream::Length);
+  }
+
+  // Each stage narrows the run; stop at the first rejection
+  RunPredicate::View view;
+  view.criticalLength = totalRooms;
+  Verdict verdict = predicate ? predicate->Evaluate(view) : Verdict::Accept;
+  if (verdict == Verdict::Reject) {
+    RecordRunStats(graph, allocationsBefore);
+    return std::nullopt;
+  }
+
+  SelectRoomTypes(totalRooms);
+
+  if (verdict == Verdict::Pending) {
+    view.stage = RunPredicate::Stage::RoomTypes;
+    view.criticalTypes = roomTypes_;
+    verdict = predicate->Evaluate(view);
+    if (verdict == Verdict::Reject) {
+      RecordRunStats(graph, allocationsBefore);
+      return std::nullopt;
+    }
+  }
+
+  // Plan branches first so nodes and edges are reserved exactly
+  int branchRooms = 0;
+  int branchCount = 0;
+  {
+    Stats::PhaseTimer timer(stats_, Phase::BranchPlan);
+    branchRooms = PlanBranches(totalRooms);
+    branchCount = static_cast<int>(std::count_if(branchLengths_.begin(), branchLengths_.end(),
+                                                 [](int length) { return length > 0; }));
+  }
+
+  {
+    Stats::PhaseTimer timer(stats_, Phase::Build);
+    graph.Reserve(static_cast<size_t>(totalRooms + branchRooms),
+                  static_cast<size_t>(std::max(totalRooms - 1, 0) + branchRooms + branchCount));
+
+    RunGraph::Node* previousNode = nullptr;
+    for (int i = 0; i < totalRooms; ++i) {
+      previousNode = AddCriticalRoom(graph, i, previousNode);
+    }
+
+    size_t firstType = 0;
+    for (int i = 0; i < totalRooms; ++i) {
+      if (branchLengths_[i] > 0) {
+        AddBranch(graph, i, branchLengths_[i], firstType);
+        firstType += static_cast<size_t>(branchLengths_[i]);
+      }
+    }
+  }
+
+  {
+    Stats::PhaseTimer timer(stats_, Phase::Finalize);
+    graph.Finalize();
+  }
+
+  RecordRunStats(graph, allocationsBefore);
+  if (verdict == Verdict::Pending) {
+    view.stage = RunPredicate::Stage::Complete;
+    view.graph = &graph;
+    if (predicate->Evaluate(view) != Verdict::Accept) return std::nullopt;
+  }
+  return graph;
+}
+
+template <typename RngPolicy, typename SamplerPolicy, typename ConfigPolicy>
+RunStream BasicPathGenerator<RngPolicy, SamplerPolicy, ConfigPolicy>::GenerateStream() {
+  using Phase = GenerationStats::Phase;
+  const auto& config = config_.Get();
+  const uint64_t allocationsBefore = BeginRunStats();
+
+  int totalRooms = 0;
+  {
+    Stats::PhaseTimer timer(stats_, Phase::RoomTypes);
+    totalRooms = RandomInt(config.minRooms, config.maxRooms, 0, Stream::Length);
+  }
+
+  // The start room is structural, so it is known before any other choice
+  co_yield RunEvent{.index = 0,
+                    .type = SelectRoomType(0, totalRooms, Room::Type::Combat),
+                    .onCriticalPath = true};
+
+  SelectRoomTypes(totalRooms);
+  int branchRooms = 0;
+  int branchCount = 0;
+  {
+    Stats::PhaseTimer timer(stats_, Phase::BranchPlan);
+    branchRooms = PlanBranches(totalRooms);
+    branchCount = static_cast<int>(std::count_if(branchLengths_.begin(), branchLengths_.end(),
+                                                 [](int length) { return length > 0; }));
+  }
+
+  RunGraph graph;
+  graph.Reserve(static_cast<size_t>(totalRooms + branchRooms),
+                static_cast<size_t>(std::max(totalRooms - 1, 0) + branchRooms + branchCount));
+
+  // Branch rooms follow the critical path in node order; firstBranchIndex[i]
+  // is the node index of the first room of the branch leaving room i
+  std::vector<RunGraph::NodeIndex> firstBranchIndex(static_cast<size_t>(totalRooms));
+  auto nextBranchIndex = static_cast<RunGraph::NodeIndex>(totalRooms);
+  for (int i = 0; i < totalRooms; ++i) {
+    firstBranchIndex[i] = nextBranchIndex;
+    nextBranchIndex += static_cast<RunGraph::NodeIndex>(branchLengths_[i]);
+  }
+  const int longestBranch = std::max(config.maxBranchLength, 0);
+
+  RunGraph::Node* previousNode = nullptr;
+  for (int depth = 0; depth < totalRooms; ++depth) {
+    const auto index = static_cast<RunGraph::NodeIndex>(depth);
+    previousNode = AddCriticalRoom(graph, depth, previousNode);
+    if (depth == 0) continue;
+    co_yield RunEvent{
+        .index = index, .type = roomTypes_[depth], .depth = depth, .onCriticalPath = true};
+    co_yield RunEvent{.kind = RunEvent::Kind::Edge, .index = index - 1, .target = index};
+
+    // Branch rooms at this depth belong to the branches that left from the
+    // previous longestBranch critical rooms; branches one step longer merge here
+    const int firstFrom = std::max(depth - longestBranch - 1, 0);
+    for (int from = firstFrom; from < depth; ++from) {
+      const int length = branchLengths_[from];
+      if (length > 0 && depth - from == length + 1) {
+        co_yield RunEvent{.kind = RunEvent::Kind::Edge,
+                          .index = firstBranchIndex[from] + length - 1,
+                          .target = index};
+      }
+    }
+    for (int from = firstFrom; from < depth; ++from) {
+      const int step = depth - from;
+      if (step > branchLengths_[from]) continue;
+
+      const RunGraph::NodeIndex room = firstBranchIndex[from] + step - 1;
+      co_yield RunEvent{
+          .index = room, .type = branchTypes_[room - totalRooms], .depth = depth};
+      co_yield RunEvent{.kind = RunEvent::Kind::Edge,
+                        .index = step == 1 ? index - 1 : room - 1,
+                        .target = room};
+    }
+  }
+
+  size_t firstType = 0;
+  for (int i = 0; i < totalRooms; ++i) {
+    if (branchLengths_[i] > 0) {
+      AddBranch(graph, i, branchLengths_[i], firstType);
+      firstType += static_cast<size_t>(branchLengths_[i]);
+    }
+  }
+
+  {
+    Stats::PhaseTimer timer(stats_, Phase::Finalize);
+    graph.Finalize();
+  }
+  RecordRunStats(graph, allocationsBefore);
+  co_return std::move(graph);
+}
+
+template <typename RngPolicy, typename SamplerPolicy, typename ConfigPolicy>
+uint64_t BasicPathGenerator<RngPolicy, SamplerPolicy, ConfigPolicy>::BeginRunStats() {
+  draws_ = 0;
+  if constexpr (Stats::ENABLED) {
+    if (stats_) {
+      *stats_ = GenerationStats{};
+      return Stats::ReadAllocationCounter();
+    }
+  }
+  return 0;
+}
+
+template <typename RngPolicy, typename SamplerPolicy, typename ConfigPolicy>
+void BasicPathGenerator<RngPolicy, SamplerPolicy, ConfigPolicy>::RecordRunStats(
+    const RunGraph& graph, uint64_t allocationsBefore) {
+  if constexpr (Stats::ENABLED) {
+    Stats::Add(stats_, &GenerationStats::roomsCreated, graph.GetNodeCount());
+    Stats::Add(stats_, &GenerationStats::edgesCreated, graph.GetEdgeCount());
+    Stats::Add(stats_, &GenerationStats::rngDraws, draws_);
+    Stats::Add(stats_, &GenerationStats::allocations,
+               Stats::ReadAllocationCounter() - allocationsBefore);
+  }
+}
+
+template <typename RngPolicy, typename SamplerPolicy, typename ConfigPolicy>
+int BasicPathGenerator<RngPolicy, SamplerPolicy, ConfigPolicy>::PlanBranches(int totalRooms) {
+  const auto& config = config_.Get();
+  branchLengths_.assign(static_cast<size_t>(std::max(totalRooms, 0)), 0);
+  if (config.branchProbability <= 0.0f || config.maxBranchLength <= 0) {
+    return 0;  // Linear runs draw nothing extra
+  }
+
+  int branchRooms = 0;
+  for (int i = 0; i < totalRooms; ++i) {
+    // A branch of length k from room i rejoins at room i + k + 1
+    const int longest = std::min(config.maxBranchLength, totalRooms - 2 - i);
+    if (longest < 1) break;
+
+    int length = 0;
+    rng_.Draw(static_cast<uint32_t>(i), Stream::Branch, draws_, [&](auto& engine) {
+      if (PortableRandom::UniformFloat(engine) < config.branchProbability) {
+        length = PortableRandom::UniformInt(engine, 1, longest);
+      }
+    });
+
+    branchLengths_[i] = length;
+    branchRooms += length;
+  }
+
+  // Branch room types come after every decision, in node order
+  branchTypes_.resize(static_cast<size_t>(branchRooms));
+  size_t next = 0;
+  for (int i = 0; i < totalRooms; ++i) {
+    const auto length = static_cast<size_t>(branchLengths_[i]);
+    if (length == 0) continue;
+    rng_.Draw(static_cast<uint32_t>(i), Stream::BranchRoomType, draws_, [&](auto& engine) {
+      for (size_t step = 0; step < length; ++step) branchTypes_[next++] = sampler_.Sample(engine);
+    });
+  }
+  return branchRooms;
+}
+
+template <typename RngPolicy, typename SamplerPolicy, typename ConfigPolicy>
+RunGraph::Node* BasicPathGenerator<RngPolicy, SamplerPolicy, ConfigPolicy>::AddCriticalRoom(
+    RunGraph& graph, int depth, RunGraph::Node* previousNode) {
+  auto* node = graph.AddRoom(PathGeneration::MakeRoomId(depth), roomTypes_[depth]);
+  node->GetRoom()->SetBiome(config_.Get().biome);
+  node->SetDepth(depth);
+  node->SetOnCriticalPath(true);
+
+  if (depth == 0) {
+    graph.SetStartNode(node);
+  }
+  if (previousNode) {
+    graph.Connect(previousNode, node);
+  }
+  return node;
+}
+
+template <typename RngPolicy, typename SamplerPolicy, typename ConfigPolicy>
+void BasicPathGenerator<RngPolicy, SamplerPolicy, ConfigPolicy>::AddBranch(RunGraph& graph,
+                                                                           int from, int length,
+                                                                           size_t firstType) {
+  RunGraph::Node* previousNode = graph.GetNode(static_cast<RunGraph::NodeIndex>(from));
+  for (int step = 1; step <= length; ++step) {
+    const Room::Type roomType = branchTypes_[firstType + static_cast<size_t>(step - 1)];
+
+    const auto index = static_cast<int>(graph.GetNodeCount());
+    auto* node = graph.AddRoom(PathGeneration::MakeRoomId(index), roomType);
+    node->GetRoom()->SetBiome(config_.Get().biome);
+    node->SetDepth(from + step);
+
+    graph.Connect(previousNode, node);
+    previousNode = node;
+  }
+
+  // Merge back into the critical path after the rooms the branch bypasses
+  graph.Connect(previousNode, graph.GetNode(static_cast<RunGraph::NodeIndex>(from + length + 1)));
+}
+
+template <typename RngPolicy, typename SamplerPolicy, typename ConfigPolicy>
+std::vector<RunGraph> BasicPathGenerator<RngPolicy, SamplerPolicy, ConfigPolicy>::GenerateBatch(
+    std::span<const uint64_t> seeds, const Config& config, unsigned threadCount,
+    std::span<GenerationStats> stats)
+  requires std::constructible_from<RngPolicy, uint64_t> &&
+           GeneratorPolicy::ReseedableRng<RngPolicy> &&
+           GeneratorPolicy::MutableConfig<ConfigPolicy>
+{
+  if (!stats.empty() && stats.size() != seeds.size()) {
+    throw std::invalid_argument("Stats span must be empty or match the seed count");
+  }
+  std::vector<RunGraph> results(seeds.size());
+
+  // Configured once on the calling thread, then copied to every worker
+  BasicPathGenerator prototype(uint64_t{0});
+  prototype.SetConfig(config);
+
+  WorkStealingPool pool(threadCount);
+  std::vector<BasicPathGenerator> generators(pool.GetThreadCount(), prototype);
+  pool.ParallelFor(seeds.size(), [&](size_t index, unsigned worker) {
+    BasicPathGenerator& generator = generators[worker];
+    generator.SetSeed(seeds[index]);
+    generator.SetStats(stats.empty() ? nullptr : &stats[index]);
+    results[index] = generator.GeneratePath();
+  });
+
+  return results;
+}
+
+template <typename RngPolicy, typename SamplerPolicy, typename ConfigPolicy>
+int BasicPathGenerator<RngPolicy, SamplerPolicy, ConfigPolicy>::RandomInt(int min, int max,
+                                                                          int room, Stream stream) {
+  int value = 0;
+  rng_.Draw(static_cast<uint32_t>(room), stream, draws_,
+            [&](auto& engine) { value = PortableRandom::UniformInt(engine, min, max); });
+  return value;
+}
+
+template <typename RngPolicy, typename SamplerPolicy, typename ConfigPolicy>
+void BasicPathGenerator<RngPolicy, SamplerPolicy, ConfigPolicy>::SelectRoomTypes(int totalRooms) {
+  const size_t count = static_cast<size_t>(totalRooms);
+  typeWords_.resize(count);
+  roomTypes_.resize(count);
+  lockedTypes_.resize(count);
+
+  {
+    Stats::PhaseTimer timer(stats_, GenerationStats::Phase::RoomTypes);
+
+    // Every room gets a word, even those placed structurally, so room i
+    // always uses word i
+    rng_.Draw(0, Stream::RoomType, draws_, [&](auto& engine) {
+      for (uint32_t& word : typeWords_) word = static_cast<uint32_t>(engine());
+    });
+    sampler_.SampleBulk(typeWords_, roomTypes_);
+
+    for (int i = 0; i < totalRooms; ++i) {
+      roomTypes_[i] = SelectRoomType(i, totalRooms, roomTypes_[i]);
+      lockedTypes_[i] = IsStructuralDepth(i, totalRooms);
+    }
+  }
+
+  // Enforce guarantees and placement rules without re-rolling the run
+  Stats::PhaseTimer timer(stats_, GenerationStats::Phase::Placement);
+  const PlacementSolver::Result result = placement_.Solve(roomTypes_, lockedTypes_);
+  Stats::Add(stats_, &GenerationStats::backtracks, result.backtracks);
+  if (!result.IsSatisfied()) {
+    throw std::runtime_error(
+        std::string("Cannot satisfy placement constraints for ") +
+        Room::TypeToString(result.conflictingType) + " rooms in a run of " +
+        std::to_string(totalRooms) + " rooms" +
+        (result.status == PlacementSolver::Status::BudgetExhausted ? " (backtrack budget exhausted)"
+                                                                   : ""));
+  }
+}
+
+template <typename RngPolicy, typename SamplerPolicy, typename ConfigPolicy>
+bool BasicPathGenerator<RngPolicy, SamplerPolicy, ConfigPolicy>::IsStructuralDepth(
+    int depth, int totalRooms) const {
+  return PathGeneration::IsStructuralDepth(depth, totalRooms, config_.Get().miniBossInterval);
+}
+
+template <typename RngPolicy, typename SamplerPolicy, typename ConfigPolicy>
+Room::Type BasicPathGenerator<RngPolicy, SamplerPolicy, ConfigPolicy>::SelectRoomType(
+    int depth, int totalRooms, Room::Type sampled) const {
+  return PathGeneration::SelectRoomType(depth, totalRooms, config_.Get().miniBossInterval,
+                                        sampled);
+}
@@ -0,0 +1,175 @@
+#pragma once
+#include <concepts>
+#include <cstdint>
+#include <random>
+#include <span>
+#include <stdexcept>
+
+#include "generation/PathGeneratorConfig.h"
+#include "generation/RoomTypeSampler.h"
+#include "util/CounterRng.h"
+#include "util/GenerationStats.h"
+
+/**
+ * Policies BasicPathGenerator is assembled from
+ *
+ * RNG policy: Draw(room, stream, draws, body) calls body(engine) once with
+ *   a UniformRandomBitGenerator for that room's stream, then adds the words
+ *   consumed to draws (only when stats are enabled).
+ * Sampler policy: Sample(engine) and SampleBulk(words, out) over room
+ *   types. Built from the config's biome weights unless it is default
+ *   constructible, in which case its weights are its own.
+ * Config policy: Get() returns what generation reads, a PathGeneratorConfig
+ *   or a StaticGeneratorConfig; a Set(config) member makes it mutable.
+ */
+namespace GeneratorPolicy {
+/**
+ * Sequential engine view that tallies draws for stats
+ */
+struct CountingEngine {
+  using result_type = std::mt19937::result_type;
+  static constexpr result_type min() { return std::mt19937::min(); }
+  static constexpr result_type max() { return std::mt19937::max(); }
+
+  result_type operator()() {
+    if constexpr (Stats::ENABLED) ++*draws;
+    return (*engine)();
+  }
+
+  std::mt19937* engine;
+  uint64_t* draws;
+};
+
+/**
+ * Draws sequentially from a caller-owned engine; room and stream are ignored
+ */
+class SequentialRng {
+ public:
+  explicit SequentialRng(std::mt19937& engine) : engine_(&engine) {}
+
+  template <typename Body>
+  void Draw(uint32_t, GeneratorStream, uint64_t& draws, Body&& body) {
+    CountingEngine engine{engine_, &draws};
+    body(engine);
+  }
+
+ private:
+  std::mt19937* engine_;
+};
+
+/**
+ * Draws from a CounterRng keyed by (seed, room, stream)
+ */
+class CounterBasedRng {
+ public:
+  explicit CounterBasedRng(uint64_t seed) : seed_(seed) {}
+
+  void SetSeed(uint64_t seed) { seed_ = seed; }
+
+  template <typename Body>
+  void Draw(uint32_t room, GeneratorStream stream, uint64_t& draws, Body&& body) {
+    CounterRng rng(seed_, room, static_cast<uint32_t>(stream));
+    body(rng);
+    if constexpr (Stats::ENABLED) draws += rng.GetPosition();
+  }
+
+ private:
+  uint64_t seed_;
+};
+
+/**
+ * SequentialRng or CounterBasedRng, chosen by the constructor
+ */
+class SelectableRng {
+ public:
+  explicit SelectableRng(std::mt19937& engine) : engine_(&engine) {}
+  explicit SelectableRng(uint64_t seed) : seed_(seed) {}
+
+  // @throws std::logic_error if drawing from an engine
+  void SetSeed(uint64_t seed) {
+    if (engine_) {
+      throw std::logic_error("SetSeed requires a counter-based generator");
+    }
+    seed_ = seed;
+  }
+
+  template <typename Body>
+  void Draw(uint32_t room, GeneratorStream stream, uint64_t& draws, Body&& body) {
+    if (engine_) {
+      CountingEngine engine{engine_, &draws};
+      body(engine);
+    } else {
+      CounterRng rng(seed_, room, static_cast<uint32_t>(stream));
+      body(rng);
+      if constexpr (Stats::ENABLED) draws += rng.GetPosition();
+    }
+  }
+
+ private:
+  std::mt19937* engine_ = nullptr;  // Null when counter-based
+  uint64_t seed_ = 0;
+};
+
+/**
+ * Alias table for fixed weights, built at compile time
+ *
+ * Samples exactly as a RoomTypeSampler built from WEIGHTS; invalid weights
+ * fail to compile.
+ */
+template <RoomTypeSampler::Weights WEIGHTS>
+class FixedSampler {
+ public:
+  constexpr Room::Type Sample(uint32_t word) const { return TABLE.Sample(word); }
+
+  template <typename Engine>
+  Room::Type Sample(Engine& engine) const {
+    return TABLE.Sample(static_cast<uint32_t>(engine()));
+  }
+
+  // Inline, unlike RoomTypeSampler::SampleBulk, so the table folds into the loop
+  void SampleBulk(std::span<const uint32_t> words, std::span<Room::Type> out) const {
+    if (out.size() < words.size()) {
+      throw std::invalid_argument("Output span is shorter than the input words");
+    }
+    for (size_t i = 0; i < words.size(); ++i) {
+      out[i] = TABLE.Sample(words[i]);
+    }
+  }
+
+ private:
+  static constexpr RoomTypeSampler TABLE{WEIGHTS};
+};
+
+/**
+ * Config chosen at run time and replaceable with SetConfig()
+ */
+class RuntimeConfig {
+ public:
+  const PathGeneratorConfig& Get() const { return config_; }
+  void Set(const PathGeneratorConfig& config) { config_ = config; }
+
+ private:
+  PathGeneratorConfig config_;
+};
+
+/**
+ * Config fixed at compile time, so its fields fold into the generated code
+ */
+template <StaticGeneratorConfig CONFIG>
+struct StaticConfig {
+  static_assert(CONFIG.minRooms >= 1, "runs need at least one room");
+  static_assert(CONFIG.minRooms <= CONFIG.maxRooms, "minRooms must not exceed maxRooms");
+  static_assert(!SamplesStructuralTypes(CONFIG.roomTypeWeights),
+                "MiniBoss and Boss rooms are placed structurally; their weights must be 0");
+
+  static constexpr const StaticGeneratorConfig& Get() { return CONFIG; }
+};
+
+template <typename Policy>
+concept ReseedableRng = requires(Policy& policy, uint64_t seed) { policy.SetSeed(seed); };
+
+template <typename Policy>
+concept MutableConfig = requires(Policy& policy, const PathGeneratorConfig& config) {
+  policy.Set(config);
+};
+}  // namespace GeneratorPolicy
@@ -1,77 +1,49 @@
 #include "generation/PathGenerator.h"
 
-#include <sstream>
-
-PathGenerator::PathGenerator(std::mt19937& rng) : rng_(rng) {}
-
-RunGraph PathGenerator::GeneratePath() {
-  RunGraph graph;
-
-  // Determine path length
-  std::uniform_int_distribution<int> lengthDist(config_.minRooms, config_.maxRooms);
-  int totalRooms = lengthDist(rng_);
-
-  RunGraph::Node* previousNode = nullptr;
-
-  for (int i = 0; i < totalRooms; ++i) {
-    // Select room type
-    Room::Type roomType = SelectRoomType(i, totalRooms);
-
-    // Create room
-    auto* node = graph.AddRoom(GenerateRoomId(i), roomType);
-    node->SetDepth(i);
-
-    // Set start node
-    if (i == 0) {
-      graph.SetStartNode(node);
-    }
-
-    // Connect to previous node
-    if (previousNode) {
-      graph.Connect(previousNode, node);
-    }
-
-    previousNode = node;
-  }
-
-  return graph;
+#include <charconv>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+#include <vector>
+
+template class BasicPathGenerator<GeneratorPolicy::SelectableRng, RoomTypeSampler,
+                                  GeneratorPolicy::RuntimeConfig>;
+
+namespace PathGeneration {
+RoomId MakeRoomId(int index) {
+  // "room_<index + 1>" formatted in place, no streams or heap
+  constexpr std::string_view prefix = "room_";
+  char buffer[RoomId::MAX_LENGTH];
+  std::memcpy(buffer, prefix.data(), prefix.size());
+  const auto result = std::to_chars(buffer + prefix.size(), buffer + sizeof(buffer), index + 1);
+  return RoomId(std::string_view(buffer, static_cast<size_t>(result.ptr - buffer)));
 }
 
-Room::Type PathGenerator::SelectRoomType(int depth, int totalRooms) {
-  // Last room is always boss
-  if (depth == totalRooms - 1) {
-    return Room::Type::Boss;
-  }
-
-  // First room is always combat
-  if (depth == 0) {
-    return Room::Type::Combat;
-  }
+PlacementSolver MakePlacementSolver(int guaranteedShops, int guaranteedFountains,
+                                    std::span<const PlacementConstraint> extra) {
+  std::vector<PlacementConstraint> constraints = {
+      {.type = Room::Type::Shop, .minCount = guaranteedShops, .minSpacing = 2},
+      {.type = Room::Type::Fountain, .minCount = guaranteedFountains},
+  };
+  constraints.insert(constraints.end(), extra.begin(), extra.end());
+  return PlacementSolver(constraints);
+}
 
-  // Place mini-boss at intervals
-  if (config_.miniBossInterval > 0 && depth > 0 && depth % config_.miniBossInterval == 0) {
-    return Room::Type::MiniBoss;
+void CheckPlacementFeasible(PlacementSolver& solver, int minRooms, int miniBossInterval) {
+  // Every free depth samples Combat, the fallback the solver always has
+  std::vector<Room::Type> types(static_cast<size_t>(minRooms));
+  std::vector<uint8_t> locked(types.size());
+  for (int i = 0; i < minRooms; ++i) {
+    types[i] = SelectRoomType(i, minRooms, miniBossInterval, Room::Type::Combat);
+    locked[i] = IsStructuralDepth(i, minRooms, miniBossInterval);
   }
 
-  // Weighted random selection for variety
-  std::uniform_int_distribution<int> typeDist(0, 100);
-  int roll = typeDist(rng_);
-
-  if (roll < 60) {
-    return Room::Type::Combat;  // 60% combat
-  } else if (roll < 75) {
-    return Room::Type::Elite;  // 15% elite
-  } else if (roll < 85) {
-    return Room::Type::Treasure;  // 10% treasure
-  } else if (roll < 92) {
-    return Room::Type::Shop;  // 7% shop
-  } else {
-    return Room::Type::Fountain;  // 8 % fountain
+  const PlacementSolver::Result result = solver.Solve(types, locked);
+  if (result.status == PlacementSolver::Status::Unsatisfiable) {
+    throw std::invalid_argument(std::string("Cannot satisfy placement constraints for ") +
+                                Room::TypeToString(result.conflictingType) + " rooms in a run of " +
+                                std::to_string(minRooms) + " rooms");
   }
 }
-
-std::string PathGenerator::GenerateRoomId(int index) {
-  std::ostringstream oss;
-  oss << "room_" << (index + 1);
-  return oss.str();
-}
\ No newline at end of file
+}  // namespace PathGeneration
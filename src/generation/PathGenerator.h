@@ -1,36 +1,30 @@
 #pragma once
-#include <random>
+#include <cstdint>
 
-#include "core/RunGraph.h"
+#include "generation/BasicPathGenerator.h"
+#include "generation/GeneratorPolicies.h"
+#include "generation/RoomTypeSampler.h"
 
 /**
- * Generates critical paths and branhing structures for dungeon runs
+ * The runtime-configurable generator: an engine or a counter-based seed
+ * chosen at construction, an alias table compiled from the configured
+ * weights and a config replaceable with SetConfig()
  */
+using PathGenerator = BasicPathGenerator<GeneratorPolicy::SelectableRng, RoomTypeSampler,
+                                         GeneratorPolicy::RuntimeConfig>;
 
-class PathGenerator {
- public:
-  /**
-   * Configuration for path generation
-   */
-  struct Config {
-    int minRooms = 40;
-    int maxRooms = 50;
-    float branchProbability = 0.3f;
-    int miniBossInterval = 10;
-    int guaranteedShops = 2;
-    int guaranteedFountains = 3;
-  };
+// Compiled once, in PathGenerator.cpp
+extern template class BasicPathGenerator<GeneratorPolicy::SelectableRng, RoomTypeSampler,
+                                         GeneratorPolicy::RuntimeConfig>;
 
-  explicit PathGenerator(std::mt19937& rng);
-
-  // Config
-  void SetConfig(const Config& config) { config_ = config; }
-  const Config& GetConfig() const { return config_; }
-  RunGraph GeneratePath();
-
- private:
-  std::mt19937& rng_;
-  Config config_;
-  Room::Type SelectRoomType(int depth, int totalRooms);
-  std::string GenerateRoomId(int index);
-};
\ No newline at end of file
+/**
+ * Counter-based generator specialized for a config known at compile time
+ *
+ * Generates exactly the runs of a PathGenerator(seed) configured with
+ * CONFIG.ToConfig().
+ */
+template <StaticGeneratorConfig CONFIG>
+using StaticPathGenerator =
+    BasicPathGenerator<GeneratorPolicy::CounterBasedRng,
+                       GeneratorPolicy::FixedSampler<CONFIG.roomTypeWeights>,
+                       GeneratorPolicy::StaticConfig<CONFIG>>;
@@ -0,0 +1,99 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "core/Biome.h"
+#include "generation/PlacementSolver.h"
+#include "generation/RoomTypeSampler.h"
+
+// True if weights could sample a MiniBoss or Boss room; those are only
+// placed structurally, so a sampled one would end routes mid-run
+constexpr bool SamplesStructuralTypes(const RoomTypeSampler::Weights& weights) {
+  return weights[static_cast<size_t>(Room::Type::MiniBoss)] != 0.0f ||
+         weights[static_cast<size_t>(Room::Type::Boss)] != 0.0f;
+}
+
+/**
+ * Configuration for path generation
+ */
+struct PathGeneratorConfig {
+  // 60% combat, 15% elite, 10% treasure, 7% shop, 8% fountain; mini-boss
+  // and boss rooms are placed structurally
+  static constexpr RoomTypeSampler::Weights DEFAULT_ROOM_TYPE_WEIGHTS = {
+      60.0f, 15.0f, 0.0f, 10.0f, 7.0f, 8.0f, 0.0f, 0.0f};
+
+  int minRooms = 40;  // Critical path length; branch rooms come on top
+  int maxRooms = 50;
+  float branchProbability = 0.3f;
+  int maxBranchLength = 2;
+  int miniBossInterval = 10;
+  // Minimum counts on the critical path; shops are also never adjacent
+  int guaranteedShops = 2;
+  int guaranteedFountains = 3;
+  // Extra depth-based rules, intersected with the guarantees above
+  std::vector<PlacementConstraint> placementConstraints;
+
+  // Biome of the generated run; selects the row of roomTypeWeights
+  Biome::Type biome = Biome::Type::Tartarus;
+  // Relative room-type weights per biome, indexed by Room::Type; MiniBoss
+  // and Boss must be 0
+  std::array<RoomTypeSampler::Weights, Biome::COUNT> roomTypeWeights = [] {
+    std::array<RoomTypeSampler::Weights, Biome::COUNT> weights;
+    weights.fill(DEFAULT_ROOM_TYPE_WEIGHTS);
+    return weights;
+  }();
+
+  const RoomTypeSampler::Weights& GetBiomeWeights() const {
+    return roomTypeWeights[static_cast<size_t>(biome)];
+  }
+  std::span<const PlacementConstraint> GetPlacementConstraints() const {
+    return placementConstraints;
+  }
+};
+
+/**
+ * Compile-time configuration, usable as a template argument
+ *
+ * Holds the scalar fields of PathGeneratorConfig and the one biome's
+ * weights; extra placement constraints need the runtime config.
+ */
+struct StaticGeneratorConfig {
+  int minRooms = 40;
+  int maxRooms = 50;
+  float branchProbability = 0.3f;
+  int maxBranchLength = 2;
+  int miniBossInterval = 10;
+  int guaranteedShops = 2;
+  int guaranteedFountains = 3;
+  Biome::Type biome = Biome::Type::Tartarus;
+  RoomTypeSampler::Weights roomTypeWeights = PathGeneratorConfig::DEFAULT_ROOM_TYPE_WEIGHTS;
+
+  constexpr const RoomTypeSampler::Weights& GetBiomeWeights() const { return roomTypeWeights; }
+  constexpr std::span<const PlacementConstraint> GetPlacementConstraints() const { return {}; }
+
+  // The equivalent runtime config: same fields, these weights for biome
+  PathGeneratorConfig ToConfig() const {
+    PathGeneratorConfig config;
+    config.minRooms = minRooms;
+    config.maxRooms = maxRooms;
+    config.branchProbability = branchProbability;
+    config.maxBranchLength = maxBranchLength;
+    config.miniBossInterval = miniBossInterval;
+    config.guaranteedShops = guaranteedShops;
+    config.guaranteedFountains = guaranteedFountains;
+    config.biome = biome;
+    config.roomTypeWeights[static_cast<size_t>(biome)] = roomTypeWeights;
+    return config;
+  }
+};
+
+/**
+ * Random streams consumed by generation. With a counter-based generator,
+ * Length is keyed by room index 0 and RoomType holds one word per
+ * critical room (word i belongs to room i); Branch and BranchRoomType are
+ * keyed by the critical room a branch leaves from. Any room can therefore
+ * be drawn independently.
+ */
+enum class GeneratorStream : uint32_t { Length, RoomType, Branch, BranchRoomType };
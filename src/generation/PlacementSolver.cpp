@@ -0,0 +1,238 @@
+#include "generation/PlacementSolver.h"
+
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+#include <string>
+
+namespace {
+constexpr uint16_t TypeBit(size_t type) { return static_cast<uint16_t>(1u << type); }
+}  // namespace
+
+PlacementSolver::PlacementSolver(std::span<const PlacementConstraint> constraints,
+                                 size_t backtrackBudget)
+    : backtrackBudget_(backtrackBudget) {
+  for (const PlacementConstraint& constraint : constraints) {
+    const auto type = static_cast<size_t>(constraint.type);
+    if (type >= Room::TYPE_COUNT) {
+      throw std::invalid_argument("Placement constraint has an unknown room type");
+    }
+    if (constraint.minCount < 0 || constraint.maxCount < 0 || constraint.minSpacing < 1 ||
+        constraint.minDepth < 0) {
+      throw std::invalid_argument("Placement constraint values out of range");
+    }
+
+    Rule& rule = rules_[type];
+    rule.minCount = std::max(rule.minCount, constraint.minCount);
+    rule.maxCount = std::min(rule.maxCount, constraint.maxCount);
+    rule.minSpacing = std::max(rule.minSpacing, constraint.minSpacing);
+    rule.minDepth = std::max(rule.minDepth, constraint.minDepth);
+    rule.maxDepth = std::min(rule.maxDepth, constraint.maxDepth);
+    if (rule.minCount > rule.maxCount) {
+      throw std::invalid_argument(std::string("Contradictory placement counts for ") +
+                                  Room::TypeToString(constraint.type));
+    }
+    if (rule.minDepth > rule.maxDepth) {
+      throw std::invalid_argument(std::string("Empty placement depth range for ") +
+                                  Room::TypeToString(constraint.type));
+    }
+    constrainedMask_ |= TypeBit(type);
+  }
+}
+
+PlacementSolver::Result PlacementSolver::Solve(std::span<Room::Type> types,
+                                               std::span<const uint8_t> locked) {
+  Result result;
+  const size_t length = types.size();
+  if (length == 0 || constrainedMask_ == 0) return result;
+  if (locked.size() < length) {
+    throw std::invalid_argument("Locked span is shorter than the room types");
+  }
+
+  BuildDomains(types, locked);
+  counts_.fill(0);
+  last_.fill(-1);
+
+  // Cheap proofs of infeasibility before searching
+  for (size_t type = 0; type < Room::TYPE_COUNT; ++type) {
+    const Rule& rule = rules_[type];
+    int lockedCount = 0;
+    int lockedLast = -1;
+    for (size_t depth = 0; depth < length; ++depth) {
+      if (!locked[depth] || static_cast<size_t>(types[depth]) != type) continue;
+      const int position = static_cast<int>(depth);
+      if (++lockedCount > rule.maxCount ||
+          (lockedLast >= 0 && position - lockedLast < rule.minSpacing)) {
+        result.status = Status::Unsatisfiable;
+        result.conflictingType = static_cast<Room::Type>(type);
+        return result;
+      }
+      lockedLast = position;
+    }
+    if (rule.minCount > 0 && Capacity(type, 0, -1, rule.minCount) < rule.minCount) {
+      result.status = Status::Unsatisfiable;
+      result.conflictingType = static_cast<Room::Type>(type);
+      return result;
+    }
+  }
+
+  // Depth-first search, one frame per depth
+  frames_.resize(length);
+  BuildCandidates(0, types);
+  size_t depth = 0;
+  Room::Type lastFailure = FALLBACK_TYPE;
+  while (depth < length) {
+    Frame& frame = frames_[depth];
+    if (frame.nextCandidate == frame.candidateCount) {
+      if (depth == 0) {
+        result.status = Status::Unsatisfiable;
+        result.conflictingType = lastFailure;
+        return result;
+      }
+      --depth;
+      const Frame& previous = frames_[depth];
+      const auto undone = static_cast<size_t>(previous.candidates[previous.nextCandidate - 1]);
+      --counts_[undone];
+      last_[undone] = previous.previousLast;
+      continue;
+    }
+
+    const Room::Type candidate = frame.candidates[frame.nextCandidate++];
+    const auto type = static_cast<size_t>(candidate);
+    if (!CanAssign(depth, type, lastFailure)) {
+      if (++result.backtracks > backtrackBudget_) {
+        result.status = Status::BudgetExhausted;
+        result.conflictingType = lastFailure;
+        return result;
+      }
+      continue;
+    }
+
+    frame.previousLast = last_[type];
+    ++counts_[type];
+    last_[type] = static_cast<int>(depth);
+    if (++depth < length) {
+      BuildCandidates(depth, types);
+    }
+  }
+
+  for (size_t i = 0; i < length; ++i) {
+    types[i] = frames_[i].candidates[frames_[i].nextCandidate - 1];
+  }
+  return result;
+}
+
+void PlacementSolver::BuildDomains(std::span<const Room::Type> types,
+                                   std::span<const uint8_t> locked) {
+  const size_t length = types.size();
+  wordCount_ = (length + 63) / 64;
+  domains_.resize(length);
+  positions_.assign(wordCount_ * Room::TYPE_COUNT, 0);
+
+  TypeMask required = 0;
+  for (size_t type = 0; type < Room::TYPE_COUNT; ++type) {
+    if (rules_[type].minCount > 0) required |= TypeBit(type);
+  }
+
+  for (size_t depth = 0; depth < length; ++depth) {
+    const auto current = static_cast<size_t>(types[depth]);
+    TypeMask domain = TypeBit(current);
+    if (!locked[depth]) {
+      domain |= required | TypeBit(static_cast<size_t>(FALLBACK_TYPE));
+      // Types outside their depth window are removed (locked rooms are checked on assignment)
+      const int position = static_cast<int>(depth);
+      for (size_t type = 0; type < Room::TYPE_COUNT; ++type) {
+        const Rule& rule = rules_[type];
+        if (position < rule.minDepth || position > rule.maxDepth) {
+          domain &= static_cast<TypeMask>(~TypeBit(type));
+        }
+      }
+    }
+    domains_[depth] = domain;
+
+    for (TypeMask bits = domain; bits != 0; bits &= bits - 1) {
+      const auto type = static_cast<size_t>(std::countr_zero(bits));
+      positions_[type * wordCount_ + depth / 64] |= uint64_t{1} << (depth % 64);
+    }
+  }
+}
+
+void PlacementSolver::BuildCandidates(size_t depth, std::span<const Room::Type> types) {
+  Frame& frame = frames_[depth];
+  frame.candidateCount = 0;
+  frame.nextCandidate = 0;
+
+  TypeMask remaining = domains_[depth];
+  auto add = [&](size_t type) {
+    if (remaining & TypeBit(type)) {
+      frame.candidates[frame.candidateCount++] = static_cast<Room::Type>(type);
+      remaining &= static_cast<TypeMask>(~TypeBit(type));
+    }
+  };
+
+  // A type short of its minimum goes first once its next evenly spaced slot
+  // is reached, so guaranteed rooms spread out instead of bunching up at the
+  // end; then the sampled type, other short types and the fallback
+  const size_t length = domains_.size();
+  for (size_t type = 0; type < Room::TYPE_COUNT; ++type) {
+    const int minCount = rules_[type].minCount;
+    if (counts_[type] < minCount &&
+        depth * static_cast<size_t>(minCount + 1) >= static_cast<size_t>(counts_[type] + 1) * length) {
+      add(type);
+    }
+  }
+  add(static_cast<size_t>(types[depth]));
+  for (size_t type = 0; type < Room::TYPE_COUNT; ++type) {
+    if (counts_[type] < rules_[type].minCount) add(type);
+  }
+  add(static_cast<size_t>(FALLBACK_TYPE));
+  while (remaining != 0) {
+    add(static_cast<size_t>(std::countr_zero(remaining)));
+  }
+}
+
+int PlacementSolver::Capacity(size_t type, size_t from, int last, int needed) const {
+  const size_t length = domains_.size();
+  const auto spacing = static_cast<size_t>(rules_[type].minSpacing);
+  const uint64_t* words = positions_.data() + type * wordCount_;
+
+  // Greedy leftmost placement maximises the count under a spacing rule
+  size_t position = last < 0 ? from : std::max(from, static_cast<size_t>(last) + spacing);
+  int count = 0;
+  while (position < length && count < needed) {
+    size_t word = position / 64;
+    uint64_t bits = words[word] & (~uint64_t{0} << (position % 64));
+    while (bits == 0 && ++word < wordCount_) bits = words[word];
+    if (bits == 0) break;
+
+    const size_t next = word * 64 + static_cast<size_t>(std::countr_zero(bits));
+    if (next >= length) break;
+    ++count;
+    position = next + spacing;
+  }
+  return count;
+}
+
+bool PlacementSolver::CanAssign(size_t depth, size_t type, Room::Type& failedType) const {
+  const Rule& rule = rules_[type];
+  const int position = static_cast<int>(depth);
+  if (counts_[type] + 1 > rule.maxCount || position < rule.minDepth || position > rule.maxDepth ||
+      (last_[type] >= 0 && position - last_[type] < rule.minSpacing)) {
+    failedType = static_cast<Room::Type>(type);
+    return false;
+  }
+
+  // Forward check: every type below its minimum must still fit in the remaining depths
+  for (size_t other = 0; other < Room::TYPE_COUNT; ++other) {
+    const int placed = counts_[other] + (other == type ? 1 : 0);
+    const int deficit = rules_[other].minCount - placed;
+    if (deficit <= 0) continue;
+
+    const int last = other == type ? position : last_[other];
+    if (Capacity(other, depth + 1, last, deficit) < deficit) {
+      failedType = static_cast<Room::Type>(other);
+      return false;
+    }
+  }
+  return true;
+}
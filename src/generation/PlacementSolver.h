@@ -0,0 +1,110 @@
+#pragma once
+#include <array>
+#include <climits>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <vector>
+
+#include "core/Room.h"
+
+/**
+ * Depth-based placement rule for one room type along the critical path
+ */
+struct PlacementConstraint {
+  Room::Type type = Room::Type::Combat;
+  int minCount = 0;
+  int maxCount = INT_MAX;
+  int minSpacing = 1;  // Minimum depth gap between two rooms of this type (2 = never adjacent)
+  int minDepth = 0;    // Rooms of this type may only appear in [minDepth, maxDepth]
+  int maxDepth = INT_MAX;
+};
+
+/**
+ * Adjusts a run's room types until every placement constraint holds
+ *
+ * Each depth has a bitset domain of the types it may take: locked depths
+ * (start, boss, mini-bosses) keep their one type, free depths may keep
+ * their sampled type, take a constrained type or fall back to Combat.
+ * A depth-first search assigns depths in order, preferring the sampled
+ * type (a type short of its minimum is tried first at evenly spaced
+ * depths). It prunes with per-type position bitsets: a partial assignment
+ * is rejected as soon as some type can no longer reach its minimum count.
+ * Rejected candidates are capped by a backtrack budget, so solving stays
+ * linear in the run length plus that budget.
+ *
+ * Several constraints for the same type are intersected.
+ */
+class PlacementSolver {
+ public:
+  enum class Status {
+    Satisfied,
+    Unsatisfiable,   // Proven impossible for this run
+    BudgetExhausted  // Gave up after the backtrack budget
+  };
+
+  struct Result {
+    Status status = Status::Satisfied;
+    Room::Type conflictingType = Room::Type::Combat;  // Type whose rule failed
+    size_t backtracks = 0;  // Candidates rejected during the search
+
+    bool IsSatisfied() const { return status == Status::Satisfied; }
+  };
+
+  static constexpr size_t DEFAULT_BACKTRACK_BUDGET = 10'000;
+  static constexpr Room::Type FALLBACK_TYPE = Room::Type::Combat;
+
+  /**
+   * @throws std::invalid_argument on contradictory or malformed constraints
+   */
+  explicit PlacementSolver(std::span<const PlacementConstraint> constraints,
+                           size_t backtrackBudget = DEFAULT_BACKTRACK_BUDGET);
+
+  /**
+   * Rewrites types in place; types[i] is the room at depth i
+   * @param locked Nonzero entries must keep their current type
+   * On failure types is left unchanged.
+   */
+  Result Solve(std::span<Room::Type> types, std::span<const uint8_t> locked);
+
+  bool HasConstraints() const { return constrainedMask_ != 0; }
+
+ private:
+  using TypeMask = uint16_t;
+  static_assert(Room::TYPE_COUNT <= 16, "TypeMask holds one bit per room type");
+
+  // Merged rule for one type
+  struct Rule {
+    int minCount = 0;
+    int maxCount = INT_MAX;
+    int minSpacing = 1;
+    int minDepth = 0;
+    int maxDepth = INT_MAX;
+  };
+
+  struct Frame {
+    std::array<Room::Type, Room::TYPE_COUNT> candidates;
+    uint8_t candidateCount = 0;
+    uint8_t nextCandidate = 0;
+    int previousLast = -1;  // last_ of the assigned type before this depth took it
+  };
+
+  void BuildDomains(std::span<const Room::Type> types, std::span<const uint8_t> locked);
+  void BuildCandidates(size_t depth, std::span<const Room::Type> types);
+  // Most rooms of type that fit in depths >= from given the last one
+  // placed, counting no further than needed
+  int Capacity(size_t type, size_t from, int last, int needed) const;
+  bool CanAssign(size_t depth, size_t type, Room::Type& failedType) const;
+
+  std::array<Rule, Room::TYPE_COUNT> rules_;
+  TypeMask constrainedMask_ = 0;
+  size_t backtrackBudget_;
+
+  // Per-solve scratch
+  size_t wordCount_ = 0;
+  std::vector<TypeMask> domains_;
+  std::vector<uint64_t> positions_;  // Per type: bitset of depths whose domain holds it
+  std::vector<Frame> frames_;
+  std::array<int, Room::TYPE_COUNT> counts_{};
+  std::array<int, Room::TYPE_COUNT> last_{};
+};
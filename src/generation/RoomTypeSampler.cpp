@@ -0,0 +1,23 @@
+#include "generation/RoomTypeSampler.h"
+
+#include <stdexcept>
+
+void RoomTypeSampler::SampleBulk(std::span<const uint32_t> words,
+                                 std::span<Room::Type> out) const {
+  if (out.size() < words.size()) {
+    throw std::invalid_argument("Output span is shorter than the input words");
+  }
+  for (size_t i = 0; i < words.size(); ++i) {
+    out[i] = Sample(words[i]);
+  }
+}
+
+double RoomTypeSampler::GetProbability(Room::Type type) const {
+  const size_t target = static_cast<size_t>(type);
+  uint64_t mass = 0;
+  for (size_t column = 0; column < Room::TYPE_COUNT; ++column) {
+    if (column == target) mass += threshold_[column];
+    if (static_cast<size_t>(alias_[column]) == target) mass += COLUMN_MASS - threshold_[column];
+  }
+  return static_cast<double>(mass) / (static_cast<double>(COLUMN_MASS) * Room::TYPE_COUNT);
+}
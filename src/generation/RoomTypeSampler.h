@@ -0,0 +1,134 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+
+#include "core/Room.h"
+
+/**
+ * O(1) weighted room-type sampling with a Walker/Vose alias table
+ *
+ * Weights are compiled once into one column per room type; each column
+ * holds a threshold and an alias, so a sample is one multiply and one
+ * comparison whatever the number of types. The table is built with integer
+ * arithmetic from weights quantized to 2^-32, and a sample consumes exactly
+ * one 32-bit word, so results are identical on every toolchain.
+ */
+class RoomTypeSampler {
+ public:
+  // Relative weights indexed by Room::Type (need not sum to anything)
+  using Weights = std::array<float, Room::TYPE_COUNT>;
+
+  /**
+   * @throws std::invalid_argument if a weight is negative or not finite,
+   *         or all weights are zero
+   */
+  constexpr explicit RoomTypeSampler(const Weights& weights);
+
+  /**
+   * Maps one uniformly distributed 32-bit word to a room type
+   */
+  constexpr Room::Type Sample(uint32_t word) const {
+    const uint64_t scaled = uint64_t{word} * Room::TYPE_COUNT;
+    const size_t column = static_cast<size_t>(scaled >> 32);
+    const uint32_t coin = static_cast<uint32_t>(scaled);
+    return coin < threshold_[column] ? static_cast<Room::Type>(column) : alias_[column];
+  }
+
+  template <typename Engine>
+  Room::Type Sample(Engine& engine) const {
+    return Sample(static_cast<uint32_t>(engine()));
+  }
+
+  /**
+   * Samples one type per word; out must be at least as long as words
+   */
+  void SampleBulk(std::span<const uint32_t> words, std::span<Room::Type> out) const;
+
+  /**
+   * Exact probability the table assigns to a type
+   */
+  double GetProbability(Room::Type type) const;
+
+ private:
+  static constexpr uint64_t COLUMN_MASS = uint64_t{1} << 32;
+
+  // std::llround for non-negative values, usable in constant expressions
+  static constexpr uint64_t RoundShare(double value) {
+    const auto whole = static_cast<uint64_t>(value);
+    return value - static_cast<double>(whole) >= 0.5 ? whole + 1 : whole;
+  }
+
+  std::array<uint64_t, Room::TYPE_COUNT> threshold_{};  // Out of COLUMN_MASS
+  std::array<Room::Type, Room::TYPE_COUNT> alias_{};
+};
+
+// Defined here so tables for fixed weights can be built at compile time
+constexpr RoomTypeSampler::RoomTypeSampler(const Weights& weights) {
+  constexpr size_t count = Room::TYPE_COUNT;
+
+  double total = 0.0;
+  for (const float weight : weights) {
+    // Rejects NaN and infinities as well
+    if (!(weight >= 0.0f && weight <= std::numeric_limits<float>::max())) {
+      throw std::invalid_argument("Room type weights must be finite and non-negative");
+    }
+    total += weight;
+  }
+  if (total <= 0.0) {
+    throw std::invalid_argument("At least one room type weight must be positive");
+  }
+
+  // Quantize to integer shares of 2^32, then give the rounding slack to the
+  // heaviest type so the shares sum exactly
+  std::array<uint64_t, count> share{};
+  uint64_t shareSum = 0;
+  size_t heaviest = 0;
+  for (size_t i = 0; i < count; ++i) {
+    share[i] = RoundShare(weights[i] / total * 4294967296.0);
+    shareSum += share[i];
+    if (weights[i] > weights[heaviest]) heaviest = i;
+  }
+  share[heaviest] = share[heaviest] + COLUMN_MASS - shareSum;
+
+  // Vose: scaled masses average COLUMN_MASS; pair each light column with a
+  // heavy one that tops it up
+  std::array<uint64_t, count> mass{};
+  std::array<size_t, count> small{};
+  std::array<size_t, count> large{};
+  size_t smallCount = 0;
+  size_t largeCount = 0;
+  for (size_t i = 0; i < count; ++i) {
+    mass[i] = share[i] * count;
+    if (mass[i] < COLUMN_MASS) {
+      small[smallCount++] = i;
+    } else {
+      large[largeCount++] = i;
+    }
+  }
+
+  while (smallCount > 0 && largeCount > 0) {
+    const size_t light = small[--smallCount];
+    const size_t heavy = large[largeCount - 1];
+    threshold_[light] = mass[light];
+    alias_[light] = static_cast<Room::Type>(heavy);
+
+    mass[heavy] -= COLUMN_MASS - mass[light];
+    if (mass[heavy] < COLUMN_MASS) {
+      --largeCount;
+      small[smallCount++] = heavy;
+    }
+  }
+
+  // Leftover columns are full (exact integer arithmetic leaves no residue)
+  for (size_t i = 0; i < largeCount; ++i) {
+    threshold_[large[i]] = COLUMN_MASS;
+    alias_[large[i]] = static_cast<Room::Type>(large[i]);
+  }
+  for (size_t i = 0; i < smallCount; ++i) {
+    threshold_[small[i]] = COLUMN_MASS;
+    alias_[small[i]] = static_cast<Room::Type>(small[i]);
+  }
+}
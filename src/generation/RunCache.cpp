@@ -0,0 +1,151 @@
+#include "generation/RunCache.h"
+
+#include <bit>
+#include <stdexcept>
+
+namespace {
+// SplitMix64 finalizer
+uint64_t Avalanche(uint64_t value) {
+  value = (value ^ (value >> 30)) * 0xBF58476D1CE4E5B9ull;
+  value = (value ^ (value >> 27)) * 0x94D049BB133111EBull;
+  return value ^ (value >> 31);
+}
+
+class ConfigHasher {
+ public:
+  void Add(uint64_t value) { hash_ = Avalanche(hash_ ^ value) + 0x9E3779B97F4A7C15ull; }
+  void Add(int value) { Add(static_cast<uint64_t>(static_cast<uint32_t>(value))); }
+  void Add(float value) { Add(uint64_t{std::bit_cast<uint32_t>(value)}); }
+  uint64_t Get() const { return hash_; }
+
+ private:
+  uint64_t hash_ = 0;
+};
+}  // namespace
+
+RunCache::RunCache(size_t byteBudget, size_t shardCount)
+    : shardCount_(shardCount), shardBudget_(shardCount > 0 ? byteBudget / shardCount : 0) {
+  if (shardCount == 0) {
+    throw std::invalid_argument("RunCache needs at least one shard");
+  }
+  shards_ = std::make_unique<Shard[]>(shardCount);
+}
+
+uint64_t RunCache::HashConfig(const PathGenerator::Config& config) {
+  ConfigHasher hasher;
+  hasher.Add(config.minRooms);
+  hasher.Add(config.maxRooms);
+  hasher.Add(config.branchProbability);
+  hasher.Add(config.maxBranchLength);
+  hasher.Add(config.miniBossInterval);
+  hasher.Add(config.guaranteedShops);
+  hasher.Add(config.guaranteedFountains);
+
+  hasher.Add(uint64_t{config.placementConstraints.size()});
+  for (const PlacementConstraint& constraint : config.placementConstraints) {
+    hasher.Add(static_cast<int>(constraint.type));
+    hasher.Add(constraint.minCount);
+    hasher.Add(constraint.maxCount);
+    hasher.Add(constraint.minSpacing);
+    hasher.Add(constraint.minDepth);
+    hasher.Add(constraint.maxDepth);
+  }
+
+  // Only the configured biome's weights are used
+  hasher.Add(static_cast<int>(config.biome));
+  for (const float weight : config.roomTypeWeights[static_cast<size_t>(config.biome)]) {
+    hasher.Add(weight);
+  }
+  return hasher.Get();
+}
+
+RunCache::Handle RunCache::GetOrGenerate(uint64_t seed, const PathGenerator::Config& config) {
+  return GetOrGenerate(seed, config, HashConfig(config));
+}
+
+RunCache::Handle RunCache::GetOrGenerate(uint64_t seed, const PathGenerator::Config& config,
+                                         uint64_t configHash) {
+  const Key key{seed, configHash};
+  if (Handle cached = Find(key)) return cached;
+
+  // Generated outside the shard lock so other keys are never held up
+  PathGenerator generator(seed);
+  generator.SetConfig(config);
+  return Insert(key, generator.GeneratePath());
+}
+
+RunCache::Handle RunCache::Find(const Key& key) {
+  Shard& shard = ShardFor(key);
+  std::lock_guard lock(shard.mutex);
+
+  const auto it = shard.index.find(key);
+  if (it == shard.index.end()) {
+    ++shard.misses;
+    return nullptr;
+  }
+  ++shard.hits;
+  shard.lru.splice(shard.lru.begin(), shard.lru, it->second);
+  return it->second->graph;
+}
+
+RunCache::Handle RunCache::Insert(const Key& key, RunGraph graph) {
+  if (!graph.IsFinalized()) {
+    throw std::invalid_argument("RunCache only holds finalized graphs");
+  }
+  // Filled before sharing, so concurrent path queries on a handle only read
+  graph.PrecomputePaths();
+
+  const size_t bytes = graph.GetMemoryUsage() + ENTRY_OVERHEAD_BYTES;
+  auto handle = std::make_shared<const RunGraph>(std::move(graph));
+
+  Shard& shard = ShardFor(key);
+  std::lock_guard lock(shard.mutex);
+
+  const auto existing = shard.index.find(key);
+  if (existing != shard.index.end()) {
+    shard.lru.splice(shard.lru.begin(), shard.lru, existing->second);
+    return existing->second->graph;
+  }
+  if (bytes > shardBudget_) return handle;
+
+  shard.lru.push_front(Entry{key, handle, bytes});
+  shard.index.emplace(key, shard.lru.begin());
+  shard.bytes += bytes;
+
+  while (shard.bytes > shardBudget_) {
+    const Entry& victim = shard.lru.back();
+    shard.bytes -= victim.bytes;
+    shard.index.erase(victim.key);
+    shard.lru.pop_back();
+    ++shard.evictions;
+  }
+  return handle;
+}
+
+void RunCache::Clear() {
+  for (size_t i = 0; i < shardCount_; ++i) {
+    Shard& shard = shards_[i];
+    std::lock_guard lock(shard.mutex);
+    shard.index.clear();
+    shard.lru.clear();
+    shard.bytes = 0;
+  }
+}
+
+RunCache::Counters RunCache::GetCounters() const {
+  Counters counters;
+  for (size_t i = 0; i < shardCount_; ++i) {
+    const Shard& shard = shards_[i];
+    std::lock_guard lock(shard.mutex);
+    counters.hits += shard.hits;
+    counters.misses += shard.misses;
+    counters.evictions += shard.evictions;
+    counters.entries += shard.index.size();
+    counters.bytes += shard.bytes;
+  }
+  return counters;
+}
+
+uint64_t RunCache::Mix(const Key& key) {
+  return Avalanche(key.seed ^ Avalanche(key.configHash + 0x9E3779B97F4A7C15ull));
+}
@@ -0,0 +1,117 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <unordered_map>
+
+#include "core/RunGraph.h"
+#include "generation/PathGenerator.h"
+
+/**
+ * Thread-safe LRU cache of generated runs, bounded by bytes
+ *
+ * Runs are keyed by (seed, HashConfig(config)) and generated with a
+ * counter-based PathGenerator, so a cached run is exactly what
+ * PathGenerator(seed) with that config would produce. Handles are shared
+ * and immutable: graphs are finalized and have their path cache filled
+ * before they are shared, so any number of threads can read one handle
+ * without synchronization. Eviction only drops the cache's
+ * reference; handles already given out stay valid.
+ *
+ * Keys are spread over independently locked shards, each holding
+ * byteBudget / shardCount bytes of runs (RunGraph::GetMemoryUsage() plus
+ * ENTRY_OVERHEAD_BYTES per entry). A run larger than one shard's budget
+ * is returned but not cached. Two threads missing the same key at once
+ * both generate it; the first to finish is cached and both get its handle.
+ */
+class RunCache {
+ public:
+  using Handle = std::shared_ptr<const RunGraph>;
+
+  static constexpr size_t DEFAULT_SHARD_COUNT = 16;
+  // Bookkeeping per entry: LRU list node, index node and bucket
+  static constexpr size_t ENTRY_OVERHEAD_BYTES = 128;
+
+  struct Key {
+    uint64_t seed = 0;
+    uint64_t configHash = 0;
+
+    friend bool operator==(const Key&, const Key&) = default;
+  };
+
+  struct Counters {
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+    size_t entries = 0;
+    size_t bytes = 0;
+  };
+
+  /**
+   * @throws std::invalid_argument if shardCount is 0
+   */
+  explicit RunCache(size_t byteBudget, size_t shardCount = DEFAULT_SHARD_COUNT);
+
+  /**
+   * 64-bit hash of every Config field that affects generation; equal
+   * configs hash equally in every process and on every platform
+   */
+  static uint64_t HashConfig(const PathGenerator::Config& config);
+
+  /**
+   * Cached run for seed and config, generated and cached on a miss
+   * @throws std::invalid_argument if config is invalid
+   * @throws std::runtime_error if the placement constraints cannot be met
+   */
+  Handle GetOrGenerate(uint64_t seed, const PathGenerator::Config& config);
+  // Same, with configHash == HashConfig(config) computed once by the caller
+  Handle GetOrGenerate(uint64_t seed, const PathGenerator::Config& config, uint64_t configHash);
+
+  // Cached run, or null; counts a hit or a miss and refreshes recency
+  Handle Find(const Key& key);
+
+  /**
+   * Caches a finalized graph under key, evicting least recently used runs
+   * @return The cached handle: an existing run under key wins over graph
+   * @throws std::invalid_argument if graph is not finalized
+   */
+  Handle Insert(const Key& key, RunGraph graph);
+
+  // Drops every entry; counters are kept
+  void Clear();
+
+  // Totals over all shards (each shard is read under its own lock)
+  Counters GetCounters() const;
+  size_t GetByteBudget() const { return shardBudget_ * shardCount_; }
+  size_t GetShardCount() const { return shardCount_; }
+
+ private:
+  struct KeyHash {
+    size_t operator()(const Key& key) const { return static_cast<size_t>(Mix(key)); }
+  };
+
+  struct Entry {
+    Key key;
+    Handle graph;
+    size_t bytes;
+  };
+
+  struct alignas(64) Shard {
+    mutable std::mutex mutex;
+    std::list<Entry> lru;  // Most recently used first
+    std::unordered_map<Key, std::list<Entry>::iterator, KeyHash> index;
+    size_t bytes = 0;
+    uint64_t hits = 0;
+    uint64_t misses = 0;
+    uint64_t evictions = 0;
+  };
+
+  static uint64_t Mix(const Key& key);
+  Shard& ShardFor(const Key& key) { return shards_[(Mix(key) >> 32) % shardCount_]; }
+
+  size_t shardCount_;
+  size_t shardBudget_;
+  std::unique_ptr<Shard[]> shards_;
+};
@@ -0,0 +1,110 @@
+#include "generation/RunPredicate.h"
+
+#include <algorithm>
+#include <stdexcept>
+
+namespace {
+using Verdict = RunPredicate::Verdict;
+using View = RunPredicate::View;
+using Stage = RunPredicate::Stage;
+
+// All: one Reject decides; Any: one Accept decides
+Verdict Combine(const std::vector<RunPredicate>& terms, bool any, const View& view) {
+  const Verdict decisive = any ? Verdict::Accept : Verdict::Reject;
+  bool pending = false;
+  for (const RunPredicate& term : terms) {
+    const Verdict verdict = term.Evaluate(view);
+    if (verdict == decisive) return decisive;
+    pending |= verdict == Verdict::Pending;
+  }
+  if (pending) return Verdict::Pending;
+  return any ? Verdict::Reject : Verdict::Accept;
+}
+}  // namespace
+
+RunPredicate::RunPredicate() = default;
+
+RunPredicate RunPredicate::RoomCount(Room::Type type, int minCount, int maxCount, int fromDepth,
+                                     int toDepth) {
+  if (minCount < 0 || maxCount < minCount || fromDepth < 0 || toDepth < fromDepth) {
+    throw std::invalid_argument(
+        "RoomCount needs 0 <= minCount <= maxCount and 0 <= fromDepth <= toDepth");
+  }
+  return Custom([=](const View& view) {
+    const int begin = std::min(fromDepth, view.criticalLength);
+    const int end = std::clamp(toDepth, begin, view.criticalLength);
+
+    if (view.stage == Stage::Length) {
+      // Too few rooms in the window, or every outcome fits
+      if (minCount > end - begin) return Verdict::Reject;
+      if (minCount == 0 && maxCount >= end - begin) return Verdict::Accept;
+      return Verdict::Pending;
+    }
+
+    int count = 0;
+    for (int depth = begin; depth < end; ++depth) {
+      if (view.criticalTypes[depth] == type && ++count > maxCount) return Verdict::Reject;
+    }
+    return count >= minCount ? Verdict::Accept : Verdict::Reject;
+  });
+}
+
+RunPredicate RunPredicate::PathLength(int minRooms, int maxRooms) {
+  if (maxRooms < minRooms) {
+    throw std::invalid_argument("PathLength needs minRooms <= maxRooms");
+  }
+  return Custom([=](const View& view) {
+    return view.criticalLength >= minRooms && view.criticalLength <= maxRooms ? Verdict::Accept
+                                                                              : Verdict::Reject;
+  });
+}
+
+RunPredicate RunPredicate::Custom(Function function) {
+  if (!function) {
+    throw std::invalid_argument("Custom predicate needs a function");
+  }
+  return RunPredicate(std::make_shared<const Function>(std::move(function)));
+}
+
+RunPredicate RunPredicate::All(std::initializer_list<RunPredicate> terms) {
+  return Custom([terms = std::vector<RunPredicate>(terms)](const View& view) {
+    return Combine(terms, false, view);
+  });
+}
+
+RunPredicate RunPredicate::Any(std::initializer_list<RunPredicate> terms) {
+  return Custom([terms = std::vector<RunPredicate>(terms)](const View& view) {
+    return Combine(terms, true, view);
+  });
+}
+
+RunPredicate RunPredicate::Not(const RunPredicate& term) {
+  return Custom([term](const View& view) {
+    switch (term.Evaluate(view)) {
+      case Verdict::Accept:
+        return Verdict::Reject;
+      case Verdict::Reject:
+        return Verdict::Accept;
+      default:
+        return Verdict::Pending;
+    }
+  });
+}
+
+RunPredicate::Verdict RunPredicate::Evaluate(const View& view) const {
+  return term_ ? (*term_)(view) : Verdict::Accept;
+}
+
+bool RunPredicate::Matches(const RunGraph& graph) const {
+  std::vector<Room::Type> types;
+  for (const RunGraph::NodeIndex index : graph.GetCriticalPath()) {
+    types.push_back(graph.GetNode(index)->GetRoom()->GetType());
+  }
+
+  View view;
+  view.stage = Stage::Complete;
+  view.criticalLength = static_cast<int>(types.size());
+  view.criticalTypes = types;
+  view.graph = &graph;
+  return Evaluate(view) == Verdict::Accept;
+}
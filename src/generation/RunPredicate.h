@@ -0,0 +1,103 @@
+#pragma once
+#include <climits>
+#include <functional>
+#include <initializer_list>
+#include <memory>
+#include <span>
+#include <vector>
+
+#include "core/Room.h"
+#include "core/RunGraph.h"
+
+/**
+ * Composable condition on a generated run, checked while it is generated
+ *
+ * Generation reveals a run in stages: first the critical path length, then
+ * the final type of every critical room (after placement rules), then the
+ * finished graph. A predicate is evaluated at each stage and answers
+ * Accept, Reject, or Pending when it cannot tell yet, so a generator can
+ * abandon a seed at the first stage that rejects it instead of building
+ * the whole graph. At the Complete stage Pending counts as Reject.
+ *
+ * Predicates are immutable and cheap to copy; copies share their terms, so
+ * one predicate can be evaluated from many threads.
+ *
+ *   // At least 3 Fountains before depth 20 and no Elite in the first 5 rooms
+ *   RunPredicate query = RunPredicate::AtLeast(Room::Type::Fountain, 3, 0, 20) &&
+ *                        RunPredicate::AtMost(Room::Type::Elite, 0, 0, 5);
+ */
+class RunPredicate {
+ public:
+  enum class Stage {
+    Length,     // criticalLength is known
+    RoomTypes,  // criticalTypes holds every critical room's final type
+    Complete    // graph is finalized
+  };
+
+  enum class Verdict { Pending, Accept, Reject };
+
+  /**
+   * What generation has decided so far
+   */
+  struct View {
+    Stage stage = Stage::Length;
+    int criticalLength = 0;
+    std::span<const Room::Type> criticalTypes;  // Indexed by depth; empty at Length
+    const RunGraph* graph = nullptr;            // Complete stage only
+  };
+
+  using Function = std::function<Verdict(const View&)>;
+
+  // Accepts every run
+  RunPredicate();
+
+  /**
+   * Critical rooms of type with depth in [fromDepth, toDepth) number
+   * between minCount and maxCount (inclusive). Branch rooms are not counted.
+   */
+  static RunPredicate RoomCount(Room::Type type, int minCount, int maxCount, int fromDepth = 0,
+                                int toDepth = INT_MAX);
+  static RunPredicate AtLeast(Room::Type type, int count, int fromDepth = 0,
+                              int toDepth = INT_MAX) {
+    return RoomCount(type, count, INT_MAX, fromDepth, toDepth);
+  }
+  static RunPredicate AtMost(Room::Type type, int count, int fromDepth = 0,
+                             int toDepth = INT_MAX) {
+    return RoomCount(type, 0, count, fromDepth, toDepth);
+  }
+
+  // Critical path length in [minRooms, maxRooms]
+  static RunPredicate PathLength(int minRooms, int maxRooms);
+
+  /**
+   * Caller-defined term; it should return Pending until the stage carries
+   * what it inspects, and must not change a decided verdict later
+   */
+  static RunPredicate Custom(Function function);
+
+  static RunPredicate All(std::initializer_list<RunPredicate> terms);
+  static RunPredicate Any(std::initializer_list<RunPredicate> terms);
+  static RunPredicate Not(const RunPredicate& term);
+
+  friend RunPredicate operator&&(const RunPredicate& a, const RunPredicate& b) {
+    return All({a, b});
+  }
+  friend RunPredicate operator||(const RunPredicate& a, const RunPredicate& b) {
+    return Any({a, b});
+  }
+  friend RunPredicate operator!(const RunPredicate& term) { return Not(term); }
+
+  Verdict Evaluate(const View& view) const;
+
+  /**
+   * Evaluates a finished run at the Complete stage, reading its critical
+   * path from RunGraph::GetCriticalPath()
+   * @throws std::logic_error if the graph has no start node or has a cycle
+   */
+  bool Matches(const RunGraph& graph) const;
+
+ private:
+  explicit RunPredicate(std::shared_ptr<const Function> term) : term_(std::move(term)) {}
+
+  std::shared_ptr<const Function> term_;  // Null accepts everything
+};
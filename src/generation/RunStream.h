@@ -0,0 +1,141 @@
+#pragma once
+#include <coroutine>
+#include <cstdint>
+#include <exception>
+#include <iterator>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+
+#include "core/Room.h"
+#include "core/RunGraph.h"
+
+/**
+ * One step of a streamed run: a room, or an edge between two rooms that
+ * have already been streamed. Indices are the rooms' indices in the
+ * finished RunGraph.
+ */
+struct RunEvent {
+  enum class Kind : uint8_t { Room, Edge };
+
+  Kind kind = Kind::Room;
+  RunGraph::NodeIndex index = RunGraph::INVALID_INDEX;   // Room, or the edge's source
+  RunGraph::NodeIndex target = RunGraph::INVALID_INDEX;  // Edge only
+  // Room only
+  Room::Type type = Room::Type::Combat;
+  int depth = 0;
+  bool onCriticalPath = false;
+};
+
+/**
+ * Coroutine that yields a run's RunEvents and returns its RunGraph
+ *
+ * Lazy and single-pass: nothing runs until the first Next() (or begin()),
+ * and each call resumes generation up to the following event. Once Next()
+ * returns false the finished graph can be taken. Exceptions thrown by the
+ * generator surface from the Next() that resumed it.
+ *
+ *   RunStream stream = generator.GenerateStream();
+ *   for (const RunEvent& event : stream) { ... }
+ *   RunGraph graph = stream.TakeGraph();
+ */
+class RunStream {
+ public:
+  struct promise_type {
+    const RunEvent* current = nullptr;
+    std::optional<RunGraph> graph;
+    std::exception_ptr error;
+
+    RunStream get_return_object() {
+      return RunStream(std::coroutine_handle<promise_type>::from_promise(*this));
+    }
+    std::suspend_always initial_suspend() noexcept { return {}; }
+    std::suspend_always final_suspend() noexcept { return {}; }
+    // The event lives in the coroutine until it is resumed
+    std::suspend_always yield_value(const RunEvent& event) noexcept {
+      current = &event;
+      return {};
+    }
+    void return_value(RunGraph&& result) { graph = std::move(result); }
+    void unhandled_exception() { error = std::current_exception(); }
+  };
+
+  class Iterator {
+   public:
+    using iterator_category = std::input_iterator_tag;
+    using value_type = RunEvent;
+    using difference_type = std::ptrdiff_t;
+
+    Iterator() = default;
+    explicit Iterator(RunStream* stream) : stream_(stream) {}
+
+    const RunEvent& operator*() const { return stream_->Get(); }
+    const RunEvent* operator->() const { return &stream_->Get(); }
+    Iterator& operator++() {
+      if (!stream_->Next()) stream_ = nullptr;
+      return *this;
+    }
+    void operator++(int) { ++*this; }
+    bool operator==(std::default_sentinel_t) const { return stream_ == nullptr; }
+
+   private:
+    RunStream* stream_ = nullptr;
+  };
+
+  RunStream(RunStream&& other) noexcept : handle_(std::exchange(other.handle_, nullptr)) {}
+  RunStream& operator=(RunStream&& other) noexcept {
+    if (this != &other) {
+      if (handle_) handle_.destroy();
+      handle_ = std::exchange(other.handle_, nullptr);
+    }
+    return *this;
+  }
+  RunStream(const RunStream&) = delete;
+  RunStream& operator=(const RunStream&) = delete;
+  ~RunStream() {
+    if (handle_) handle_.destroy();
+  }
+
+  /**
+   * Resumes generation up to the next event
+   * @return false once the run is complete
+   */
+  bool Next() {
+    if (!handle_ || handle_.done()) return false;
+    handle_.resume();
+    if (handle_.promise().error) {
+      std::rethrow_exception(std::exchange(handle_.promise().error, nullptr));
+    }
+    return !handle_.done();
+  }
+
+  // The event reached by the last successful Next()
+  const RunEvent& Get() const { return *handle_.promise().current; }
+
+  bool IsDone() const { return !handle_ || handle_.done(); }
+
+  /**
+   * Moves out the finished graph
+   * @throws std::logic_error if the stream is not complete or was taken
+   */
+  RunGraph TakeGraph() {
+    if (!IsDone() || !handle_ || !handle_.promise().graph) {
+      throw std::logic_error("RunStream::TakeGraph requires a completed stream");
+    }
+    RunGraph graph = std::move(*handle_.promise().graph);
+    handle_.promise().graph.reset();
+    return graph;
+  }
+
+  Iterator begin() {
+    Iterator it(this);
+    ++it;
+    return it;
+  }
+  std::default_sentinel_t end() const { return {}; }
+
+ private:
+  explicit RunStream(std::coroutine_handle<promise_type> handle) : handle_(handle) {}
+
+  std::coroutine_handle<promise_type> handle_;
+};
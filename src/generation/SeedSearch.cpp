@@ -0,0 +1,75 @@
+#include "generation/SeedSearch.h"
+
+#include <algorithm>
+#include <atomic>
+#include <mutex>
+
+#include "util/WorkStealingPool.h"
+
+SeedSearch::Result SeedSearch::Find(const PathGenerator::Config& config,
+                                    const RunPredicate& predicate, const Options& options) {
+  // Validates the config once, before any worker starts
+  PathGenerator prototype(options.firstSeed);
+  prototype.SetConfig(config);
+
+  Result result;
+  if (options.maxMatches == 0 || options.seedCount == 0) return result;
+
+  struct alignas(64) Worker {
+    explicit Worker(const PathGenerator& generator) : generator(generator) {}
+
+    PathGenerator generator;
+    uint64_t generated = 0;
+  };
+
+  WorkStealingPool pool(options.threadCount);
+  std::vector<Worker> workers;
+  workers.reserve(pool.GetThreadCount());
+  for (unsigned i = 0; i < pool.GetThreadCount(); ++i) {
+    workers.emplace_back(prototype);
+  }
+
+  // Offsets from firstSeed of the lowest matches so far, ascending. Once
+  // maxMatches are known, offsets past the largest can no longer qualify.
+  std::mutex matchMutex;
+  std::vector<uint64_t> matches;
+  std::atomic<uint64_t> limit = options.seedCount;
+
+  const uint64_t roundSeeds = SEEDS_PER_TASK * TASKS_PER_THREAD * pool.GetThreadCount();
+  uint64_t roundBegin = 0;
+  while (roundBegin < limit.load(std::memory_order_relaxed)) {
+    const uint64_t roundEnd = roundBegin + std::min(roundSeeds, options.seedCount - roundBegin);
+    const uint64_t taskCount = (roundEnd - roundBegin + SEEDS_PER_TASK - 1) / SEEDS_PER_TASK;
+
+    pool.ParallelFor(static_cast<size_t>(taskCount), [&](size_t task, unsigned index) {
+      Worker& worker = workers[index];
+      const uint64_t begin = roundBegin + task * SEEDS_PER_TASK;
+      const uint64_t end = std::min(begin + SEEDS_PER_TASK, roundEnd);
+      for (uint64_t offset = begin; offset < end; ++offset) {
+        if (offset >= limit.load(std::memory_order_relaxed)) break;
+
+        worker.generator.SetSeed(options.firstSeed + offset);
+        ++worker.generated;
+        if (!worker.generator.GeneratePathIf(predicate)) continue;
+
+        std::lock_guard lock(matchMutex);
+        matches.insert(std::upper_bound(matches.begin(), matches.end(), offset), offset);
+        if (matches.size() > options.maxMatches) matches.pop_back();
+        if (matches.size() == options.maxMatches) {
+          limit.store(std::min(limit.load(std::memory_order_relaxed), matches.back() + 1),
+                      std::memory_order_relaxed);
+        }
+      }
+    });
+    roundBegin = roundEnd;
+  }
+
+  result.seeds.reserve(matches.size());
+  for (const uint64_t offset : matches) {
+    result.seeds.push_back(options.firstSeed + offset);
+  }
+  for (const Worker& worker : workers) {
+    result.seedsGenerated += worker.generated;
+  }
+  return result;
+}
@@ -0,0 +1,43 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+#include "generation/PathGenerator.h"
+#include "generation/RunPredicate.h"
+
+/**
+ * Finds seeds whose runs satisfy a RunPredicate
+ *
+ * Seeds are generated with counter-based PathGenerators, one per worker,
+ * through GeneratePathIf(), so most candidates are rejected before their
+ * graph is built. The scan runs in rounds of SEEDS_PER_TASK-seed tasks
+ * across a work-stealing pool. Once maxMatches seeds are found every
+ * worker stops at the largest of them: seeds above it are skipped and no
+ * further round starts. The result is therefore the lowest maxMatches
+ * matching seeds in the range, whatever the thread count.
+ */
+class SeedSearch {
+ public:
+  static constexpr uint64_t SEEDS_PER_TASK = 64;
+  static constexpr size_t TASKS_PER_THREAD = 4;  // Per round
+
+  struct Options {
+    uint64_t firstSeed = 0;
+    uint64_t seedCount = UINT64_MAX;  // Seeds to scan at most, from firstSeed
+    size_t maxMatches = 1;
+    unsigned threadCount = 0;  // Including the caller (0 = hardware concurrency)
+  };
+
+  struct Result {
+    std::vector<uint64_t> seeds;  // Ascending
+    uint64_t seedsGenerated = 0;  // Work done, which varies with the thread count
+  };
+
+  /**
+   * @throws std::invalid_argument if config is invalid
+   * @throws std::runtime_error if a seed's placement constraints cannot be met
+   */
+  static Result Find(const PathGenerator::Config& config, const RunPredicate& predicate,
+                     const Options& options);
+};
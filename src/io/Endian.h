@@ -0,0 +1,55 @@
+#pragma once
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <type_traits>
+
+/**
+ * Little-endian load/store helpers for on-disk formats
+ *
+ * Values are copied byte-wise so unaligned addresses are fine; on
+ * little-endian hosts these compile down to plain loads and stores.
+ */
+namespace Endian {
+template <typename T>
+constexpr T ByteSwap(T value) {
+  static_assert(std::is_unsigned_v<T>, "ByteSwap requires an unsigned type");
+  T result = 0;
+  for (size_t i = 0; i < sizeof(T); ++i) {
+    result = static_cast<T>((result << 8) | ((value >> (8 * i)) & 0xFF));
+  }
+  return result;
+}
+
+template <typename T>
+T LoadLE(const std::byte* src) {
+  static_assert(std::is_integral_v<T>, "LoadLE requires an integral type");
+  using U = std::make_unsigned_t<T>;
+  U value;
+  std::memcpy(&value, src, sizeof(U));
+  if constexpr (std::endian::native == std::endian::big) {
+    value = ByteSwap(value);
+  }
+  return static_cast<T>(value);
+}
+
+template <typename T>
+void StoreLE(std::byte* dst, T value) {
+  static_assert(std::is_integral_v<T>, "StoreLE requires an integral type");
+  using U = std::make_unsigned_t<T>;
+  U bits = static_cast<U>(value);
+  if constexpr (std::endian::native == std::endian::big) {
+    bits = ByteSwap(bits);
+  }
+  std::memcpy(dst, &bits, sizeof(U));
+}
+
+inline float LoadFloatLE(const std::byte* src) {
+  return std::bit_cast<float>(LoadLE<uint32_t>(src));
+}
+
+inline void StoreFloatLE(std::byte* dst, float value) {
+  StoreLE(dst, std::bit_cast<uint32_t>(value));
+}
+}  // namespace Endian
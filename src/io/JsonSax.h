@@ -0,0 +1,297 @@
+#pragma once
+#include <array>
+#include <charconv>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+#include <string_view>
+
+/**
+ * Minimal SAX-style JSON parser
+ *
+ * Parse() walks one JSON document and reports events to a handler instead
+ * of building a DOM:
+ *
+ *   void StartObject();  void EndObject();
+ *   void StartArray();   void EndArray();
+ *   void Key(std::string_view key);
+ *   void String(std::string_view value);
+ *   void Integer(int64_t value);   // numbers without fraction/exponent
+ *   void Double(double value);
+ *   void Bool(bool value);
+ *   void Null();
+ *
+ * Strings without escapes are views into the input; escaped strings are
+ * decoded into the caller's scratch buffer and stay valid only until the
+ * next string event. The parser is iterative with a fixed nesting limit.
+ */
+namespace JsonSax {
+constexpr size_t MAX_DEPTH = 64;
+
+class ParseError : public std::runtime_error {
+ public:
+  ParseError(const std::string& message, size_t offset)
+      : std::runtime_error(message + " at offset " + std::to_string(offset)), offset_(offset) {}
+
+  size_t GetOffset() const { return offset_; }
+
+ private:
+  size_t offset_;
+};
+
+namespace detail {
+inline bool IsWhitespace(char c) { return c == ' ' || c == '\t' || c == '\n' || c == '\r'; }
+
+inline void AppendUtf8(std::string& out, uint32_t codepoint) {
+  if (codepoint < 0x80) {
+    out.push_back(static_cast<char>(codepoint));
+  } else if (codepoint < 0x800) {
+    out.push_back(static_cast<char>(0xC0 | (codepoint >> 6)));
+    out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+  } else if (codepoint < 0x10000) {
+    out.push_back(static_cast<char>(0xE0 | (codepoint >> 12)));
+    out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+  } else {
+    out.push_back(static_cast<char>(0xF0 | (codepoint >> 18)));
+    out.push_back(static_cast<char>(0x80 | ((codepoint >> 12) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | ((codepoint >> 6) & 0x3F)));
+    out.push_back(static_cast<char>(0x80 | (codepoint & 0x3F)));
+  }
+}
+
+class Parser {
+ public:
+  Parser(std::string_view text, std::string& scratch) : text_(text), scratch_(scratch) {}
+
+  template <typename Handler>
+  void Run(Handler& handler) {
+    enum class Container : uint8_t { Object, Array };
+    std::array<Container, MAX_DEPTH> stack;
+    size_t depth = 0;
+
+    bool needKey = false;
+    while (true) {
+      SkipWhitespace();
+
+      if (needKey) {
+        if (Peek() != '"') Fail("Expected object key");
+        ++pos_;
+        handler.Key(ParseString());
+        SkipWhitespace();
+        Expect(':');
+        SkipWhitespace();
+        needKey = false;
+      }
+
+      // Value
+      const char c = Peek();
+      if (c == '{' || c == '[') {
+        ++pos_;
+        if (depth == MAX_DEPTH) Fail("Nesting too deep");
+        const bool isObject = c == '{';
+        stack[depth++] = isObject ? Container::Object : Container::Array;
+        isObject ? handler.StartObject() : handler.StartArray();
+
+        SkipWhitespace();
+        if (Peek() == (isObject ? '}' : ']')) {
+          ++pos_;
+          --depth;
+          isObject ? handler.EndObject() : handler.EndArray();
+        } else {
+          needKey = isObject;
+          continue;
+        }
+      } else if (c == '"') {
+        ++pos_;
+        handler.String(ParseString());
+      } else if (c == 't') {
+        ExpectLiteral("true");
+        handler.Bool(true);
+      } else if (c == 'f') {
+        ExpectLiteral("false");
+        handler.Bool(false);
+      } else if (c == 'n') {
+        ExpectLiteral("null");
+        handler.Null();
+      } else if (c == '-' || (c >= '0' && c <= '9')) {
+        ParseNumber(handler);
+      } else {
+        Fail("Unexpected character");
+      }
+
+      // After a value: separators and closing brackets
+      while (true) {
+        SkipWhitespace();
+        if (depth == 0) {
+          if (pos_ != text_.size()) Fail("Trailing characters after document");
+          return;
+        }
+        const char next = Peek();
+        ++pos_;
+        if (next == ',') {
+          needKey = stack[depth - 1] == Container::Object;
+          break;
+        }
+        if (next == '}' && stack[depth - 1] == Container::Object) {
+          --depth;
+          handler.EndObject();
+        } else if (next == ']' && stack[depth - 1] == Container::Array) {
+          --depth;
+          handler.EndArray();
+        } else {
+          --pos_;
+          Fail("Expected ',' or closing bracket");
+        }
+      }
+    }
+  }
+
+ private:
+  char Peek() const {
+    if (pos_ >= text_.size()) Fail("Unexpected end of input");
+    return text_[pos_];
+  }
+
+  void SkipWhitespace() {
+    while (pos_ < text_.size() && IsWhitespace(text_[pos_])) ++pos_;
+  }
+
+  void Expect(char c) {
+    if (Peek() != c) Fail(std::string("Expected '") + c + "'");
+    ++pos_;
+  }
+
+  void ExpectLiteral(std::string_view literal) {
+    if (text_.substr(pos_, literal.size()) != literal) Fail("Invalid literal");
+    pos_ += literal.size();
+  }
+
+  [[noreturn]] void Fail(const std::string& message) const { throw ParseError(message, pos_); }
+
+  // Called with pos_ just past the opening quote
+  std::string_view ParseString() {
+    const size_t start = pos_;
+    while (pos_ < text_.size()) {
+      const char c = text_[pos_];
+      if (c == '"') {
+        return text_.substr(start, pos_++ - start);
+      }
+      if (c == '\\') break;
+      if (static_cast<unsigned char>(c) < 0x20) Fail("Control character in string");
+      ++pos_;
+    }
+
+    // Slow path: decode escapes into the scratch buffer
+    scratch_.assign(text_.data() + start, pos_ - start);
+    while (true) {
+      const char c = Peek();
+      ++pos_;
+      if (c == '"') return scratch_;
+      if (static_cast<unsigned char>(c) < 0x20) Fail("Control character in string");
+      if (c != '\\') {
+        scratch_.push_back(c);
+        continue;
+      }
+
+      const char escape = Peek();
+      ++pos_;
+      switch (escape) {
+        case '"':
+        case '\\':
+        case '/':
+          scratch_.push_back(escape);
+          break;
+        case 'b':
+          scratch_.push_back('\b');
+          break;
+        case 'f':
+          scratch_.push_back('\f');
+          break;
+        case 'n':
+          scratch_.push_back('\n');
+          break;
+        case 'r':
+          scratch_.push_back('\r');
+          break;
+        case 't':
+          scratch_.push_back('\t');
+          break;
+        case 'u': {
+          uint32_t codepoint = ParseHex4();
+          if (codepoint >= 0xD800 && codepoint < 0xDC00) {
+            ExpectLiteral("\\u");
+            const uint32_t low = ParseHex4();
+            if (low < 0xDC00 || low >= 0xE000) Fail("Invalid surrogate pair");
+            codepoint = 0x10000 + ((codepoint - 0xD800) << 10) + (low - 0xDC00);
+          }
+          AppendUtf8(scratch_, codepoint);
+          break;
+        }
+        default:
+          Fail("Invalid escape sequence");
+      }
+    }
+  }
+
+  uint32_t ParseHex4() {
+    if (pos_ + 4 > text_.size()) Fail("Truncated \\u escape");
+    uint32_t value = 0;
+    const auto result = std::from_chars(text_.data() + pos_, text_.data() + pos_ + 4, value, 16);
+    if (result.ptr != text_.data() + pos_ + 4) Fail("Invalid \\u escape");
+    pos_ += 4;
+    return value;
+  }
+
+  template <typename Handler>
+  void ParseNumber(Handler& handler) {
+    const size_t start = pos_;
+    bool isInteger = true;
+    if (text_[pos_] == '-') ++pos_;
+    while (pos_ < text_.size()) {
+      const char c = text_[pos_];
+      if (c >= '0' && c <= '9') {
+        ++pos_;
+      } else if (c == '.' || c == 'e' || c == 'E' || c == '+' || c == '-') {
+        isInteger = false;
+        ++pos_;
+      } else {
+        break;
+      }
+    }
+
+    const char* first = text_.data() + start;
+    const char* last = text_.data() + pos_;
+    if (isInteger) {
+      int64_t value = 0;
+      const auto result = std::from_chars(first, last, value);
+      if (result.ec == std::errc() && result.ptr == last) {
+        handler.Integer(value);
+        return;
+      }
+    }
+    double value = 0.0;
+    const auto result = std::from_chars(first, last, value);
+    if (result.ec != std::errc() || result.ptr != last) {
+      pos_ = start;
+      Fail("Invalid number");
+    }
+    handler.Double(value);
+  }
+
+  std::string_view text_;
+  std::string& scratch_;
+  size_t pos_ = 0;
+};
+}  // namespace detail
+
+/**
+ * Parses one complete JSON document
+ * @throws ParseError on malformed input
+ */
+template <typename Handler>
+void Parse(std::string_view text, Handler& handler, std::string& scratch) {
+  detail::Parser(text, scratch).Run(handler);
+}
+}  // namespace JsonSax
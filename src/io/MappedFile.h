@@ -0,0 +1,33 @@
+#pragma once
+#include <cstddef>
+#include <span>
+#include <string>
+
+/**
+ * Read-only memory mapping of a whole file
+ *
+ * Pages are faulted in on access, so opening a large run archive is O(1)
+ * and only the runs actually visited are read from disk.
+ */
+class MappedFile {
+ public:
+  /**
+   * @throws std::runtime_error if the file cannot be opened or mapped
+   */
+  explicit MappedFile(const std::string& path);
+  ~MappedFile();
+
+  MappedFile(const MappedFile&) = delete;
+  MappedFile& operator=(const MappedFile&) = delete;
+  MappedFile(MappedFile&& other) noexcept;
+  MappedFile& operator=(MappedFile&& other) noexcept;
+
+  std::span<const std::byte> GetBytes() const { return {data_, size_}; }
+  size_t GetSize() const { return size_; }
+
+ private:
+  void Unmap();
+
+  const std::byte* data_ = nullptr;
+  size_t size_ = 0;
+};
@@ -0,0 +1,540 @@
+#include "io/PackedRunArchive.h"
+
+#include <algorithm>
+#include <bit>
+#include <charconv>
+#include <cmath>
+#include <cstring>
+#include <stdexcept>
+
+#include "io/Endian.h"
+
+namespace {
+using Endian::LoadFloatLE;
+using Endian::LoadLE;
+using Endian::StoreFloatLE;
+using Endian::StoreLE;
+using NodeIndex = RunGraph::NodeIndex;
+
+constexpr uint8_t FLAG_GENERATOR_IDS = 1;
+constexpr uint8_t FLAG_EXITS = 2;
+constexpr uint8_t FLAG_REWARDS = 4;
+
+constexpr size_t BLOCK_SIZE = PackedRunFormat::BLOCK_SIZE;
+constexpr size_t EXIT_SIZE = 9;
+constexpr uint8_t GOD_COUNT = static_cast<uint8_t>(Reward::God::Chaos) + 1;
+
+constexpr uint64_t ZigZag(int64_t value) {
+  return (static_cast<uint64_t>(value) << 1) ^ static_cast<uint64_t>(value >> 63);
+}
+
+constexpr int64_t UnZigZag(uint64_t value) {
+  return static_cast<int64_t>(value >> 1) ^ -static_cast<int64_t>(value & 1);
+}
+
+// The id PathGenerator gives room index: "room_<index + 1>"
+std::string_view GeneratorId(size_t index, char (&buffer)[RoomId::MAX_LENGTH]) {
+  constexpr std::string_view prefix = "room_";
+  std::memcpy(buffer, prefix.data(), prefix.size());
+  const auto result = std::to_chars(buffer + prefix.size(), buffer + sizeof(buffer), index + 1);
+  return {buffer, static_cast<size_t>(result.ptr - buffer)};
+}
+
+uint32_t QuantizeDifficulty(float difficulty) {
+  if (!(difficulty > 0.0f)) return 0;  // Also maps NaN to 0
+  const float clamped = std::min(difficulty, PackedRunFormat::MAX_DIFFICULTY);
+  return static_cast<uint32_t>(std::lround(clamped * PackedRunFormat::DIFFICULTY_SCALE));
+}
+
+void PutVarint(std::vector<std::byte>& out, uint64_t value) {
+  while (value >= 0x80) {
+    out.push_back(static_cast<std::byte>(value | 0x80));
+    value >>= 7;
+  }
+  out.push_back(static_cast<std::byte>(value));
+}
+
+/**
+ * Frame-of-reference column: u8 width, zigzag varint minimum, then width
+ * bit-plane words per block of 64 values
+ */
+void PutColumn(std::vector<std::byte>& out, std::span<const int64_t> values) {
+  int64_t min = 0;
+  int64_t max = 0;
+  if (!values.empty()) {
+    const auto [low, high] = std::minmax_element(values.begin(), values.end());
+    min = *low;
+    max = *high;
+  }
+  const auto width = static_cast<size_t>(std::bit_width(static_cast<uint64_t>(max - min)));
+  out.push_back(static_cast<std::byte>(width));
+  PutVarint(out, ZigZag(min));
+  if (width == 0) return;
+
+  const size_t blocks = (values.size() + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  size_t cursor = out.size();
+  out.resize(cursor + blocks * width * sizeof(uint64_t));
+  for (size_t block = 0; block < blocks; ++block) {
+    uint64_t lanes[BLOCK_SIZE] = {};
+    const size_t begin = block * BLOCK_SIZE;
+    const size_t count = std::min(BLOCK_SIZE, values.size() - begin);
+    for (size_t i = 0; i < count; ++i) {
+      lanes[i] = static_cast<uint64_t>(values[begin + i] - min);
+    }
+    for (size_t bit = 0; bit < width; ++bit) {
+      uint64_t word = 0;
+      for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+        word |= ((lanes[i] >> bit) & 1) << i;
+      }
+      StoreLE<uint64_t>(out.data() + cursor, word);
+      cursor += sizeof(uint64_t);
+    }
+  }
+}
+
+/**
+ * Bounds-checked cursor over one blob
+ */
+class Reader {
+ public:
+  explicit Reader(std::span<const std::byte> bytes)
+      : begin_(bytes.data()), cursor_(bytes.data()), end_(bytes.data() + bytes.size()) {}
+
+  const std::byte* Take(size_t count) {
+    if (count > static_cast<size_t>(end_ - cursor_)) {
+      throw std::runtime_error("Packed run is truncated");
+    }
+    const std::byte* data = cursor_;
+    cursor_ += count;
+    return data;
+  }
+
+  uint8_t Byte() { return static_cast<uint8_t>(*Take(1)); }
+
+  uint64_t Varint() {
+    uint64_t value = 0;
+    for (int shift = 0; shift < 64; shift += 7) {
+      const uint8_t byte = Byte();
+      value |= static_cast<uint64_t>(byte & 0x7F) << shift;
+      if ((byte & 0x80) == 0) return value;
+    }
+    throw std::runtime_error("Packed run varint is too long");
+  }
+
+  size_t GetRemaining() const { return static_cast<size_t>(end_ - cursor_); }
+  size_t GetConsumed() const { return static_cast<size_t>(cursor_ - begin_); }
+
+ private:
+  const std::byte* begin_;
+  const std::byte* cursor_;
+  const std::byte* end_;
+};
+
+/**
+ * Unpacks a column written by PutColumn into out[0..count), passing each
+ * value through convert (which throws on values out of range)
+ */
+template <typename T, typename Convert>
+void GetColumn(Reader& reader, size_t count, std::vector<T>& out, Convert convert) {
+  const size_t width = reader.Byte();
+  if (width > 64) {
+    throw std::runtime_error("Packed run column is malformed");
+  }
+  const int64_t min = UnZigZag(reader.Varint());
+  out.resize(count);
+  if (width == 0) {
+    std::fill(out.begin(), out.end(), convert(min));
+    return;
+  }
+
+  const size_t blocks = (count + BLOCK_SIZE - 1) / BLOCK_SIZE;
+  const std::byte* words = reader.Take(blocks * width * sizeof(uint64_t));
+  for (size_t block = 0; block < blocks; ++block) {
+    uint64_t lanes[BLOCK_SIZE] = {};
+    for (size_t bit = 0; bit < width; ++bit) {
+      const uint64_t word = LoadLE<uint64_t>(words);
+      words += sizeof(uint64_t);
+      for (size_t i = 0; i < BLOCK_SIZE; ++i) {
+        lanes[i] |= ((word >> i) & 1) << bit;
+      }
+    }
+    const size_t begin = block * BLOCK_SIZE;
+    const size_t lanesUsed = std::min(BLOCK_SIZE, count - begin);
+    for (size_t i = 0; i < lanesUsed; ++i) {
+      out[begin + i] = convert(min + static_cast<int64_t>(lanes[i]));
+    }
+  }
+}
+
+template <typename T>
+auto InRange(int64_t limit, const char* what) {
+  return [limit, what](int64_t value) {
+    if (value < 0 || value >= limit) {
+      throw std::runtime_error(std::string("Packed run has an invalid ") + what);
+    }
+    return static_cast<T>(value);
+  };
+}
+
+// Turns a count column into CSR offsets in place; returns the total
+uint32_t CountsToOffsets(std::vector<uint32_t>& offsets) {
+  uint64_t total = 0;
+  for (uint32_t& offset : offsets) {
+    const uint32_t count = offset;
+    offset = static_cast<uint32_t>(total);
+    total += count;
+  }
+  if (total > UINT32_MAX) {
+    throw std::runtime_error("Packed run counts overflow");
+  }
+  offsets.push_back(static_cast<uint32_t>(total));
+  return static_cast<uint32_t>(total);
+}
+}  // namespace
+
+// PackedRunFormat implementation
+void PackedRunFormat::AppendTo(const RunGraph& graph, std::vector<std::byte>& out) {
+  const size_t nodeCount = graph.GetNodeCount();
+  const size_t base = out.size();
+
+  uint8_t flags = FLAG_GENERATOR_IDS;
+  char buffer[RoomId::MAX_LENGTH];
+  for (NodeIndex i = 0; i < nodeCount; ++i) {
+    const Room* room = graph.GetNode(i)->GetRoom();
+    if (room->GetId() != GeneratorId(i, buffer)) flags &= ~FLAG_GENERATOR_IDS;
+    if (room->GetExitCount() > 0) flags |= FLAG_EXITS;
+    if (!room->GetRewards().empty()) flags |= FLAG_REWARDS;
+  }
+
+  const RunGraph::Node* start = graph.GetStartNode();
+  if (start && !graph.Contains(start)) {
+    throw std::invalid_argument("Start node does not belong to this graph");
+  }
+  PutVarint(out, nodeCount);
+  PutVarint(out, graph.GetEdgeCount());
+  PutVarint(out, start ? uint64_t{start->GetIndex()} + 1 : 0);
+  out.push_back(static_cast<std::byte>(flags));
+
+  // Per-room columns
+  std::vector<int64_t> column(nodeCount);
+  auto putField = [&](auto field) {
+    for (NodeIndex i = 0; i < nodeCount; ++i) {
+      column[i] = field(graph.GetNode(i));
+    }
+    PutColumn(out, column);
+  };
+  using Node = RunGraph::Node;
+  putField([](const Node* node) { return static_cast<int64_t>(node->GetRoom()->GetType()); });
+  putField([](const Node* node) { return static_cast<int64_t>(node->GetRoom()->GetBiome()); });
+  putField([](const Node* node) { return int64_t{node->IsOnCriticalPath()}; });
+  putField([](const Node* node) { return int64_t{node->GetDepth()}; });
+  putField([](const Node* node) {
+    return int64_t{QuantizeDifficulty(node->GetRoom()->GetDifficulty())};
+  });
+  putField([](const Node* node) { return static_cast<int64_t>(node->GetNextRooms().size()); });
+
+  // Edge targets as zigzag deltas from the expected next target
+  for (NodeIndex i = 0; i < nodeCount; ++i) {
+    int64_t expected = int64_t{i} + 1;
+    for (const RunGraph::Node* next : graph.GetNode(i)->GetNextRooms()) {
+      if (!graph.Contains(next)) {
+        out.resize(base);
+        throw std::invalid_argument("Edge targets a node that does not belong to this graph");
+      }
+      const int64_t target = next->GetIndex();
+      PutVarint(out, ZigZag(target - expected));
+      expected = target + 1;
+    }
+  }
+
+  if (!(flags & FLAG_GENERATOR_IDS)) {
+    for (NodeIndex i = 0; i < nodeCount; ++i) {
+      const std::string_view id = graph.GetNode(i)->GetRoom()->GetId();
+      PutVarint(out, id.size());
+      const auto* chars = reinterpret_cast<const std::byte*>(id.data());
+      out.insert(out.end(), chars, chars + id.size());
+    }
+  }
+
+  if (flags & FLAG_EXITS) {
+    putField([](const Node* node) { return static_cast<int64_t>(node->GetRoom()->GetExitCount()); });
+    for (NodeIndex i = 0; i < nodeCount; ++i) {
+      for (const Room::Exit& exit : graph.GetNode(i)->GetRoom()->GetExits()) {
+        const size_t cursor = out.size();
+        out.resize(cursor + EXIT_SIZE);
+        StoreFloatLE(out.data() + cursor, exit.position.x);
+        StoreFloatLE(out.data() + cursor + 4, exit.position.y);
+        out[cursor + 8] = static_cast<std::byte>(exit.direction);
+      }
+    }
+  }
+
+  if (flags & FLAG_REWARDS) {
+    putField([](const Node* node) { return static_cast<int64_t>(node->GetRoom()->GetRewards().size()); });
+    for (NodeIndex i = 0; i < nodeCount; ++i) {
+      for (const Reward::Data& reward : graph.GetNode(i)->GetRoom()->GetRewards()) {
+        out.push_back(static_cast<std::byte>(reward.type));
+        out.push_back(static_cast<std::byte>(reward.god));
+        PutVarint(out, ZigZag(reward.quantity));
+      }
+    }
+  }
+}
+
+size_t PackedRunFormat::Decode(std::span<const std::byte> bytes, PackedRun& run,
+                               size_t maxNodeCount) {
+  Reader reader(bytes);
+  const uint64_t nodeCount = reader.Varint();
+  const uint64_t edgeCount = reader.Varint();
+  const uint64_t start = reader.Varint();
+  const uint8_t flags = reader.Byte();
+  // Every edge takes at least one byte
+  if (nodeCount >= RunGraph::INVALID_INDEX || edgeCount > reader.GetRemaining() ||
+      start > nodeCount) {
+    throw std::runtime_error("Packed run header is malformed");
+  }
+  if (nodeCount > maxNodeCount) {
+    throw std::runtime_error("Packed run has more rooms than the decode limit");
+  }
+  const auto count = static_cast<size_t>(nodeCount);
+  run.startIndex = start == 0 ? RunGraph::INVALID_INDEX : static_cast<NodeIndex>(start - 1);
+
+  GetColumn(reader, count, run.types,
+            InRange<Room::Type>(static_cast<int64_t>(Room::TYPE_COUNT), "room type"));
+  GetColumn(reader, count, run.biomes,
+            InRange<Biome::Type>(static_cast<int64_t>(Biome::COUNT), "biome"));
+  GetColumn(reader, count, run.critical, InRange<uint8_t>(2, "critical flag"));
+  GetColumn(reader, count, run.depths, [](int64_t value) {
+    if (value < INT32_MIN || value > INT32_MAX) {
+      throw std::runtime_error("Packed run has an invalid depth");
+    }
+    return static_cast<int32_t>(value);
+  });
+  GetColumn(reader, count, run.difficulties, [](int64_t value) {
+    if (value < 0 || value > UINT16_MAX) {
+      throw std::runtime_error("Packed run has an invalid difficulty");
+    }
+    return static_cast<float>(value) / PackedRunFormat::DIFFICULTY_SCALE;
+  });
+
+  GetColumn(reader, count, run.edgeOffsets, InRange<uint32_t>(INT64_C(1) << 32, "degree"));
+  if (CountsToOffsets(run.edgeOffsets) != edgeCount) {
+    throw std::runtime_error("Packed run edge count does not match its degrees");
+  }
+  run.edgeTargets.resize(static_cast<size_t>(edgeCount));
+  for (size_t i = 0; i < count; ++i) {
+    int64_t expected = static_cast<int64_t>(i) + 1;
+    for (uint32_t e = run.edgeOffsets[i]; e < run.edgeOffsets[i + 1]; ++e) {
+      const int64_t target = expected + UnZigZag(reader.Varint());
+      if (target < 0 || target >= static_cast<int64_t>(count)) {
+        throw std::runtime_error("Packed run edge target is out of range");
+      }
+      run.edgeTargets[e] = static_cast<NodeIndex>(target);
+      expected = target + 1;
+    }
+  }
+
+  run.idData.clear();
+  run.idOffsets.clear();
+  if (!(flags & FLAG_GENERATOR_IDS)) {
+    run.idOffsets.reserve(count + 1);
+    for (size_t i = 0; i < count; ++i) {
+      run.idOffsets.push_back(static_cast<uint32_t>(run.idData.size()));
+      const uint64_t length = reader.Varint();
+      if (length == 0 || length > RoomId::MAX_LENGTH) {
+        throw std::runtime_error("Packed run has an invalid room id");
+      }
+      const auto* chars = reinterpret_cast<const char*>(reader.Take(static_cast<size_t>(length)));
+      run.idData.append(chars, static_cast<size_t>(length));
+    }
+    run.idOffsets.push_back(static_cast<uint32_t>(run.idData.size()));
+  }
+
+  run.exitOffsets.clear();
+  run.exits.clear();
+  if (flags & FLAG_EXITS) {
+    GetColumn(reader, count, run.exitOffsets,
+              InRange<uint32_t>(static_cast<int64_t>(Room::MAX_EXITS) + 1, "exit count"));
+    const uint32_t exitCount = CountsToOffsets(run.exitOffsets);
+    const std::byte* data = reader.Take(size_t{exitCount} * EXIT_SIZE);
+    run.exits.resize(exitCount);
+    for (Room::Exit& exit : run.exits) {
+      if (static_cast<uint8_t>(data[8]) > static_cast<uint8_t>(Room::Direction::West)) {
+        throw std::runtime_error("Packed run has an invalid exit direction");
+      }
+      exit = {glm::vec2(LoadFloatLE(data), LoadFloatLE(data + 4)),
+              static_cast<Room::Direction>(data[8])};
+      data += EXIT_SIZE;
+    }
+  }
+
+  run.rewardOffsets.clear();
+  run.rewards.clear();
+  if (flags & FLAG_REWARDS) {
+    GetColumn(reader, count, run.rewardOffsets, InRange<uint32_t>(INT64_C(1) << 32, "reward count"));
+    const uint32_t rewardCount = CountsToOffsets(run.rewardOffsets);
+    if (rewardCount > reader.GetRemaining() / 3) {
+      throw std::runtime_error("Packed run is truncated");
+    }
+    run.rewards.resize(rewardCount);
+    for (Reward::Data& reward : run.rewards) {
+      const uint8_t type = reader.Byte();
+      const uint8_t god = reader.Byte();
+      if (type >= Reward::TYPE_COUNT || god >= GOD_COUNT) {
+        throw std::runtime_error("Packed run has an invalid reward");
+      }
+      reward = Reward::Data(static_cast<Reward::Type>(type), static_cast<Reward::God>(god));
+      const int64_t quantity = UnZigZag(reader.Varint());
+      if (quantity < INT32_MIN || quantity > INT32_MAX) {
+        throw std::runtime_error("Packed run has an invalid reward");
+      }
+      reward.quantity = static_cast<int>(quantity);
+    }
+  }
+  return reader.GetConsumed();
+}
+
+// PackedRun implementation
+RoomId PackedRun::GetId(RunGraph::NodeIndex index) const {
+  if (idOffsets.empty()) {
+    char buffer[RoomId::MAX_LENGTH];
+    return RoomId(GeneratorId(index, buffer));
+  }
+  return RoomId(std::string_view(idData).substr(idOffsets[index],
+                                                idOffsets[index + 1] - idOffsets[index]));
+}
+
+RunGraph PackedRun::ToRunGraph() const {
+  const size_t nodeCount = GetNodeCount();
+  RunGraph graph;
+  graph.Reserve(nodeCount, edgeTargets.size());
+
+  for (NodeIndex i = 0; i < nodeCount; ++i) {
+    RunGraph::Node* node = graph.AddRoom(GetId(i), types[i]);
+    node->SetDepth(depths[i]);
+    node->SetOnCriticalPath(critical[i] != 0);
+
+    Room* room = node->GetRoom();
+    room->SetBiome(biomes[i]);
+    room->SetDifficulty(difficulties[i]);
+    if (!exitOffsets.empty()) {
+      for (uint32_t e = exitOffsets[i]; e < exitOffsets[i + 1]; ++e) {
+        room->AddExit(exits[e].position, exits[e].direction);
+      }
+    }
+    if (!rewardOffsets.empty()) {
+      for (uint32_t r = rewardOffsets[i]; r < rewardOffsets[i + 1]; ++r) {
+        room->AddReward(rewards[r]);
+      }
+    }
+  }
+
+  for (NodeIndex i = 0; i < nodeCount; ++i) {
+    for (uint32_t e = edgeOffsets[i]; e < edgeOffsets[i + 1]; ++e) {
+      graph.Connect(graph.GetNode(i), graph.GetNode(edgeTargets[e]));
+    }
+  }
+
+  if (startIndex != RunGraph::INVALID_INDEX) {
+    graph.SetStartNode(graph.GetNode(startIndex));
+  }
+  graph.Finalize();
+  return graph;
+}
+
+// PackedRunArchiveWriter implementation
+PackedRunArchiveWriter::PackedRunArchiveWriter(std::ostream& out) : out_(out) {
+  std::byte header[PackedRunArchive::HEADER_SIZE] = {};
+  std::memcpy(header, PackedRunArchive::MAGIC, sizeof(PackedRunArchive::MAGIC));
+  StoreLE<uint16_t>(header + 4, PackedRunArchive::VERSION);
+  Write(header);
+}
+
+void PackedRunArchiveWriter::Add(const RunGraph& graph) {
+  if (finished_) {
+    throw std::logic_error("Cannot add runs to a finished archive");
+  }
+  scratch_.clear();
+  PackedRunFormat::AppendTo(graph, scratch_);
+  offsets_.push_back(position_);
+  Write(scratch_);
+}
+
+void PackedRunArchiveWriter::Finish() {
+  if (finished_) return;
+
+  const uint64_t indexOffset = position_;
+  scratch_.resize(offsets_.size() * sizeof(uint64_t) + PackedRunArchive::TRAILER_SIZE);
+  std::byte* cursor = scratch_.data();
+  for (uint64_t offset : offsets_) {
+    StoreLE<uint64_t>(cursor, offset);
+    cursor += sizeof(uint64_t);
+  }
+  StoreLE<uint64_t>(cursor, indexOffset);
+  StoreLE<uint64_t>(cursor + 8, offsets_.size());
+  std::memcpy(cursor + 16, PackedRunArchive::MAGIC, sizeof(PackedRunArchive::MAGIC));
+  StoreLE<uint32_t>(cursor + 20, PackedRunArchive::VERSION);
+  Write(scratch_);
+
+  out_.flush();
+  finished_ = true;
+}
+
+void PackedRunArchiveWriter::Write(std::span<const std::byte> bytes) {
+  out_.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  if (!out_) {
+    throw std::runtime_error("Failed to write packed run archive");
+  }
+  position_ += bytes.size();
+}
+
+// PackedRunArchiveView implementation
+PackedRunArchiveView::PackedRunArchiveView(std::span<const std::byte> bytes, size_t maxNodeCount)
+    : bytes_(bytes), maxNodeCount_(maxNodeCount) {
+  using namespace PackedRunArchive;
+
+  if (bytes.size() < HEADER_SIZE + TRAILER_SIZE ||
+      std::memcmp(bytes.data(), MAGIC, sizeof(MAGIC)) != 0) {
+    throw std::runtime_error("Not a packed run archive");
+  }
+
+  const std::byte* trailer = bytes.data() + bytes.size() - TRAILER_SIZE;
+  if (std::memcmp(trailer + 16, MAGIC, sizeof(MAGIC)) != 0) {
+    throw std::runtime_error("Packed run archive is truncated or unfinished");
+  }
+  if (LoadLE<uint32_t>(trailer + 20) != VERSION) {
+    throw std::runtime_error("Unsupported packed run archive version");
+  }
+
+  const uint64_t indexOffset = LoadLE<uint64_t>(trailer);
+  const uint64_t runCount = LoadLE<uint64_t>(trailer + 8);
+  const uint64_t indexEnd = bytes.size() - TRAILER_SIZE;
+  if (indexOffset < HEADER_SIZE || indexOffset > indexEnd ||
+      runCount > (indexEnd - indexOffset) / sizeof(uint64_t)) {
+    throw std::runtime_error("Packed run archive index is out of bounds");
+  }
+
+  index_ = bytes.data() + indexOffset;
+  runCount_ = static_cast<size_t>(runCount);
+}
+
+void PackedRunArchiveView::Decode(size_t index, PackedRun& run) const {
+  if (index >= runCount_) {
+    throw std::out_of_range("Run index out of range");
+  }
+  const uint64_t offset = LoadLE<uint64_t>(index_ + index * sizeof(uint64_t));
+  const auto indexOffset = static_cast<uint64_t>(index_ - bytes_.data());
+  if (offset < PackedRunArchive::HEADER_SIZE || offset >= indexOffset) {
+    throw std::runtime_error("Run offset is out of bounds");
+  }
+  // Runs never extend into the index
+  PackedRunFormat::Decode(bytes_.subspan(static_cast<size_t>(offset),
+                                         static_cast<size_t>(indexOffset - offset)),
+                          run, maxNodeCount_);
+}
+
+RunGraph PackedRunArchiveView::GetRun(size_t index) const {
+  PackedRun run;
+  Decode(index, run);
+  return run.ToRunGraph();
+}
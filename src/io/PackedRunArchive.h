@@ -0,0 +1,171 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <string>
+#include <vector>
+
+#include "core/RunGraph.h"
+
+/**
+ * Compact, lossy-in-difficulty encoding of a RunGraph
+ *
+ * A run is stored as columns. Per-room fields (type, biome, critical flag,
+ * depth, quantized difficulty, out-degree) are frame-of-reference coded:
+ * the column minimum as a varint, then each value minus that minimum in
+ * the fewest bits that hold the largest one. Values are packed in blocks
+ * of 64 as bit planes (word b holds bit b of all 64 values), so packing
+ * and unpacking are fixed-length loops the compiler vectorizes, and a
+ * constant column costs no bits at all.
+ *
+ * Edge targets follow as varints of zigzag deltas: a node's first target
+ * relative to the node after it, later ones relative to the previous
+ * target. Chains therefore cost one byte per edge.
+ *
+ * Room ids matching the generator's "room_<index + 1>" pattern are not
+ * stored. Exits and rewards are stored only for runs that have them.
+ * Difficulty is kept to 1/DIFFICULTY_SCALE in [0, MAX_DIFFICULTY];
+ * everything else round-trips exactly.
+ *
+ * Blob layout:
+ *   varint nodeCount, edgeCount, startIndex + 1 (0 = none); u8 flags
+ *   Columns  type, biome, critical, depth, difficulty, degree
+ *            (each: u8 bit width, zigzag varint minimum, width u64 words per block)
+ *   Edges    varint zigzag target deltas, in node order
+ *   Ids      (non-generator ids only) varint length + bytes per room
+ *   Exits    (if any) count column, then f32 x, f32 y, u8 direction per exit
+ *   Rewards  (if any) count column, then u8 type, u8 god, zigzag varint quantity
+ */
+namespace PackedRunFormat {
+constexpr int DIFFICULTY_SCALE = 256;
+constexpr float MAX_DIFFICULTY = 65535.0f / DIFFICULTY_SCALE;
+constexpr size_t BLOCK_SIZE = 64;
+// Default cap on a decoded run's rooms. Constant columns cost no bytes, so
+// a tiny malformed blob could otherwise claim billions of rooms.
+constexpr size_t DEFAULT_MAX_NODE_COUNT = size_t{1} << 20;
+}  // namespace PackedRunFormat
+
+/**
+ * A packed run decoded into flat columns, without Room or Node objects
+ *
+ * Vectors keep their capacity between decodes, so one PackedRun can be
+ * reused for a whole archive.
+ */
+struct PackedRun {
+  std::vector<Room::Type> types;
+  std::vector<Biome::Type> biomes;
+  std::vector<uint8_t> critical;  // 1 for critical-path rooms
+  std::vector<int32_t> depths;
+  std::vector<float> difficulties;
+  std::vector<uint32_t> edgeOffsets;  // CSR, nodeCount + 1 entries
+  std::vector<RunGraph::NodeIndex> edgeTargets;
+  RunGraph::NodeIndex startIndex = RunGraph::INVALID_INDEX;
+
+  // Empty when every id is the generator's; otherwise ids are concatenated
+  // into idData with room i at [idOffsets[i], idOffsets[i + 1])
+  std::string idData;
+  std::vector<uint32_t> idOffsets;
+
+  // Empty when no room has exits (rewards); otherwise CSR like the edges
+  std::vector<uint32_t> exitOffsets;
+  std::vector<Room::Exit> exits;
+  std::vector<uint32_t> rewardOffsets;
+  std::vector<Reward::Data> rewards;
+
+  size_t GetNodeCount() const { return types.size(); }
+  RoomId GetId(RunGraph::NodeIndex index) const;
+
+  // Builds an owning, finalized RunGraph
+  RunGraph ToRunGraph() const;
+};
+
+namespace PackedRunFormat {
+/**
+ * Appends the packed blob for a graph to out
+ * @throws std::invalid_argument if an edge targets a node outside the graph
+ */
+void AppendTo(const RunGraph& graph, std::vector<std::byte>& out);
+
+/**
+ * Decodes one blob into run, overwriting it
+ * @param maxNodeCount Largest room count accepted, checked before any
+ *   column is allocated
+ * @return Bytes consumed
+ * @throws std::runtime_error if the blob is truncated, malformed or has
+ *   more than maxNodeCount rooms
+ */
+size_t Decode(std::span<const std::byte> bytes, PackedRun& run,
+              size_t maxNodeCount = DEFAULT_MAX_NODE_COUNT);
+}  // namespace PackedRunFormat
+
+/**
+ * Archive of packed runs with an offset index, laid out like RunArchive:
+ *
+ *   Header   16 bytes: magic "TRPA", version u16, reserved
+ *   Runs     packed blobs back to back
+ *   Index    u64[runCount] absolute blob offsets
+ *   Trailer  24 bytes: indexOffset u64, runCount u64, magic "TRPA", version u32
+ */
+namespace PackedRunArchive {
+constexpr char MAGIC[4] = {'T', 'R', 'P', 'A'};
+constexpr uint16_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 16;
+constexpr size_t TRAILER_SIZE = 24;
+}  // namespace PackedRunArchive
+
+/**
+ * Streams packed runs into an archive
+ */
+class PackedRunArchiveWriter {
+ public:
+  /**
+   * @param out Binary output stream; must outlive the writer
+   */
+  explicit PackedRunArchiveWriter(std::ostream& out);
+
+  // @throws std::logic_error after Finish()
+  void Add(const RunGraph& graph);
+
+  // Writes the index and trailer; no more runs can be added afterwards
+  void Finish();
+
+  size_t GetRunCount() const { return offsets_.size(); }
+
+ private:
+  void Write(std::span<const std::byte> bytes);
+
+  std::ostream& out_;
+  std::vector<uint64_t> offsets_;
+  std::vector<std::byte> scratch_;
+  uint64_t position_ = 0;
+  bool finished_ = false;
+};
+
+/**
+ * Random access to the runs of a packed archive (e.g. an mmap'ed file)
+ */
+class PackedRunArchiveView {
+ public:
+  /**
+   * @param maxNodeCount Largest room count Decode() accepts per run
+   * @throws std::runtime_error if bytes is not a complete archive
+   */
+  explicit PackedRunArchiveView(std::span<const std::byte> bytes,
+                                size_t maxNodeCount = PackedRunFormat::DEFAULT_MAX_NODE_COUNT);
+
+  size_t GetRunCount() const { return runCount_; }
+
+  /**
+   * @throws std::out_of_range if index >= GetRunCount()
+   * @throws std::runtime_error if the run is malformed or too large
+   */
+  void Decode(size_t index, PackedRun& run) const;
+  RunGraph GetRun(size_t index) const;
+
+ private:
+  std::span<const std::byte> bytes_;
+  const std::byte* index_;
+  size_t runCount_;
+  size_t maxNodeCount_;
+};
@@ -0,0 +1,90 @@
+#include "io/RunArchive.h"
+
+#include <cstring>
+#include <stdexcept>
+
+#include "io/Endian.h"
+
+// RunArchiveWriter implementation
+RunArchiveWriter::RunArchiveWriter(std::ostream& out) : out_(out) {
+  std::byte header[RunArchive::HEADER_SIZE] = {};
+  std::memcpy(header, RunArchive::MAGIC, sizeof(RunArchive::MAGIC));
+  Endian::StoreLE<uint16_t>(header + 4, RunArchive::VERSION);
+  Write(header);
+}
+
+void RunArchiveWriter::Add(const RunGraph& graph) {
+  if (finished_) {
+    throw std::logic_error("Cannot add runs to a finished archive");
+  }
+  scratch_.clear();
+  RunGraphBinary::AppendTo(graph, scratch_);
+  offsets_.push_back(position_);
+  Write(scratch_);
+}
+
+void RunArchiveWriter::Finish() {
+  if (finished_) return;
+
+  const uint64_t indexOffset = position_;
+  scratch_.resize(offsets_.size() * sizeof(uint64_t) + RunArchive::TRAILER_SIZE);
+  std::byte* cursor = scratch_.data();
+  for (uint64_t offset : offsets_) {
+    Endian::StoreLE<uint64_t>(cursor, offset);
+    cursor += sizeof(uint64_t);
+  }
+  Endian::StoreLE<uint64_t>(cursor, indexOffset);
+  Endian::StoreLE<uint64_t>(cursor + 8, offsets_.size());
+  std::memcpy(cursor + 16, RunArchive::MAGIC, sizeof(RunArchive::MAGIC));
+  Endian::StoreLE<uint32_t>(cursor + 20, RunArchive::VERSION);
+  Write(scratch_);
+
+  out_.flush();
+  finished_ = true;
+}
+
+void RunArchiveWriter::Write(std::span<const std::byte> bytes) {
+  out_.write(reinterpret_cast<const char*>(bytes.data()), static_cast<std::streamsize>(bytes.size()));
+  if (!out_) {
+    throw std::runtime_error("Failed to write run archive");
+  }
+  position_ += bytes.size();
+}
+
+// RunArchiveView implementation
+RunArchiveView::RunArchiveView(std::span<const std::byte> bytes) : bytes_(bytes) {
+  if (bytes.size() < RunArchive::HEADER_SIZE + RunArchive::TRAILER_SIZE ||
+      std::memcmp(bytes.data(), RunArchive::MAGIC, sizeof(RunArchive::MAGIC)) != 0) {
+    throw std::runtime_error("Not a run archive");
+  }
+
+  const std::byte* trailer = bytes.data() + bytes.size() - RunArchive::TRAILER_SIZE;
+  if (std::memcmp(trailer + 16, RunArchive::MAGIC, sizeof(RunArchive::MAGIC)) != 0) {
+    throw std::runtime_error("Run archive is truncated or unfinished");
+  }
+  if (Endian::LoadLE<uint32_t>(trailer + 20) != RunArchive::VERSION) {
+    throw std::runtime_error("Unsupported run archive version");
+  }
+
+  const uint64_t indexOffset = Endian::LoadLE<uint64_t>(trailer);
+  const uint64_t runCount = Endian::LoadLE<uint64_t>(trailer + 8);
+  const uint64_t indexEnd = bytes.size() - RunArchive::TRAILER_SIZE;
+  if (indexOffset < RunArchive::HEADER_SIZE || indexOffset > indexEnd ||
+      runCount > (indexEnd - indexOffset) / sizeof(uint64_t)) {
+    throw std::runtime_error("Run archive index is out of bounds");
+  }
+
+  index_ = bytes.data() + indexOffset;
+  runCount_ = static_cast<size_t>(runCount);
+}
+
+RunGraphView RunArchiveView::GetRun(size_t index) const {
+  if (index >= runCount_) {
+    throw std::out_of_range("Run index out of range");
+  }
+  const uint64_t offset = Endian::LoadLE<uint64_t>(index_ + index * sizeof(uint64_t));
+  if (offset >= bytes_.size()) {
+    throw std::runtime_error("Run offset is out of bounds");
+  }
+  return RunGraphView(bytes_.subspan(static_cast<size_t>(offset)));
+}
@@ -0,0 +1,76 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <ostream>
+#include <span>
+#include <vector>
+
+#include "io/RunGraphBinary.h"
+
+/**
+ * Archive of many binary RunGraphs with an offset index
+ *
+ * Layout:
+ *   Header   16 bytes: magic "TRGA", version u16, reserved
+ *   Runs     RunGraphBinary blobs back to back (each 8-byte aligned)
+ *   Index    u64[runCount] absolute blob offsets
+ *   Trailer  24 bytes: indexOffset u64, runCount u64, magic "TRGA", version u32
+ *
+ * The index sits at the end so runs can be streamed out as they are
+ * generated; readers locate it from the fixed-size trailer.
+ */
+namespace RunArchive {
+constexpr char MAGIC[4] = {'T', 'R', 'G', 'A'};
+constexpr uint16_t VERSION = 1;
+constexpr size_t HEADER_SIZE = 16;
+constexpr size_t TRAILER_SIZE = 24;
+}  // namespace RunArchive
+
+/**
+ * Streams runs into an archive
+ */
+class RunArchiveWriter {
+ public:
+  /**
+   * @param out Binary output stream; must outlive the writer
+   */
+  explicit RunArchiveWriter(std::ostream& out);
+
+  // @throws std::logic_error after Finish()
+  void Add(const RunGraph& graph);
+
+  // Writes the index and trailer; no more runs can be added afterwards
+  void Finish();
+
+  size_t GetRunCount() const { return offsets_.size(); }
+
+ private:
+  void Write(std::span<const std::byte> bytes);
+
+  std::ostream& out_;
+  std::vector<uint64_t> offsets_;
+  std::vector<std::byte> scratch_;
+  uint64_t position_ = 0;
+  bool finished_ = false;
+};
+
+/**
+ * Zero-copy random access to the runs in an archive (e.g. an mmap'ed file)
+ */
+class RunArchiveView {
+ public:
+  /**
+   * @throws std::runtime_error if bytes is not a complete archive
+   */
+  explicit RunArchiveView(std::span<const std::byte> bytes);
+
+  size_t GetRunCount() const { return runCount_; }
+
+  // @throws std::out_of_range if index >= GetRunCount()
+  RunGraphView GetRun(size_t index) const;
+
+ private:
+  std::span<const std::byte> bytes_;
+  const std::byte* index_;
+  size_t runCount_;
+};
@@ -0,0 +1,338 @@
+#include "io/RunGraphBinary.h"
+
+#include <stdexcept>
+
+#include "io/Endian.h"
+
+namespace {
+using Endian::LoadFloatLE;
+using Endian::LoadLE;
+using Endian::StoreFloatLE;
+using Endian::StoreLE;
+using NodeIndex = RunGraph::NodeIndex;
+
+// Header field offsets
+constexpr size_t H_VERSION = 4;
+constexpr size_t H_HEADER_SIZE = 6;
+constexpr size_t H_NODE_COUNT = 8;
+constexpr size_t H_EDGE_COUNT = 12;
+constexpr size_t H_EXIT_COUNT = 16;
+constexpr size_t H_REWARD_COUNT = 20;
+constexpr size_t H_START_INDEX = 24;
+constexpr size_t H_TOTAL_SIZE = 32;
+constexpr size_t H_NODES = 40;
+constexpr size_t H_EDGE_OFFSETS = 44;
+constexpr size_t H_EDGE_TARGETS = 48;
+constexpr size_t H_EXITS = 52;
+constexpr size_t H_REWARDS = 56;
+
+// Node record field offsets
+constexpr size_t N_ID_LENGTH = 0;
+constexpr size_t N_ID = 1;
+constexpr size_t N_TYPE = 32;
+constexpr size_t N_BIOME = 33;
+constexpr size_t N_FLAGS = 34;
+constexpr size_t N_EXIT_COUNT = 35;
+constexpr size_t N_DEPTH = 36;
+constexpr size_t N_DIFFICULTY = 40;
+constexpr size_t N_FIRST_EXIT = 44;
+constexpr size_t N_FIRST_REWARD = 48;
+constexpr size_t N_REWARD_COUNT = 52;
+
+constexpr uint8_t FLAG_CRITICAL_PATH = 1;
+
+static_assert(N_ID + RoomId::MAX_LENGTH == N_TYPE, "Room id must fit its node record slot");
+
+constexpr size_t AlignUp(size_t value) {
+  return (value + RunGraphBinary::ALIGNMENT - 1) & ~(RunGraphBinary::ALIGNMENT - 1);
+}
+
+NodeIndex CheckedIndex(const RunGraph& graph, const RunGraph::Node* node) {
+  const NodeIndex index = node->GetIndex();
+  if (index >= graph.GetNodeCount() || graph.GetNode(index) != node) {
+    throw std::invalid_argument("Start node does not belong to this graph");
+  }
+  return index;
+}
+}  // namespace
+
+std::vector<std::byte> RunGraphBinary::Serialize(const RunGraph& graph) {
+  std::vector<std::byte> out;
+  AppendTo(graph, out);
+  return out;
+}
+
+void RunGraphBinary::AppendTo(const RunGraph& graph, std::vector<std::byte>& out) {
+  const size_t nodeCount = graph.GetNodeCount();
+  const size_t edgeCount = graph.GetEdgeCount();
+
+  size_t exitCount = 0;
+  size_t rewardCount = 0;
+  for (NodeIndex i = 0; i < nodeCount; ++i) {
+    exitCount += graph.GetNode(i)->GetRoom()->GetExitCount();
+    rewardCount += graph.GetNode(i)->GetRoom()->GetRewards().size();
+  }
+
+  // Section layout
+  const size_t nodesOffset = HEADER_SIZE;
+  const size_t edgeOffsetsOffset = AlignUp(nodesOffset + nodeCount * NODE_RECORD_SIZE);
+  const size_t edgeTargetsOffset = AlignUp(edgeOffsetsOffset + (nodeCount + 1) * sizeof(uint32_t));
+  const size_t exitsOffset = AlignUp(edgeTargetsOffset + edgeCount * sizeof(uint32_t));
+  const size_t rewardsOffset = AlignUp(exitsOffset + exitCount * EXIT_RECORD_SIZE);
+  const size_t totalSize = AlignUp(rewardsOffset + rewardCount * REWARD_RECORD_SIZE);
+  if (totalSize > UINT32_MAX) {
+    throw std::length_error("RunGraph is too large for the binary format");
+  }
+
+  const NodeIndex startIndex =
+      graph.GetStartNode() ? CheckedIndex(graph, graph.GetStartNode()) : RunGraph::INVALID_INDEX;
+
+  const size_t base = out.size();
+  out.resize(base + totalSize, std::byte{0});
+  std::byte* blob = out.data() + base;
+
+  // Header
+  std::memcpy(blob, MAGIC, sizeof(MAGIC));
+  StoreLE<uint16_t>(blob + H_VERSION, VERSION);
+  StoreLE<uint16_t>(blob + H_HEADER_SIZE, HEADER_SIZE);
+  StoreLE<uint32_t>(blob + H_NODE_COUNT, static_cast<uint32_t>(nodeCount));
+  StoreLE<uint32_t>(blob + H_EDGE_COUNT, static_cast<uint32_t>(edgeCount));
+  StoreLE<uint32_t>(blob + H_EXIT_COUNT, static_cast<uint32_t>(exitCount));
+  StoreLE<uint32_t>(blob + H_REWARD_COUNT, static_cast<uint32_t>(rewardCount));
+  StoreLE<uint32_t>(blob + H_START_INDEX, startIndex);
+  StoreLE<uint64_t>(blob + H_TOTAL_SIZE, totalSize);
+  StoreLE<uint32_t>(blob + H_NODES, static_cast<uint32_t>(nodesOffset));
+  StoreLE<uint32_t>(blob + H_EDGE_OFFSETS, static_cast<uint32_t>(edgeOffsetsOffset));
+  StoreLE<uint32_t>(blob + H_EDGE_TARGETS, static_cast<uint32_t>(edgeTargetsOffset));
+  StoreLE<uint32_t>(blob + H_EXITS, static_cast<uint32_t>(exitsOffset));
+  StoreLE<uint32_t>(blob + H_REWARDS, static_cast<uint32_t>(rewardsOffset));
+
+  // Nodes, edges, exits and rewards in one pass over node indices
+  uint32_t edge = 0;
+  uint32_t exit = 0;
+  uint32_t reward = 0;
+  for (NodeIndex i = 0; i < nodeCount; ++i) {
+    const RunGraph::Node* node = graph.GetNode(i);
+    const Room* room = node->GetRoom();
+    std::byte* record = blob + nodesOffset + i * NODE_RECORD_SIZE;
+
+    const std::string_view id = room->GetId();
+    record[N_ID_LENGTH] = static_cast<std::byte>(id.size());
+    std::memcpy(record + N_ID, id.data(), id.size());
+    record[N_TYPE] = static_cast<std::byte>(room->GetType());
+    record[N_BIOME] = static_cast<std::byte>(room->GetBiome());
+    record[N_FLAGS] = static_cast<std::byte>(node->IsOnCriticalPath() ? FLAG_CRITICAL_PATH : 0);
+    record[N_EXIT_COUNT] = static_cast<std::byte>(room->GetExitCount());
+    StoreLE<int32_t>(record + N_DEPTH, node->GetDepth());
+    StoreFloatLE(record + N_DIFFICULTY, room->GetDifficulty());
+    StoreLE<uint32_t>(record + N_FIRST_EXIT, exit);
+    StoreLE<uint32_t>(record + N_FIRST_REWARD, reward);
+    StoreLE<uint32_t>(record + N_REWARD_COUNT, static_cast<uint32_t>(room->GetRewards().size()));
+
+    StoreLE<uint32_t>(blob + edgeOffsetsOffset + i * sizeof(uint32_t), edge);
+    for (const RunGraph::Node* next : node->GetNextRooms()) {
+      const NodeIndex target = next->GetIndex();
+      if (target >= nodeCount || graph.GetNode(target) != next) {
+        out.resize(base);
+        throw std::invalid_argument("Edge targets a node that does not belong to this graph");
+      }
+      StoreLE<uint32_t>(blob + edgeTargetsOffset + edge * sizeof(uint32_t), target);
+      ++edge;
+    }
+
+    for (const Room::Exit& roomExit : room->GetExits()) {
+      std::byte* exitRecord = blob + exitsOffset + exit * EXIT_RECORD_SIZE;
+      StoreFloatLE(exitRecord, roomExit.position.x);
+      StoreFloatLE(exitRecord + 4, roomExit.position.y);
+      exitRecord[8] = static_cast<std::byte>(roomExit.direction);
+      ++exit;
+    }
+
+    for (const Reward::Data& data : room->GetRewards()) {
+      std::byte* rewardRecord = blob + rewardsOffset + reward * REWARD_RECORD_SIZE;
+      rewardRecord[0] = static_cast<std::byte>(data.type);
+      rewardRecord[1] = static_cast<std::byte>(data.god);
+      StoreLE<int32_t>(rewardRecord + 4, data.quantity);
+      ++reward;
+    }
+  }
+  StoreLE<uint32_t>(blob + edgeOffsetsOffset + nodeCount * sizeof(uint32_t), edge);
+}
+
+// RunGraphView implementation
+RunGraphView::RunGraphView(std::span<const std::byte> bytes) : data_(bytes.data()) {
+  using namespace RunGraphBinary;
+
+  if (bytes.size() < HEADER_SIZE || std::memcmp(data_, MAGIC, sizeof(MAGIC)) != 0) {
+    throw std::runtime_error("Not a binary RunGraph");
+  }
+  if (LoadLE<uint16_t>(data_ + H_VERSION) != VERSION) {
+    throw std::runtime_error("Unsupported binary RunGraph version");
+  }
+
+  const uint64_t totalSize = LoadLE<uint64_t>(data_ + H_TOTAL_SIZE);
+  if (totalSize < HEADER_SIZE || totalSize > bytes.size()) {
+    throw std::runtime_error("Binary RunGraph is truncated");
+  }
+  byteSize_ = static_cast<size_t>(totalSize);
+
+  nodeCount_ = LoadLE<uint32_t>(data_ + H_NODE_COUNT);
+  edgeCount_ = LoadLE<uint32_t>(data_ + H_EDGE_COUNT);
+  exitCount_ = LoadLE<uint32_t>(data_ + H_EXIT_COUNT);
+  rewardCount_ = LoadLE<uint32_t>(data_ + H_REWARD_COUNT);
+  startIndex_ = LoadLE<uint32_t>(data_ + H_START_INDEX);
+  if (startIndex_ != RunGraph::INVALID_INDEX && startIndex_ >= nodeCount_) {
+    throw std::runtime_error("Binary RunGraph start index is out of range");
+  }
+
+  auto section = [&](size_t field, uint64_t count, size_t recordSize) {
+    const uint64_t offset = LoadLE<uint32_t>(data_ + field);
+    if (offset < HEADER_SIZE || offset + count * recordSize > byteSize_) {
+      throw std::runtime_error("Binary RunGraph section is out of bounds");
+    }
+    return data_ + offset;
+  };
+  nodes_ = section(H_NODES, nodeCount_, NODE_RECORD_SIZE);
+  edgeOffsets_ = section(H_EDGE_OFFSETS, uint64_t{nodeCount_} + 1, sizeof(uint32_t));
+  edgeTargets_ = section(H_EDGE_TARGETS, edgeCount_, sizeof(uint32_t));
+  exits_ = section(H_EXITS, exitCount_, EXIT_RECORD_SIZE);
+  rewards_ = section(H_REWARDS, rewardCount_, REWARD_RECORD_SIZE);
+}
+
+RunGraphView::NodeView RunGraphView::GetNode(NodeIndex index) const {
+  return NodeView(this, nodes_ + size_t{index} * RunGraphBinary::NODE_RECORD_SIZE);
+}
+
+uint32_t RunGraphView::EdgeOffset(NodeIndex node) const {
+  return LoadLE<uint32_t>(edgeOffsets_ + size_t{node} * sizeof(uint32_t));
+}
+
+uint32_t RunGraphView::GetDegree(NodeIndex node) const {
+  return EdgeOffset(node + 1) - EdgeOffset(node);
+}
+
+RunGraphView::NodeIndex RunGraphView::GetSuccessor(NodeIndex node, uint32_t edge) const {
+  return LoadLE<uint32_t>(edgeTargets_ + (size_t{EdgeOffset(node)} + edge) * sizeof(uint32_t));
+}
+
+bool RunGraphView::VerifyIntegrity() const {
+  if (EdgeOffset(0) != 0 || EdgeOffset(nodeCount_) != edgeCount_) return false;
+
+  for (NodeIndex i = 0; i < nodeCount_; ++i) {
+    if (EdgeOffset(i) > EdgeOffset(i + 1)) return false;
+
+    const std::byte* record = nodes_ + size_t{i} * RunGraphBinary::NODE_RECORD_SIZE;
+    if (static_cast<size_t>(record[N_ID_LENGTH]) > RoomId::MAX_LENGTH) return false;
+    if (static_cast<uint8_t>(record[N_TYPE]) > static_cast<uint8_t>(Room::Type::Boss)) return false;
+    if (static_cast<uint8_t>(record[N_BIOME]) > static_cast<uint8_t>(Biome::Type::Styx)) return false;
+
+    const uint64_t exitEnd = uint64_t{LoadLE<uint32_t>(record + N_FIRST_EXIT)} +
+                             static_cast<uint8_t>(record[N_EXIT_COUNT]);
+    const uint64_t rewardEnd = uint64_t{LoadLE<uint32_t>(record + N_FIRST_REWARD)} +
+                               LoadLE<uint32_t>(record + N_REWARD_COUNT);
+    if (static_cast<uint8_t>(record[N_EXIT_COUNT]) > Room::MAX_EXITS || exitEnd > exitCount_ ||
+        rewardEnd > rewardCount_) {
+      return false;
+    }
+  }
+
+  for (uint32_t e = 0; e < edgeCount_; ++e) {
+    if (LoadLE<uint32_t>(edgeTargets_ + size_t{e} * sizeof(uint32_t)) >= nodeCount_) return false;
+  }
+
+  // Enum bytes are cast straight into Room::Direction and Reward enums
+  for (uint32_t x = 0; x < exitCount_; ++x) {
+    const std::byte* exitRecord = exits_ + size_t{x} * RunGraphBinary::EXIT_RECORD_SIZE;
+    if (static_cast<uint8_t>(exitRecord[8]) > static_cast<uint8_t>(Room::Direction::West)) {
+      return false;
+    }
+  }
+  for (uint32_t r = 0; r < rewardCount_; ++r) {
+    const std::byte* rewardRecord = rewards_ + size_t{r} * RunGraphBinary::REWARD_RECORD_SIZE;
+    if (static_cast<size_t>(rewardRecord[0]) >= Reward::TYPE_COUNT ||
+        static_cast<uint8_t>(rewardRecord[1]) > static_cast<uint8_t>(Reward::God::Chaos)) {
+      return false;
+    }
+  }
+  return true;
+}
+
+RunGraph RunGraphView::ToRunGraph() const {
+  RunGraph graph;
+  graph.Reserve(nodeCount_, edgeCount_);
+
+  for (NodeIndex i = 0; i < nodeCount_; ++i) {
+    const NodeView view = GetNode(i);
+    RunGraph::Node* node = graph.AddRoom(view.GetId(), view.GetType());
+    node->SetDepth(view.GetDepth());
+    node->SetOnCriticalPath(view.IsOnCriticalPath());
+
+    Room* room = node->GetRoom();
+    room->SetBiome(view.GetBiome());
+    room->SetDifficulty(view.GetDifficulty());
+    for (size_t e = 0; e < view.GetExitCount(); ++e) {
+      const Room::Exit exit = view.GetExit(e);
+      room->AddExit(exit.position, exit.direction);
+    }
+    for (size_t r = 0; r < view.GetRewardCount(); ++r) {
+      room->AddReward(view.GetReward(r));
+    }
+  }
+
+  for (NodeIndex i = 0; i < nodeCount_; ++i) {
+    for (uint32_t e = 0; e < GetDegree(i); ++e) {
+      graph.Connect(graph.GetNode(i), graph.GetNode(GetSuccessor(i, e)));
+    }
+  }
+
+  if (startIndex_ != RunGraph::INVALID_INDEX) {
+    graph.SetStartNode(graph.GetNode(startIndex_));
+  }
+  graph.Finalize();
+  return graph;
+}
+
+// NodeView implementation
+std::string_view RunGraphView::NodeView::GetId() const {
+  return {reinterpret_cast<const char*>(record_ + N_ID), static_cast<size_t>(record_[N_ID_LENGTH])};
+}
+
+Room::Type RunGraphView::NodeView::GetType() const {
+  return static_cast<Room::Type>(record_[N_TYPE]);
+}
+
+Biome::Type RunGraphView::NodeView::GetBiome() const {
+  return static_cast<Biome::Type>(record_[N_BIOME]);
+}
+
+float RunGraphView::NodeView::GetDifficulty() const { return LoadFloatLE(record_ + N_DIFFICULTY); }
+
+int RunGraphView::NodeView::GetDepth() const { return LoadLE<int32_t>(record_ + N_DEPTH); }
+
+bool RunGraphView::NodeView::IsOnCriticalPath() const {
+  return (static_cast<uint8_t>(record_[N_FLAGS]) & FLAG_CRITICAL_PATH) != 0;
+}
+
+size_t RunGraphView::NodeView::GetExitCount() const {
+  return static_cast<size_t>(record_[N_EXIT_COUNT]);
+}
+
+Room::Exit RunGraphView::NodeView::GetExit(size_t index) const {
+  const size_t exit = LoadLE<uint32_t>(record_ + N_FIRST_EXIT) + index;
+  const std::byte* exitRecord = graph_->exits_ + exit * RunGraphBinary::EXIT_RECORD_SIZE;
+  return {glm::vec2(LoadFloatLE(exitRecord), LoadFloatLE(exitRecord + 4)),
+          static_cast<Room::Direction>(exitRecord[8])};
+}
+
+size_t RunGraphView::NodeView::GetRewardCount() const {
+  return LoadLE<uint32_t>(record_ + N_REWARD_COUNT);
+}
+
+Reward::Data RunGraphView::NodeView::GetReward(size_t index) const {
+  const size_t reward = LoadLE<uint32_t>(record_ + N_FIRST_REWARD) + index;
+  const std::byte* rewardRecord = graph_->rewards_ + reward * RunGraphBinary::REWARD_RECORD_SIZE;
+  Reward::Data data(static_cast<Reward::Type>(rewardRecord[0]),
+                    static_cast<Reward::God>(rewardRecord[1]));
+  data.quantity = LoadLE<int32_t>(rewardRecord + 4);
+  return data;
+}
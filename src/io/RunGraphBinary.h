@@ -0,0 +1,129 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+#include <span>
+#include <string_view>
+#include <vector>
+
+#include "core/RunGraph.h"
+
+/**
+ * Versioned, little-endian, position-independent binary layout of a RunGraph
+ *
+ * Layout (all offsets relative to the start of the blob, sections 8-byte aligned):
+ *   Header        64 bytes (magic "TRGB", version, counts, section offsets)
+ *   Nodes         NODE_RECORD_SIZE bytes per node, in node index order
+ *   Edge offsets  uint32[nodeCount + 1] (CSR row offsets)
+ *   Edge targets  uint32[edgeCount]
+ *   Exits         EXIT_RECORD_SIZE bytes per exit, grouped by node
+ *   Rewards       REWARD_RECORD_SIZE bytes per reward, grouped by node
+ *
+ * Node record: idLength u8, id char[31], type u8, biome u8, flags u8
+ * (bit 0 = critical path), exitCount u8, depth i32, difficulty f32,
+ * firstExit u32, firstReward u32, rewardCount u32.
+ */
+namespace RunGraphBinary {
+constexpr char MAGIC[4] = {'T', 'R', 'G', 'B'};
+constexpr uint16_t VERSION = 1;
+
+constexpr size_t HEADER_SIZE = 64;
+constexpr size_t NODE_RECORD_SIZE = 56;
+constexpr size_t EXIT_RECORD_SIZE = 12;
+constexpr size_t REWARD_RECORD_SIZE = 8;
+constexpr size_t ALIGNMENT = 8;
+
+/**
+ * Serializes a graph (building or finalized) into a standalone blob
+ * @throws std::invalid_argument if an edge targets a node outside the graph
+ */
+std::vector<std::byte> Serialize(const RunGraph& graph);
+
+/**
+ * Appends the blob for a graph to out, reusing its capacity
+ */
+void AppendTo(const RunGraph& graph, std::vector<std::byte>& out);
+}  // namespace RunGraphBinary
+
+/**
+ * Read-only, zero-copy view over a serialized RunGraph
+ *
+ * Works directly on the bytes (e.g. an mmap'ed file); nothing is copied or
+ * converted into Room/Node objects. Construction only checks the header and
+ * section bounds, in O(1); call VerifyIntegrity() before traversing data
+ * from an untrusted source. The underlying bytes must outlive the view.
+ */
+class RunGraphView {
+ public:
+  using NodeIndex = RunGraph::NodeIndex;
+
+  /**
+   * Lightweight handle to one node record
+   */
+  class NodeView {
+   public:
+    std::string_view GetId() const;
+    Room::Type GetType() const;
+    Biome::Type GetBiome() const;
+    float GetDifficulty() const;
+    int GetDepth() const;
+    bool IsOnCriticalPath() const;
+
+    size_t GetExitCount() const;
+    Room::Exit GetExit(size_t index) const;
+
+    size_t GetRewardCount() const;
+    Reward::Data GetReward(size_t index) const;
+
+   private:
+    friend class RunGraphView;
+    NodeView(const RunGraphView* graph, const std::byte* record) : graph_(graph), record_(record) {}
+
+    const RunGraphView* graph_;
+    const std::byte* record_;
+  };
+
+  /**
+   * @throws std::runtime_error on bad magic, unsupported version or
+   *         sections that fall outside bytes
+   */
+  explicit RunGraphView(std::span<const std::byte> bytes);
+
+  size_t GetNodeCount() const { return nodeCount_; }
+  size_t GetEdgeCount() const { return edgeCount_; }
+  NodeIndex GetStartIndex() const { return startIndex_; }
+  size_t GetByteSize() const { return byteSize_; }
+
+  NodeView GetNode(NodeIndex index) const;
+
+  // CSR adjacency
+  uint32_t GetDegree(NodeIndex node) const;
+  NodeIndex GetSuccessor(NodeIndex node, uint32_t edge) const;
+
+  /**
+   * Full O(V + E) check that edge offsets, targets and exit/reward ranges
+   * stay inside their sections, and that every enum byte (room type,
+   * biome, exit direction, reward type and god) is in range
+   */
+  bool VerifyIntegrity() const;
+
+  /**
+   * Builds an owning, finalized RunGraph from the view
+   */
+  RunGraph ToRunGraph() const;
+
+ private:
+  uint32_t EdgeOffset(NodeIndex node) const;
+
+  const std::byte* data_;
+  size_t byteSize_;
+  uint32_t nodeCount_;
+  uint32_t edgeCount_;
+  uint32_t exitCount_;
+  uint32_t rewardCount_;
+  NodeIndex startIndex_;
+  const std::byte* nodes_;
+  const std::byte* edgeOffsets_;
+  const std::byte* edgeTargets_;
+  const std::byte* exits_;
+  const std::byte* rewards_;
+};
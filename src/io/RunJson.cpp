@@ -0,0 +1,649 @@
+#include "io/RunJson.h"
+
+#include <array>
+#include <charconv>
+#include <cmath>
+#include <optional>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+#include "io/JsonSax.h"
+
+namespace {
+using NodeIndex = RunGraph::NodeIndex;
+
+// ---------------------------------------------------------------------------
+// Writing
+// ---------------------------------------------------------------------------
+
+bool NeedsEscape(char c) { return c == '"' || c == '\\' || static_cast<unsigned char>(c) < 0x20; }
+
+void AppendString(std::string& out, std::string_view value) {
+  out.push_back('"');
+  size_t clean = 0;
+  while (clean < value.size() && !NeedsEscape(value[clean])) ++clean;
+  out.append(value.data(), clean);
+
+  constexpr char HEX[] = "0123456789abcdef";
+  for (size_t i = clean; i < value.size(); ++i) {
+    const char c = value[i];
+    switch (c) {
+      case '"':
+        out += "\\\"";
+        break;
+      case '\\':
+        out += "\\\\";
+        break;
+      case '\n':
+        out += "\\n";
+        break;
+      case '\r':
+        out += "\\r";
+        break;
+      case '\t':
+        out += "\\t";
+        break;
+      default:
+        if (static_cast<unsigned char>(c) < 0x20) {
+          out += "\\u00";
+          out.push_back(HEX[(c >> 4) & 0xF]);
+          out.push_back(HEX[c & 0xF]);
+        } else {
+          out.push_back(c);
+        }
+    }
+  }
+  out.push_back('"');
+}
+
+template <typename T>
+void AppendNumber(std::string& out, T value) {
+  if constexpr (std::is_floating_point_v<T>) {
+    if (!std::isfinite(value)) {
+      throw std::invalid_argument("Non-finite numbers cannot be written as JSON");
+    }
+  }
+  char buffer[32];
+  const auto result = std::to_chars(buffer, buffer + sizeof(buffer), value);
+  out.append(buffer, result.ptr);
+}
+
+void AppendKey(std::string& out, std::string_view key) {
+  out.push_back('"');
+  out.append(key);
+  out += "\":";
+}
+
+// Room fields without the surrounding braces, shared by rooms and run nodes
+void AppendRoomFields(std::string& out, const Room& room) {
+  AppendKey(out, "id");
+  AppendString(out, room.GetId());
+  out.push_back(',');
+  AppendKey(out, "type");
+  AppendString(out, Room::TypeToString(room.GetType()));
+  out.push_back(',');
+  AppendKey(out, "biome");
+  AppendString(out, Biome::ToString(room.GetBiome()));
+  out.push_back(',');
+  AppendKey(out, "difficulty");
+  AppendNumber(out, room.GetDifficulty());
+
+  out.push_back(',');
+  AppendKey(out, "exits");
+  out.push_back('[');
+  bool first = true;
+  for (const Room::Exit& exit : room.GetExits()) {
+    if (!first) out.push_back(',');
+    first = false;
+    out += "{\"x\":";
+    AppendNumber(out, exit.position.x);
+    out += ",\"y\":";
+    AppendNumber(out, exit.position.y);
+    out += ",\"dir\":";
+    AppendString(out, Room::DirectionToString(exit.direction));
+    out.push_back('}');
+  }
+  out.push_back(']');
+
+  out.push_back(',');
+  AppendKey(out, "rewards");
+  out.push_back('[');
+  first = true;
+  for (const Reward::Data& reward : room.GetRewards()) {
+    if (!first) out.push_back(',');
+    first = false;
+    RunJson::AppendReward(out, reward);
+  }
+  out.push_back(']');
+}
+
+// ---------------------------------------------------------------------------
+// Reading
+// ---------------------------------------------------------------------------
+
+[[noreturn]] void SchemaError(const std::string& message) { throw std::runtime_error(message); }
+
+template <typename Enum, typename ToString>
+Enum EnumFromName(std::string_view name, Enum last, ToString toString, const char* what) {
+  for (uint8_t i = 0; i <= static_cast<uint8_t>(last); ++i) {
+    const auto value = static_cast<Enum>(i);
+    if (name == toString(value)) return value;
+  }
+  SchemaError(std::string("Unknown ") + what + ": " + std::string(name));
+}
+
+/**
+ * SAX handler that assembles runs, rooms or rewards from parser events
+ */
+class RunBuilder {
+ public:
+  enum class Root : uint8_t { Run, Room, Reward };
+
+  explicit RunBuilder(Root root) : root_(root) {}
+
+  RunGraph TakeRun() {
+    RequireComplete();
+    return std::move(graph_);
+  }
+  Room TakeRoom() {
+    RequireComplete();
+    return std::move(*room_);
+  }
+  Reward::Data TakeReward() const {
+    RequireComplete();
+    return reward_;
+  }
+
+  void StartObject() {
+    if (skipDepth_ > 0) {
+      ++skipDepth_;
+      return;
+    }
+    if (depth_ == 0) {
+      Push(root_ == Root::Run      ? Context::Run
+           : root_ == Root::Room ? Context::Room
+                                 : Context::Reward);
+      BeginContext(Top());
+      return;
+    }
+    switch (Top()) {
+      case Context::Rooms:
+        Push(Context::Room);
+        break;
+      case Context::Exits:
+        Push(Context::Exit);
+        break;
+      case Context::Rewards:
+        Push(Context::Reward);
+        break;
+      case Context::Next:
+        SchemaError("Edge index must be an integer");
+      default:
+        SkipOrFail("Unexpected object");
+        return;
+    }
+    BeginContext(Top());
+  }
+
+  void EndObject() {
+    if (skipDepth_ > 0) {
+      --skipDepth_;
+      return;
+    }
+    EndContext(Pop());
+    complete_ = depth_ == 0;
+  }
+
+  void StartArray() {
+    if (skipDepth_ > 0) {
+      ++skipDepth_;
+      return;
+    }
+    if (depth_ > 0 && Top() == Context::Run && field_ == Field::Rooms) {
+      Push(Context::Rooms);
+    } else if (depth_ > 0 && Top() == Context::Room && field_ == Field::Exits) {
+      Push(Context::Exits);
+    } else if (depth_ > 0 && Top() == Context::Room && field_ == Field::Rewards) {
+      Push(Context::Rewards);
+    } else if (depth_ > 0 && Top() == Context::Room && field_ == Field::Next) {
+      Push(Context::Next);
+    } else {
+      RequireOutsideEdgeList();
+      SkipOrFail("Unexpected array");
+    }
+  }
+
+  void EndArray() {
+    if (skipDepth_ > 0) {
+      --skipDepth_;
+      return;
+    }
+    Pop();
+  }
+
+  void Key(std::string_view key) {
+    if (skipDepth_ > 0) return;
+    field_ = FieldFor(Top(), key);
+  }
+
+  void String(std::string_view value) {
+    if (skipDepth_ > 0) return;
+    RequireOutsideEdgeList();
+    if (field_ == Field::Unknown) return;
+    switch (field_) {
+      case Field::Id:
+        if (value.size() > RoomId::MAX_LENGTH) {
+          SchemaError("Room id exceeds " + std::to_string(RoomId::MAX_LENGTH) + " characters");
+        }
+        pending_.id = RoomId(value);
+        pending_.hasId = true;
+        break;
+      case Field::Type:
+        if (Top() == Context::Reward) {
+          reward_.type = EnumFromName(value, Reward::Type::ChaosGate,
+                                      [](Reward::Type t) { return Reward::ToString(t); }, "reward type");
+          hasRewardType_ = true;
+        } else {
+          pending_.type = EnumFromName(value, Room::Type::Boss, Room::TypeToString, "room type");
+          pending_.hasType = true;
+        }
+        break;
+      case Field::Biome:
+        pending_.biome = EnumFromName(value, Biome::Type::Styx, Biome::ToString, "biome");
+        break;
+      case Field::Dir:
+        exit_.direction = EnumFromName(value, Room::Direction::West, Room::DirectionToString, "direction");
+        hasExitDirection_ = true;
+        break;
+      case Field::God:
+        reward_.god = value.empty() ? Reward::God::None : Reward::GodFromString(value);
+        break;
+      default:
+        SchemaError("Unexpected string value");
+    }
+  }
+
+  void Integer(int64_t value) {
+    if (skipDepth_ > 0) return;
+    if (depth_ > 0 && Top() == Context::Next) {
+      if (value < 0 || value >= RunGraph::INVALID_INDEX) SchemaError("Edge index out of range");
+      edges_.emplace_back(static_cast<NodeIndex>(graph_.GetNodeCount()), static_cast<NodeIndex>(value));
+      return;
+    }
+    switch (field_) {
+      case Field::Start:
+        if (value < 0 || value >= RunGraph::INVALID_INDEX) SchemaError("Start index out of range");
+        start_ = static_cast<NodeIndex>(value);
+        break;
+      case Field::Depth:
+        pending_.depth = static_cast<int>(value);
+        break;
+      case Field::Quantity:
+        reward_.quantity = static_cast<int>(value);
+        break;
+      default:
+        Double(static_cast<double>(value));
+    }
+  }
+
+  void Double(double value) {
+    if (skipDepth_ > 0) return;
+    RequireOutsideEdgeList();
+    if (field_ == Field::Unknown) return;
+    switch (field_) {
+      case Field::Difficulty:
+        pending_.difficulty = static_cast<float>(value);
+        break;
+      case Field::X:
+        exit_.position.x = static_cast<float>(value);
+        break;
+      case Field::Y:
+        exit_.position.y = static_cast<float>(value);
+        break;
+      default:
+        SchemaError("Unexpected number value");
+    }
+  }
+
+  void Bool(bool value) {
+    if (skipDepth_ > 0) return;
+    RequireOutsideEdgeList();
+    if (field_ == Field::Unknown) return;
+    if (field_ != Field::Critical) SchemaError("Unexpected boolean value");
+    pending_.critical = value;
+  }
+
+  void Null() {
+    if (skipDepth_ > 0) return;
+    RequireOutsideEdgeList();
+    if (field_ == Field::Unknown) return;
+    SchemaError("Unexpected null value");
+  }
+
+ private:
+  enum class Context : uint8_t { Run, Rooms, Room, Exits, Exit, Rewards, Reward, Next };
+
+  enum class Field : uint8_t {
+    Unknown,
+    Start,
+    Rooms,
+    Id,
+    Type,
+    Biome,
+    Difficulty,
+    Exits,
+    Rewards,
+    Depth,
+    Critical,
+    Next,
+    X,
+    Y,
+    Dir,
+    God,
+    Quantity
+  };
+
+  struct PendingRoom {
+    RoomId id;
+    bool hasId = false;
+    Room::Type type = Room::Type::Combat;
+    bool hasType = false;
+    Biome::Type biome = Biome::Type::Tartarus;
+    float difficulty = 1.0f;
+    int depth = 0;
+    bool critical = false;
+    std::array<Room::Exit, Room::MAX_EXITS> exits{};
+    size_t exitCount = 0;
+    Reward::List rewards;
+  };
+
+  static Field FieldFor(Context context, std::string_view key) {
+    switch (context) {
+      case Context::Run:
+        if (key == "start") return Field::Start;
+        if (key == "rooms") return Field::Rooms;
+        break;
+      case Context::Room:
+        if (key == "id") return Field::Id;
+        if (key == "type") return Field::Type;
+        if (key == "biome") return Field::Biome;
+        if (key == "difficulty") return Field::Difficulty;
+        if (key == "exits") return Field::Exits;
+        if (key == "rewards") return Field::Rewards;
+        if (key == "depth") return Field::Depth;
+        if (key == "critical") return Field::Critical;
+        if (key == "next") return Field::Next;
+        break;
+      case Context::Exit:
+        if (key == "x") return Field::X;
+        if (key == "y") return Field::Y;
+        if (key == "dir") return Field::Dir;
+        break;
+      case Context::Reward:
+        if (key == "type") return Field::Type;
+        if (key == "god") return Field::God;
+        if (key == "quantity") return Field::Quantity;
+        break;
+      default:
+        break;
+    }
+    return Field::Unknown;
+  }
+
+  void RequireComplete() const {
+    if (!complete_) SchemaError("Document is not a JSON object");
+  }
+
+  Context Top() const { return stack_[depth_ - 1]; }
+
+  void Push(Context context) {
+    stack_[depth_++] = context;
+    field_ = Field::Unknown;
+  }
+
+  Context Pop() {
+    field_ = Field::Unknown;
+    return stack_[--depth_];
+  }
+
+  // Unknown keys may hold any value; anything else out of place is an error
+  // "next" holds only integer node indices; anything else would drop an edge
+  void RequireOutsideEdgeList() const {
+    if (depth_ > 0 && Top() == Context::Next) SchemaError("Edge index must be an integer");
+  }
+
+  void SkipOrFail(const char* message) {
+    if (depth_ > 0 && field_ == Field::Unknown) {
+      skipDepth_ = 1;
+    } else {
+      SchemaError(message);
+    }
+  }
+
+  void BeginContext(Context context) {
+    switch (context) {
+      case Context::Room:
+        pending_ = PendingRoom();
+        break;
+      case Context::Exit:
+        exit_ = Room::Exit{};
+        hasExitDirection_ = false;
+        break;
+      case Context::Reward:
+        reward_ = Reward::Data();
+        hasRewardType_ = false;
+        break;
+      default:
+        break;
+    }
+  }
+
+  void EndContext(Context context) {
+    switch (context) {
+      case Context::Exit:
+        if (!hasExitDirection_) SchemaError("Exit is missing dir");
+        if (pending_.exitCount == Room::MAX_EXITS) SchemaError("Room has too many exits");
+        pending_.exits[pending_.exitCount++] = exit_;
+        break;
+      case Context::Reward:
+        if (!hasRewardType_) SchemaError("Reward is missing type");
+        if (depth_ > 0) pending_.rewards.push_back(reward_);
+        break;
+      case Context::Room:
+        CommitRoom();
+        break;
+      case Context::Run:
+        CommitRun();
+        break;
+      default:
+        break;
+    }
+  }
+
+  Room BuildRoom() const {
+    if (!pending_.hasId || !pending_.hasType) SchemaError("Room is missing id or type");
+    Room room(pending_.id, pending_.type);
+    room.SetBiome(pending_.biome);
+    room.SetDifficulty(pending_.difficulty);
+    for (size_t i = 0; i < pending_.exitCount; ++i) {
+      room.AddExit(pending_.exits[i].position, pending_.exits[i].direction);
+    }
+    for (const Reward::Data& reward : pending_.rewards) {
+      room.AddReward(reward);
+    }
+    return room;
+  }
+
+  void CommitRoom() {
+    if (root_ == Root::Room) {
+      room_.emplace(BuildRoom());
+      return;
+    }
+    RunGraph::Node* node = graph_.AddRoom(BuildRoom());
+    node->SetDepth(pending_.depth);
+    node->SetOnCriticalPath(pending_.critical);
+  }
+
+  void CommitRun() {
+    const size_t nodeCount = graph_.GetNodeCount();
+    for (const auto& [from, to] : edges_) {
+      if (to >= nodeCount) SchemaError("Edge targets a missing room");
+      graph_.Connect(graph_.GetNode(from), graph_.GetNode(to));
+    }
+    if (start_) {
+      if (*start_ >= nodeCount) SchemaError("Start index out of range");
+      graph_.SetStartNode(graph_.GetNode(*start_));
+    }
+    graph_.Finalize();
+  }
+
+  Root root_;
+  bool complete_ = false;
+  std::array<Context, JsonSax::MAX_DEPTH> stack_{};
+  size_t depth_ = 0;
+  size_t skipDepth_ = 0;
+  Field field_ = Field::Unknown;
+
+  PendingRoom pending_;
+  Room::Exit exit_{};
+  bool hasExitDirection_ = false;
+  Reward::Data reward_;
+  bool hasRewardType_ = false;
+
+  RunGraph graph_;
+  std::vector<std::pair<NodeIndex, NodeIndex>> edges_;
+  std::optional<NodeIndex> start_;
+  std::optional<Room> room_;
+};
+}  // namespace
+
+// ---------------------------------------------------------------------------
+// RunJson
+// ---------------------------------------------------------------------------
+
+void RunJson::AppendReward(std::string& out, const Reward::Data& reward) {
+  out += "{\"type\":";
+  AppendString(out, Reward::ToString(reward.type));
+  if (reward.god != Reward::God::None) {
+    out += ",\"god\":";
+    AppendString(out, reward.GodName());
+  }
+  out += ",\"quantity\":";
+  AppendNumber(out, reward.quantity);
+  out.push_back('}');
+}
+
+void RunJson::AppendRoom(std::string& out, const Room& room) {
+  out.push_back('{');
+  AppendRoomFields(out, room);
+  out.push_back('}');
+}
+
+void RunJson::AppendRun(std::string& out, const RunGraph& graph) {
+  const size_t nodeCount = graph.GetNodeCount();
+  const size_t base = out.size();
+
+  const RunGraph::Node* start = graph.GetStartNode();
+  if (start && !graph.Contains(start)) {
+    throw std::invalid_argument("Start node does not belong to this graph");
+  }
+
+  out.push_back('{');
+  if (start) {
+    AppendKey(out, "start");
+    AppendNumber(out, start->GetIndex());
+    out.push_back(',');
+  }
+  AppendKey(out, "rooms");
+  out.push_back('[');
+  for (NodeIndex i = 0; i < nodeCount; ++i) {
+    const RunGraph::Node* node = graph.GetNode(i);
+    if (i > 0) out.push_back(',');
+    out.push_back('{');
+    AppendRoomFields(out, *node->GetRoom());
+    out += ",\"depth\":";
+    AppendNumber(out, node->GetDepth());
+    out += ",\"critical\":";
+    out += node->IsOnCriticalPath() ? "true" : "false";
+    out += ",\"next\":[";
+    bool first = true;
+    for (const RunGraph::Node* next : node->GetNextRooms()) {
+      const NodeIndex target = next->GetIndex();
+      if (target >= nodeCount || graph.GetNode(target) != next) {
+        out.resize(base);
+        throw std::invalid_argument("Edge targets a node that does not belong to this graph");
+      }
+      if (!first) out.push_back(',');
+      first = false;
+      AppendNumber(out, target);
+    }
+    out += "]}";
+  }
+  out += "]}";
+}
+
+Reward::Data RunJson::ParseReward(std::string_view json) {
+  RunBuilder builder(RunBuilder::Root::Reward);
+  std::string scratch;
+  JsonSax::Parse(json, builder, scratch);
+  return builder.TakeReward();
+}
+
+Room RunJson::ParseRoom(std::string_view json) {
+  RunBuilder builder(RunBuilder::Root::Room);
+  std::string scratch;
+  JsonSax::Parse(json, builder, scratch);
+  return builder.TakeRoom();
+}
+
+RunGraph RunJson::ParseRun(std::string_view json) {
+  RunBuilder builder(RunBuilder::Root::Run);
+  std::string scratch;
+  JsonSax::Parse(json, builder, scratch);
+  return builder.TakeRun();
+}
+
+// ---------------------------------------------------------------------------
+// NDJSON streaming
+// ---------------------------------------------------------------------------
+
+NdjsonRunWriter::~NdjsonRunWriter() {
+  try {
+    Flush();
+  } catch (...) {
+    // Destructors must not throw; call Flush() explicitly to observe errors
+  }
+}
+
+void NdjsonRunWriter::Write(const RunGraph& graph) {
+  RunJson::AppendRun(buffer_, graph);
+  buffer_.push_back('\n');
+  if (buffer_.size() >= FLUSH_THRESHOLD) {
+    Flush();
+  }
+}
+
+void NdjsonRunWriter::Flush() {
+  if (buffer_.empty()) return;
+  out_.write(buffer_.data(), static_cast<std::streamsize>(buffer_.size()));
+  buffer_.clear();
+  if (!out_) {
+    throw std::runtime_error("Failed to write NDJSON runs");
+  }
+}
+
+bool NdjsonRunReader::Next(RunGraph& graph) {
+  while (std::getline(in_, line_)) {
+    ++lineNumber_;
+    if (line_.find_first_not_of(" \t\r") == std::string::npos) continue;
+
+    try {
+      graph = RunJson::ParseRun(line_);
+    } catch (const std::exception& e) {
+      throw std::runtime_error("NDJSON line " + std::to_string(lineNumber_) + ": " + e.what());
+    }
+    return true;
+  }
+  return false;
+}
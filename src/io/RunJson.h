@@ -0,0 +1,83 @@
+#pragma once
+#include <cstddef>
+#include <istream>
+#include <ostream>
+#include <string>
+#include <string_view>
+
+#include "core/RunGraph.h"
+
+/**
+ * Streaming JSON encoding of runs, rooms and rewards (no DOM)
+ *
+ * Run schema (one run per line in NDJSON files):
+ *   {"start":0,"rooms":[{"id":"room_1","type":"Combat","biome":"Tartarus",
+ *     "difficulty":1,"exits":[{"x":10,"y":0,"dir":"North"}],
+ *     "rewards":[{"type":"Boon","god":"Zeus","quantity":1}],
+ *     "depth":0,"critical":true,"next":[1]}, ...]}
+ *
+ * Rooms appear in node index order; "next" holds successor indices and
+ * "start" is omitted when the graph has no start node. Unknown keys are
+ * skipped when reading.
+ */
+namespace RunJson {
+// Writers append to out without clearing it
+void AppendReward(std::string& out, const Reward::Data& reward);
+void AppendRoom(std::string& out, const Room& room);
+// @throws std::invalid_argument if the start node or an edge target is not in the graph
+void AppendRun(std::string& out, const RunGraph& graph);
+
+// Readers parse exactly one JSON document
+// @throws JsonSax::ParseError on malformed JSON, std::runtime_error on schema errors
+Reward::Data ParseReward(std::string_view json);
+Room ParseRoom(std::string_view json);
+RunGraph ParseRun(std::string_view json);
+}  // namespace RunJson
+
+/**
+ * Writes runs as NDJSON through a bounded output buffer
+ */
+class NdjsonRunWriter {
+ public:
+  static constexpr size_t FLUSH_THRESHOLD = 1 << 20;
+
+  explicit NdjsonRunWriter(std::ostream& out) : out_(out) {}
+  ~NdjsonRunWriter();
+
+  NdjsonRunWriter(const NdjsonRunWriter&) = delete;
+  NdjsonRunWriter& operator=(const NdjsonRunWriter&) = delete;
+
+  void Write(const RunGraph& graph);
+
+  // @throws std::runtime_error if the stream fails
+  void Flush();
+
+ private:
+  std::ostream& out_;
+  std::string buffer_;
+};
+
+/**
+ * Reads NDJSON runs one line at a time
+ *
+ * Memory stays bounded by the longest line plus one run, whatever the
+ * file size. Blank lines are skipped.
+ */
+class NdjsonRunReader {
+ public:
+  explicit NdjsonRunReader(std::istream& in) : in_(in) {}
+
+  /**
+   * Reads the next run into graph
+   * @return false at end of input
+   * @throws std::runtime_error (with the line number) on malformed lines
+   */
+  bool Next(RunGraph& graph);
+
+  size_t GetLineNumber() const { return lineNumber_; }
+
+ private:
+  std::istream& in_;
+  std::string line_;
+  size_t lineNumber_ = 0;
+};
@@ -0,0 +1,136 @@
+#pragma once
+#include <array>
+#include <cstdint>
+#include <limits>
+
+/**
+ * Philox4x32-10 counter-based generator (Salmon et al., "Parallel Random
+ * Numbers: As Easy as 1, 2, 3")
+ *
+ * Output is a pure function of (key, counter): there is no hidden state to
+ * advance, so any position of any stream can be computed directly and in
+ * parallel. Results are identical on every platform and standard library.
+ */
+namespace Philox {
+using Counter = std::array<uint32_t, 4>;
+using Key = std::array<uint32_t, 2>;
+
+constexpr uint32_t MULTIPLIER_0 = 0xD2511F53;
+constexpr uint32_t MULTIPLIER_1 = 0xCD9E8D57;
+constexpr uint32_t WEYL_0 = 0x9E3779B9;
+constexpr uint32_t WEYL_1 = 0xBB67AE85;
+constexpr int ROUNDS = 10;
+
+constexpr Counter Generate(Counter counter, Key key) {
+  for (int round = 0; round < ROUNDS; ++round) {
+    const uint64_t product0 = uint64_t{MULTIPLIER_0} * counter[0];
+    const uint64_t product1 = uint64_t{MULTIPLIER_1} * counter[2];
+    counter = {static_cast<uint32_t>(product1 >> 32) ^ counter[1] ^ key[0],
+               static_cast<uint32_t>(product1),
+               static_cast<uint32_t>(product0 >> 32) ^ counter[3] ^ key[1],
+               static_cast<uint32_t>(product0)};
+    key[0] += WEYL_0;
+    key[1] += WEYL_1;
+  }
+  return counter;
+}
+}  // namespace Philox
+
+/**
+ * Distributions defined only in terms of an engine's 32-bit outputs
+ *
+ * Unlike std::uniform_int_distribution, whose algorithm is left to the
+ * standard library, these give the same values for the same engine output
+ * everywhere. Engines must produce uniformly distributed 32-bit words.
+ */
+namespace PortableRandom {
+/**
+ * Uniform value in [0, range) using Lemire's multiply-and-reject method
+ * (one multiplication, a division only on the rare rejection path)
+ */
+template <typename Engine>
+uint32_t Bounded(Engine& engine, uint32_t range) {
+  if (range == 0) return 0;
+
+  uint64_t product = uint64_t{static_cast<uint32_t>(engine())} * range;
+  uint32_t low = static_cast<uint32_t>(product);
+  if (low < range) {
+    const uint32_t threshold = static_cast<uint32_t>(-range) % range;
+    while (low < threshold) {
+      product = uint64_t{static_cast<uint32_t>(engine())} * range;
+      low = static_cast<uint32_t>(product);
+    }
+  }
+  return static_cast<uint32_t>(product >> 32);
+}
+
+/**
+ * Uniform integer in [min, max] (inclusive, min <= max)
+ */
+template <typename Engine>
+int UniformInt(Engine& engine, int min, int max) {
+  const uint64_t span = static_cast<uint64_t>(static_cast<int64_t>(max) - min) + 1;
+  const uint32_t offset = span > std::numeric_limits<uint32_t>::max()
+                              ? static_cast<uint32_t>(engine())
+                              : Bounded(engine, static_cast<uint32_t>(span));
+  return static_cast<int>(static_cast<int64_t>(min) + offset);
+}
+
+/**
+ * Uniform float in [0, 1) with 24 bits of precision
+ */
+template <typename Engine>
+float UniformFloat(Engine& engine) {
+  return static_cast<float>(static_cast<uint32_t>(engine()) >> 8) * 0x1.0p-24f;
+}
+}  // namespace PortableRandom
+
+/**
+ * Philox-backed random stream keyed by (seed, index, stream)
+ *
+ * index is typically a room index and stream separates independent uses
+ * within a room, so every room's choices can be drawn without generating
+ * the rooms before it. Satisfies UniformRandomBitGenerator. The state is a
+ * few words, and Discard() jumps ahead in O(1).
+ */
+class CounterRng {
+ public:
+  using result_type = uint32_t;
+
+  CounterRng(uint64_t seed, uint32_t index, uint32_t stream = 0)
+      : key_{static_cast<uint32_t>(seed), static_cast<uint32_t>(seed >> 32)},
+        index_(index),
+        stream_(stream) {}
+
+  static constexpr result_type min() { return 0; }
+  static constexpr result_type max() { return std::numeric_limits<result_type>::max(); }
+
+  result_type operator()() {
+    if (position_ >> 2 != bufferBlock_) {
+      Refill(position_ >> 2);
+    }
+    return buffer_[position_++ & 3];
+  }
+
+  // Skips count outputs without generating them
+  void Discard(uint64_t count) { position_ += count; }
+  uint64_t GetPosition() const { return position_; }
+
+  uint32_t Bounded(uint32_t range) { return PortableRandom::Bounded(*this, range); }
+  int UniformInt(int min, int max) { return PortableRandom::UniformInt(*this, min, max); }
+  float UniformFloat() { return PortableRandom::UniformFloat(*this); }
+
+ private:
+  void Refill(uint64_t block) {
+    buffer_ = Philox::Generate(
+        {static_cast<uint32_t>(block), static_cast<uint32_t>(block >> 32), index_, stream_}, key_);
+    bufferBlock_ = block;
+  }
+
+  Philox::Key key_;
+  uint32_t index_;
+  uint32_t stream_;
+  uint64_t position_ = 0;  // Outputs consumed; four per Philox block
+  uint64_t bufferBlock_ = UINT64_MAX;
+  Philox::Counter buffer_{};
+};
@@ -0,0 +1,128 @@
+#include "util/GenerationStats.h"
+
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cmath>
+
+uint64_t GenerationStats::GetTotalNanos() const {
+  uint64_t total = 0;
+  for (const uint64_t nanos : phaseNanos) total += nanos;
+  return total;
+}
+
+const char* GenerationStats::PhaseToString(Phase phase) {
+  switch (phase) {
+    case Phase::RoomTypes:
+      return "RoomTypes";
+    case Phase::Placement:
+      return "Placement";
+    case Phase::BranchPlan:
+      return "BranchPlan";
+    case Phase::Build:
+      return "Build";
+    case Phase::Finalize:
+      return "Finalize";
+    case Phase::Validate:
+      return "Validate";
+  }
+  return "Unknown";
+}
+
+namespace Stats {
+namespace {
+std::atomic<AllocationCounter> allocationCounter{nullptr};
+}  // namespace
+
+void SetAllocationCounter(AllocationCounter counter) {
+  allocationCounter.store(counter, std::memory_order_release);
+}
+
+uint64_t ReadAllocationCounter() {
+  const AllocationCounter counter = allocationCounter.load(std::memory_order_acquire);
+  return counter ? counter() : 0;
+}
+}  // namespace Stats
+
+// StatsHistogram implementation
+size_t StatsHistogram::BucketIndex(uint64_t value) {
+  if (value < SUB_BUCKETS) return static_cast<size_t>(value);
+
+  // Top SUB_BUCKET_BITS + 1 significant bits pick the bucket
+  const int exponent = std::bit_width(value) - 1;
+  const int shift = exponent - SUB_BUCKET_BITS;
+  const auto mantissa = static_cast<size_t>((value >> shift) & (SUB_BUCKETS - 1));
+  return SUB_BUCKETS * static_cast<size_t>(shift + 1) + mantissa;
+}
+
+uint64_t StatsHistogram::BucketUpperBound(size_t index) {
+  if (index < SUB_BUCKETS) return index;
+
+  const size_t shift = index / SUB_BUCKETS - 1;
+  const uint64_t mantissa = index % SUB_BUCKETS;
+  const uint64_t lower = (SUB_BUCKETS + mantissa) << shift;
+  return lower + ((uint64_t{1} << shift) - 1);
+}
+
+void StatsHistogram::Record(uint64_t value) {
+  ++buckets_[BucketIndex(value)];
+  ++count_;
+  sum_ += value;
+  min_ = std::min(min_, value);
+  max_ = std::max(max_, value);
+}
+
+void StatsHistogram::Merge(const StatsHistogram& other) {
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    buckets_[i] += other.buckets_[i];
+  }
+  count_ += other.count_;
+  sum_ += other.sum_;
+  min_ = std::min(min_, other.min_);
+  max_ = std::max(max_, other.max_);
+}
+
+uint64_t StatsHistogram::GetPercentile(double percentile) const {
+  if (count_ == 0) return 0;
+
+  const double clamped = std::clamp(percentile, 0.0, 100.0);
+  const auto rank = std::max<uint64_t>(
+      1, static_cast<uint64_t>(std::ceil(clamped / 100.0 * static_cast<double>(count_))));
+  uint64_t seen = 0;
+  for (size_t i = 0; i < BUCKET_COUNT; ++i) {
+    seen += buckets_[i];
+    if (seen >= rank) {
+      return std::min(BucketUpperBound(i), max_);
+    }
+  }
+  return max_;
+}
+
+// StatsAggregator implementation
+void StatsAggregator::Add(const GenerationStats& stats) {
+  for (size_t i = 0; i < GenerationStats::PHASE_COUNT; ++i) {
+    phases_[i].Record(stats.phaseNanos[i]);
+    totals_.phaseNanos[i] += stats.phaseNanos[i];
+  }
+  total_.Record(stats.GetTotalNanos());
+
+  totals_.roomsCreated += stats.roomsCreated;
+  totals_.edgesCreated += stats.edgesCreated;
+  totals_.rngDraws += stats.rngDraws;
+  totals_.backtracks += stats.backtracks;
+  totals_.allocations += stats.allocations;
+}
+
+void StatsAggregator::Merge(const StatsAggregator& other) {
+  for (size_t i = 0; i < GenerationStats::PHASE_COUNT; ++i) {
+    phases_[i].Merge(other.phases_[i]);
+    totals_.phaseNanos[i] += other.totals_.phaseNanos[i];
+  }
+  total_.Merge(other.total_);
+
+  totals_.roomsCreated += other.totals_.roomsCreated;
+  totals_.edgesCreated += other.totals_.edgesCreated;
+  totals_.rngDraws += other.totals_.rngDraws;
+  totals_.backtracks += other.totals_.backtracks;
+  totals_.allocations += other.totals_.allocations;
+}
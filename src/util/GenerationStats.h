@@ -0,0 +1,164 @@
+#pragma once
+#include <array>
+#include <chrono>
+#include <cstddef>
+#include <cstdint>
+#include <vector>
+
+// Set by CMake (TARTARUS_ENABLE_STATS); 0 compiles every collection point away
+#ifndef TARTARUS_STATS
+#define TARTARUS_STATS 1
+#endif
+
+/**
+ * Per-run generation statistics
+ *
+ * Filled by PathGenerator and GraphValidator when a GenerationStats is
+ * attached with SetStats(). With TARTARUS_STATS=0 the timers and counters
+ * are empty inline code and nothing is recorded.
+ */
+struct GenerationStats {
+  enum class Phase : uint8_t {
+    RoomTypes,   // Run length and bulk room-type sampling
+    Placement,   // Placement constraint solving
+    BranchPlan,  // Branch decisions
+    Build,       // AddRoom/Connect for critical path and branches
+    Finalize,    // Packing into contiguous storage
+    Validate     // GraphValidator::Validate
+  };
+  static constexpr size_t PHASE_COUNT = static_cast<size_t>(Phase::Validate) + 1;
+
+  std::array<uint64_t, PHASE_COUNT> phaseNanos{};
+  uint64_t roomsCreated = 0;
+  uint64_t edgesCreated = 0;
+  uint64_t rngDraws = 0;     // 32-bit words consumed
+  uint64_t backtracks = 0;   // Rejected placement candidates
+  uint64_t allocations = 0;  // Only with an allocation counter installed (see Stats)
+
+  uint64_t GetPhaseNanos(Phase phase) const { return phaseNanos[static_cast<size_t>(phase)]; }
+  uint64_t GetTotalNanos() const;
+
+  static const char* PhaseToString(Phase phase);
+};
+
+namespace Stats {
+inline constexpr bool ENABLED = TARTARUS_STATS != 0;
+
+/**
+ * Process-wide allocation counter sampled around each run
+ *
+ * The library does not replace operator new itself; applications (or the
+ * test allocation harness) install a function returning a running count.
+ */
+using AllocationCounter = uint64_t (*)();
+void SetAllocationCounter(AllocationCounter counter);
+uint64_t ReadAllocationCounter();  // 0 when none is installed
+
+template <bool Enabled>
+class BasicPhaseTimer;
+
+/**
+ * Adds the scope's wall time to one phase of stats (if not null)
+ */
+template <>
+class BasicPhaseTimer<true> {
+ public:
+  BasicPhaseTimer(GenerationStats* stats, GenerationStats::Phase phase)
+      : stats_(stats), phase_(phase) {
+    if (stats_) start_ = std::chrono::steady_clock::now();
+  }
+  ~BasicPhaseTimer() {
+    if (stats_) {
+      const auto elapsed = std::chrono::steady_clock::now() - start_;
+      stats_->phaseNanos[static_cast<size_t>(phase_)] += static_cast<uint64_t>(
+          std::chrono::duration_cast<std::chrono::nanoseconds>(elapsed).count());
+    }
+  }
+
+  BasicPhaseTimer(const BasicPhaseTimer&) = delete;
+  BasicPhaseTimer& operator=(const BasicPhaseTimer&) = delete;
+
+ private:
+  GenerationStats* stats_;
+  GenerationStats::Phase phase_;
+  std::chrono::steady_clock::time_point start_;
+};
+
+template <>
+class BasicPhaseTimer<false> {
+ public:
+  BasicPhaseTimer(GenerationStats*, GenerationStats::Phase) {}
+};
+
+using PhaseTimer = BasicPhaseTimer<ENABLED>;
+
+// Adds value to a counter field of stats (if not null)
+inline void Add(GenerationStats* stats, uint64_t GenerationStats::*field, uint64_t value) {
+  if constexpr (ENABLED) {
+    if (stats) stats->*field += value;
+  }
+}
+}  // namespace Stats
+
+/**
+ * Log-linear histogram of non-negative integers (HDR-style)
+ *
+ * Values are grouped into 16 sub-buckets per power of two, so percentiles
+ * are accurate to within 1/16 (6.25%) of the value while memory stays
+ * fixed. Merging two histograms is exact.
+ */
+class StatsHistogram {
+ public:
+  static constexpr int SUB_BUCKET_BITS = 4;
+  static constexpr size_t SUB_BUCKETS = size_t{1} << SUB_BUCKET_BITS;
+  static constexpr size_t BUCKET_COUNT = SUB_BUCKETS * (64 - SUB_BUCKET_BITS + 1);
+
+  void Record(uint64_t value);
+  void Merge(const StatsHistogram& other);
+
+  uint64_t GetCount() const { return count_; }
+  uint64_t GetMin() const { return count_ ? min_ : 0; }
+  uint64_t GetMax() const { return max_; }
+  double GetMean() const { return count_ ? static_cast<double>(sum_) / count_ : 0.0; }
+
+  /**
+   * Smallest bucket bound below which at least percentile% of values fall
+   * @param percentile In [0, 100]
+   */
+  uint64_t GetPercentile(double percentile) const;
+
+ private:
+  static size_t BucketIndex(uint64_t value);
+  static uint64_t BucketUpperBound(size_t index);
+
+  std::array<uint64_t, BUCKET_COUNT> buckets_{};
+  uint64_t count_ = 0;
+  uint64_t sum_ = 0;
+  uint64_t min_ = UINT64_MAX;
+  uint64_t max_ = 0;
+};
+
+/**
+ * Aggregates GenerationStats over many runs
+ *
+ * Keeps a latency histogram per phase and for the whole run, plus counter
+ * totals. Aggregators from different threads can be merged.
+ */
+class StatsAggregator {
+ public:
+  void Add(const GenerationStats& stats);
+  void Merge(const StatsAggregator& other);
+
+  uint64_t GetRunCount() const { return total_.GetCount(); }
+  const StatsHistogram& GetTotalLatency() const { return total_; }
+  const StatsHistogram& GetPhaseLatency(GenerationStats::Phase phase) const {
+    return phases_[static_cast<size_t>(phase)];
+  }
+  // Counter sums across all runs (phaseNanos holds summed time)
+  const GenerationStats& GetTotals() const { return totals_; }
+
+ private:
+  std::array<StatsHistogram, GenerationStats::PHASE_COUNT> phases_;
+  StatsHistogram total_;
+  GenerationStats totals_;
+};
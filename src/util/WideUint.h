@@ -0,0 +1,126 @@
+#pragma once
+#include <array>
+#include <bit>
+#include <cstddef>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+/**
+ * Fixed-width unsigned integer of WORDS 64-bit words, least significant first
+ *
+ * Only the operations path counting needs: checked addition, comparison,
+ * subtraction of a smaller value and conversions. Addition throws instead
+ * of wrapping, so a count is either exact or reported as too large.
+ * Portable (no compiler-specific 128-bit types).
+ */
+template <size_t WORDS>
+class WideUint {
+ public:
+  static constexpr size_t BITS = WORDS * 64;
+
+  constexpr WideUint() = default;
+  constexpr WideUint(uint64_t value) : words_{value} {}  // NOLINT: implicit like built-in integers
+
+  /**
+   * @throws std::overflow_error if the sum needs more than BITS bits
+   */
+  constexpr WideUint& operator+=(const WideUint& other) {
+    uint64_t carry = 0;
+    for (size_t i = 0; i < WORDS; ++i) {
+      const uint64_t sum = words_[i] + other.words_[i];
+      const uint64_t withCarry = sum + carry;
+      carry = (sum < words_[i]) | (withCarry < sum);
+      words_[i] = withCarry;
+    }
+    if (carry) {
+      throw std::overflow_error("WideUint addition overflows " + std::to_string(BITS) + " bits");
+    }
+    return *this;
+  }
+
+  // Requires other <= *this
+  constexpr WideUint& operator-=(const WideUint& other) {
+    uint64_t borrow = 0;
+    for (size_t i = 0; i < WORDS; ++i) {
+      const uint64_t difference = words_[i] - other.words_[i];
+      const uint64_t withBorrow = difference - borrow;
+      borrow = (words_[i] < other.words_[i]) | (difference < borrow);
+      words_[i] = withBorrow;
+    }
+    return *this;
+  }
+
+  friend constexpr WideUint operator+(WideUint a, const WideUint& b) { return a += b; }
+  friend constexpr WideUint operator-(WideUint a, const WideUint& b) { return a -= b; }
+
+  friend constexpr bool operator==(const WideUint& a, const WideUint& b) = default;
+  friend constexpr bool operator<(const WideUint& a, const WideUint& b) {
+    for (size_t i = WORDS; i-- > 0;) {
+      if (a.words_[i] != b.words_[i]) return a.words_[i] < b.words_[i];
+    }
+    return false;
+  }
+  friend constexpr bool operator>(const WideUint& a, const WideUint& b) { return b < a; }
+  friend constexpr bool operator<=(const WideUint& a, const WideUint& b) { return !(b < a); }
+  friend constexpr bool operator>=(const WideUint& a, const WideUint& b) { return !(a < b); }
+
+  constexpr bool IsZero() const { return *this == WideUint(); }
+  constexpr bool FitsUint64() const {
+    for (size_t i = 1; i < WORDS; ++i) {
+      if (words_[i] != 0) return false;
+    }
+    return true;
+  }
+  // Low 64 bits
+  constexpr uint64_t ToUint64() const { return words_[0]; }
+
+  // Number of bits needed to represent the value (0 for zero)
+  constexpr size_t BitWidth() const {
+    for (size_t i = WORDS; i-- > 0;) {
+      if (words_[i] != 0) return i * 64 + static_cast<size_t>(std::bit_width(words_[i]));
+    }
+    return 0;
+  }
+
+  constexpr uint64_t GetWord(size_t index) const { return words_[index]; }
+  constexpr void SetWord(size_t index, uint64_t value) { words_[index] = value; }
+
+  double ToDouble() const {
+    double value = 0.0;
+    for (size_t i = WORDS; i-- > 0;) {
+      value = value * 18446744073709551616.0 + static_cast<double>(words_[i]);
+    }
+    return value;
+  }
+
+  // Decimal digits
+  std::string ToString() const {
+    if (IsZero()) return "0";
+
+    // Repeated division by 10^9, which keeps every partial dividend below 2^62
+    constexpr uint64_t CHUNK = 1'000'000'000;
+    WideUint value = *this;
+    std::string digits;
+    while (!value.IsZero()) {
+      uint64_t remainder = 0;
+      for (size_t i = WORDS; i-- > 0;) {
+        // (remainder * 2^64 + word) / CHUNK, 32 bits at a time
+        const uint64_t high = (remainder << 32) | (value.words_[i] >> 32);
+        const uint64_t highQuotient = high / CHUNK;
+        remainder = high % CHUNK;
+        const uint64_t low = (remainder << 32) | (value.words_[i] & 0xffffffffULL);
+        const uint64_t lowQuotient = low / CHUNK;
+        remainder = low % CHUNK;
+        value.words_[i] = (highQuotient << 32) | lowQuotient;
+      }
+      std::string chunk = std::to_string(remainder);
+      if (!value.IsZero()) chunk.insert(0, 9 - chunk.size(), '0');
+      digits.insert(0, chunk);
+    }
+    return digits;
+  }
+
+ private:
+  std::array<uint64_t, WORDS> words_{};
+};
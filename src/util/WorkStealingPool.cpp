@@ -0,0 +1,139 @@
+#include "util/WorkStealingPool.h"
+
+WorkStealingPool::WorkStealingPool(unsigned threadCount)
+    : threadCount_(ResolveThreadCount(threadCount)),
+      ranges_(std::make_unique<WorkRange[]>(threadCount_)) {
+  threads_.reserve(threadCount_ - 1);
+  for (unsigned worker = 1; worker < threadCount_; ++worker) {
+    threads_.emplace_back([this, worker] { WorkerLoop(worker); });
+  }
+}
+
+WorkStealingPool::~WorkStealingPool() {
+  {
+    std::lock_guard<std::mutex> lock(jobMutex_);
+    stopping_ = true;
+  }
+  jobReady_.notify_all();
+  for (auto& thread : threads_) {
+    thread.join();
+  }
+}
+
+unsigned WorkStealingPool::ResolveThreadCount(unsigned requested) {
+  if (requested > 0) return requested;
+  const unsigned hardware = std::thread::hardware_concurrency();
+  return hardware > 0 ? hardware : 1;
+}
+
+void WorkStealingPool::ParallelFor(size_t count,
+                                   const std::function<void(size_t, unsigned)>& body) {
+  if (count == 0) return;
+
+  if (threadCount_ == 1) {
+    for (size_t i = 0; i < count; ++i) {
+      body(i, 0);
+    }
+    return;
+  }
+
+  // Even initial split; stealing fixes any imbalance
+  const size_t chunk = count / threadCount_;
+  const size_t remainder = count % threadCount_;
+  size_t begin = 0;
+  for (unsigned worker = 0; worker < threadCount_; ++worker) {
+    const size_t size = chunk + (worker < remainder ? 1 : 0);
+    std::lock_guard<std::mutex> lock(ranges_[worker].mutex);
+    ranges_[worker].begin = begin;
+    ranges_[worker].end = begin + size;
+    begin += size;
+  }
+
+  {
+    std::lock_guard<std::mutex> lock(jobMutex_);
+    body_ = &body;
+    error_ = nullptr;
+    cancelled_ = false;
+    activeWorkers_ = threadCount_ - 1;
+    ++generation_;
+  }
+  jobReady_.notify_all();
+
+  RunWorker(0);
+
+  std::exception_ptr error;
+  {
+    std::unique_lock<std::mutex> lock(jobMutex_);
+    jobDone_.wait(lock, [this] { return activeWorkers_ == 0; });
+    body_ = nullptr;
+    error = error_;
+  }
+
+  if (error) {
+    std::rethrow_exception(error);
+  }
+}
+
+void WorkStealingPool::WorkerLoop(unsigned worker) {
+  size_t seenGeneration = 0;
+  std::unique_lock<std::mutex> lock(jobMutex_);
+  while (true) {
+    jobReady_.wait(lock, [&] { return stopping_ || generation_ != seenGeneration; });
+    if (stopping_) return;
+    seenGeneration = generation_;
+
+    lock.unlock();
+    RunWorker(worker);
+    lock.lock();
+
+    if (--activeWorkers_ == 0) {
+      jobDone_.notify_all();
+    }
+  }
+}
+
+void WorkStealingPool::RunWorker(unsigned worker) {
+  size_t index = 0;
+  do {
+    while (!cancelled_ && TakeOwn(worker, index)) {
+      try {
+        (*body_)(index, worker);
+      } catch (...) {
+        std::lock_guard<std::mutex> lock(jobMutex_);
+        if (!error_) error_ = std::current_exception();
+        cancelled_ = true;
+      }
+    }
+  } while (!cancelled_ && Steal(worker));
+}
+
+bool WorkStealingPool::TakeOwn(unsigned worker, size_t& index) {
+  WorkRange& range = ranges_[worker];
+  std::lock_guard<std::mutex> lock(range.mutex);
+  if (range.begin == range.end) return false;
+  index = range.begin++;
+  return true;
+}
+
+bool WorkStealingPool::Steal(unsigned worker) {
+  for (unsigned offset = 1; offset < threadCount_; ++offset) {
+    WorkRange& victim = ranges_[(worker + offset) % threadCount_];
+
+    size_t stolenBegin = 0;
+    size_t stolenEnd = 0;
+    {
+      std::lock_guard<std::mutex> lock(victim.mutex);
+      if (victim.begin == victim.end) continue;
+      stolenBegin = victim.begin + (victim.end - victim.begin) / 2;
+      stolenEnd = victim.end;
+      victim.end = stolenBegin;
+    }
+
+    WorkRange& own = ranges_[worker];
+    std::lock_guard<std::mutex> lock(own.mutex);
+    own.begin = stolenBegin;
+    own.end = stolenEnd;
+    return true;
+  }
+  return false;
+}
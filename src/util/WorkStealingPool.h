@@ -0,0 +1,70 @@
+#pragma once
+#include <atomic>
+#include <condition_variable>
+#include <cstddef>
+#include <exception>
+#include <functional>
+#include <memory>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+/**
+ * Fixed-size thread pool that runs index ranges with work stealing
+ *
+ * Each ParallelFor splits [0, count) evenly across the workers. A worker
+ * drains its own range from the front; once empty it steals the back half
+ * of another worker's remaining range, so uneven item costs still balance.
+ * The calling thread takes part as worker 0.
+ */
+class WorkStealingPool {
+ public:
+  /**
+   * @param threadCount Total workers including the caller (0 = hardware concurrency)
+   */
+  explicit WorkStealingPool(unsigned threadCount = 0);
+  ~WorkStealingPool();
+
+  WorkStealingPool(const WorkStealingPool&) = delete;
+  WorkStealingPool& operator=(const WorkStealingPool&) = delete;
+
+  unsigned GetThreadCount() const { return threadCount_; }
+
+  /**
+   * Runs body(index, worker) once for every index in [0, count)
+   *
+   * Blocks until all indices are done. worker is in [0, GetThreadCount()).
+   * Must not be called from inside a body. If a body throws, remaining
+   * unclaimed indices are skipped and the first exception is rethrown.
+   */
+  void ParallelFor(size_t count, const std::function<void(size_t, unsigned)>& body);
+
+  static unsigned ResolveThreadCount(unsigned requested);
+
+ private:
+  struct alignas(64) WorkRange {
+    std::mutex mutex;
+    size_t begin = 0;
+    size_t end = 0;
+  };
+
+  void WorkerLoop(unsigned worker);
+  void RunWorker(unsigned worker);
+  bool TakeOwn(unsigned worker, size_t& index);
+  bool Steal(unsigned worker);
+
+  unsigned threadCount_;
+  std::vector<std::thread> threads_;
+  std::unique_ptr<WorkRange[]> ranges_;
+
+  // Job state shared with the workers
+  std::mutex jobMutex_;
+  std::condition_variable jobReady_;
+  std::condition_variable jobDone_;
+  const std::function<void(size_t, unsigned)>* body_ = nullptr;
+  size_t generation_ = 0;
+  unsigned activeWorkers_ = 0;
+  bool stopping_ = false;
+  std::atomic<bool> cancelled_ = false;
+  std::exception_ptr error_;
+};
@@ -0,0 +1,115 @@
+#include "allocation_counter.h"
+
+#include <atomic>
+#include <cstdlib>
+#include <new>
+
+/**
+ * Replacement global allocation functions that count every call
+ *
+ * All forms forward to the four below, so the nothrow, array and sized
+ * variants are counted exactly once each.
+ */
+
+namespace {
+std::atomic<uint64_t> allocationCount{0};
+std::atomic<uint64_t> deallocationCount{0};
+std::atomic<uint64_t> bytesAllocated{0};
+
+void* Allocate(std::size_t size) {
+  if (size == 0) size = 1;
+  void* memory = std::malloc(size);
+  if (memory) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+  }
+  return memory;
+}
+
+void* AllocateAligned(std::size_t size, std::align_val_t alignment) {
+  const auto align = static_cast<std::size_t>(alignment);
+  if (size == 0) size = 1;
+#ifdef _WIN32
+  void* memory = _aligned_malloc(size, align);
+#else
+  // aligned_alloc needs a size that is a multiple of the alignment
+  void* memory = std::aligned_alloc(align, (size + align - 1) / align * align);
+#endif
+  if (memory) {
+    allocationCount.fetch_add(1, std::memory_order_relaxed);
+    bytesAllocated.fetch_add(size, std::memory_order_relaxed);
+  }
+  return memory;
+}
+
+void Deallocate(void* memory) noexcept {
+  if (!memory) return;
+  deallocationCount.fetch_add(1, std::memory_order_relaxed);
+  std::free(memory);
+}
+
+void DeallocateAligned(void* memory) noexcept {
+  if (!memory) return;
+  deallocationCount.fetch_add(1, std::memory_order_relaxed);
+#ifdef _WIN32
+  _aligned_free(memory);
+#else
+  std::free(memory);
+#endif
+}
+}  // namespace
+
+namespace TestUtils {
+AllocationTotals ReadAllocationTotals() {
+  return {allocationCount.load(std::memory_order_relaxed),
+          deallocationCount.load(std::memory_order_relaxed),
+          bytesAllocated.load(std::memory_order_relaxed)};
+}
+
+uint64_t ReadAllocationCount() { return allocationCount.load(std::memory_order_relaxed); }
+}  // namespace TestUtils
+
+void* operator new(std::size_t size) {
+  if (void* memory = Allocate(size)) return memory;
+  throw std::bad_alloc();
+}
+void* operator new[](std::size_t size) { return operator new(size); }
+void* operator new(std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+void* operator new[](std::size_t size, const std::nothrow_t&) noexcept { return Allocate(size); }
+
+void* operator new(std::size_t size, std::align_val_t alignment) {
+  if (void* memory = AllocateAligned(size, alignment)) return memory;
+  throw std::bad_alloc();
+}
+void* operator new[](std::size_t size, std::align_val_t alignment) {
+  return operator new(size, alignment);
+}
+void* operator new(std::size_t size, std::align_val_t alignment, const std::nothrow_t&) noexcept {
+  return AllocateAligned(size, alignment);
+}
+void* operator new[](std::size_t size, std::align_val_t alignment,
+                     const std::nothrow_t&) noexcept {
+  return AllocateAligned(size, alignment);
+}
+
+void operator delete(void* memory) noexcept { Deallocate(memory); }
+void operator delete[](void* memory) noexcept { Deallocate(memory); }
+void operator delete(void* memory, std::size_t) noexcept { Deallocate(memory); }
+void operator delete[](void* memory, std::size_t) noexcept { Deallocate(memory); }
+void operator delete(void* memory, const std::nothrow_t&) noexcept { Deallocate(memory); }
+void operator delete[](void* memory, const std::nothrow_t&) noexcept { Deallocate(memory); }
+
+void operator delete(void* memory, std::align_val_t) noexcept { DeallocateAligned(memory); }
+void operator delete[](void* memory, std::align_val_t) noexcept { DeallocateAligned(memory); }
+void operator delete(void* memory, std::size_t, std::align_val_t) noexcept {
+  DeallocateAligned(memory);
+}
+void operator delete[](void* memory, std::size_t, std::align_val_t) noexcept {
+  DeallocateAligned(memory);
+}
+void operator delete(void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+  DeallocateAligned(memory);
+}
+void operator delete[](void* memory, std::align_val_t, const std::nothrow_t&) noexcept {
+  DeallocateAligned(memory);
+}
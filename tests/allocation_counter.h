@@ -0,0 +1,47 @@
+#pragma once
+#include <cstddef>
+#include <cstdint>
+
+namespace TestUtils {
+/**
+ * Totals of global operator new/delete calls since process start
+ *
+ * Counted by the replacement operators in allocation_counter.cpp, which
+ * must be linked into the executable exactly once. Counters are shared by
+ * all threads.
+ */
+struct AllocationTotals {
+  uint64_t allocations = 0;
+  uint64_t deallocations = 0;
+  uint64_t bytesAllocated = 0;
+};
+
+AllocationTotals ReadAllocationTotals();
+
+// Allocation count only, in the shape Stats::SetAllocationCounter expects
+uint64_t ReadAllocationCount();
+
+/**
+ * Counts heap activity between construction and each query
+ *
+ * Usage:
+ *   AllocationScope scope;
+ *   graph.AddRoom("A1", Room::Type::Combat);
+ *   EXPECT_LE(scope.GetAllocations(), 2u);
+ */
+class AllocationScope {
+ public:
+  AllocationScope() : start_(ReadAllocationTotals()) {}
+
+  uint64_t GetAllocations() const { return ReadAllocationTotals().allocations - start_.allocations; }
+  uint64_t GetDeallocations() const {
+    return ReadAllocationTotals().deallocations - start_.deallocations;
+  }
+  uint64_t GetBytes() const { return ReadAllocationTotals().bytesAllocated - start_.bytesAllocated; }
+
+  void Reset() { start_ = ReadAllocationTotals(); }
+
+ private:
+  AllocationTotals start_;
+};
+}  // namespace TestUtils
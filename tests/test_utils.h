@@ -1,6 +1,10 @@
 #pragma once
 #include <cmath>
+#include <cstdint>
 #include <random>
+#include <vector>
+
+#include "generation/PathGenerator.h"
 
 namespace TestUtils {
 /**
@@ -36,4 +40,22 @@ class SeededRandom {
 inline bool ApproxEqual(float a, float b, float epsilon = 0.001f) {
   return std::abs(a - b) < epsilon;
 }
+
+/**
+ * The run a counter-based PathGenerator produces for seed
+ */
+inline RunGraph GenerateRun(uint64_t seed, const PathGenerator::Config& config = {}) {
+  PathGenerator generator(seed);
+  generator.SetConfig(config);
+  return generator.GeneratePath();
+}
+
+// Default-config runs for seeds firstSeed .. firstSeed + count - 1
+inline std::vector<RunGraph> GenerateRuns(uint64_t firstSeed, size_t count) {
+  std::vector<uint64_t> seeds(count);
+  for (size_t i = 0; i < count; ++i) {
+    seeds[i] = firstSeed + i;
+  }
+  return PathGenerator::GenerateBatch(seeds, PathGenerator::Config{}, 1);
+}
 }  // namespace TestUtils
\ No newline at end of file
@@ -0,0 +1,177 @@
+#include <gtest/gtest.h>
+
+#include <memory>
+#include <string>
+#include <vector>
+
+#include "../allocation_counter.h"
+#include "core/GraphValidator.h"
+#include "core/Room.h"
+#include "core/RunGraph.h"
+#include "generation/PathGenerator.h"
+
+using TestUtils::AllocationScope;
+
+namespace {
+// Escapes pointers so new/delete pairs cannot be optimized away
+void* volatile sink = nullptr;
+}  // namespace
+
+/**
+ * Test Suite: AllocationScope
+ * Testing the counting harness itself
+ */
+
+TEST(AllocationScopeTest, CountsNewAndDelete) {
+  AllocationScope scope;
+  auto value = std::make_unique<int>(7);
+  EXPECT_EQ(scope.GetAllocations(), 1u);
+  EXPECT_GE(scope.GetBytes(), sizeof(int));
+  value.reset();
+  EXPECT_EQ(scope.GetDeallocations(), 1u);
+}
+
+TEST(AllocationScopeTest, CountsArrayAndAlignedForms) {
+  struct alignas(64) Wide {
+    char bytes[64];
+  };
+
+  AllocationScope scope;
+  char* bytes = new char[100];
+  sink = bytes;
+  delete[] bytes;
+  Wide* wide = new Wide;
+  sink = wide;
+  delete wide;
+  EXPECT_EQ(scope.GetAllocations(), 2u);
+  EXPECT_EQ(scope.GetDeallocations(), 2u);
+  EXPECT_GE(scope.GetBytes(), 164u);
+}
+
+TEST(AllocationScopeTest, ResetStartsOver) {
+  AllocationScope scope;
+  std::vector<int> values(10);
+  scope.Reset();
+  EXPECT_EQ(scope.GetAllocations(), 0u);
+}
+
+/**
+ * Test Suite: Allocation budgets
+ * Regression limits on heap allocations per operation; raising one should
+ * be a deliberate decision
+ */
+
+TEST(AllocationBudgetTest, RoomConstructionDoesNotAllocate) {
+  AllocationScope scope;
+  Room room("A1_Combat_01", Room::Type::Combat);
+  room.AddExit(glm::vec2(0.0f, 1.0f), Room::Direction::North);
+  room.AddReward(Reward::Type::Boon);
+  room.SetBiome(Biome::Type::Elysium);
+  EXPECT_EQ(scope.GetAllocations(), 0u);
+}
+
+TEST(AllocationBudgetTest, AddRoomAllocatesOnlyTheNode) {
+  RunGraph graph;
+  graph.Reserve(2);
+
+  AllocationScope scope;
+  auto* first = graph.AddRoom("A", Room::Type::Combat);
+  auto* second = graph.AddRoom("B", Room::Type::Boss);
+  EXPECT_EQ(scope.GetAllocations(), 2u);
+
+  // First edge out of a node allocates its edge list
+  scope.Reset();
+  graph.Connect(first, second);
+  EXPECT_EQ(scope.GetAllocations(), 1u);
+}
+
+TEST(AllocationBudgetTest, BuildingReservedChainIsTwoPerRoom) {
+  constexpr int ROOM_COUNT = 100;
+  RunGraph graph;
+  graph.Reserve(ROOM_COUNT, ROOM_COUNT - 1);
+
+  AllocationScope scope;
+  RunGraph::Node* previous = nullptr;
+  for (int i = 0; i < ROOM_COUNT; ++i) {
+    auto* node = graph.AddRoom("room_" + std::to_string(i), Room::Type::Combat);
+    if (previous) graph.Connect(previous, node);
+    previous = node;
+  }
+  EXPECT_LE(scope.GetAllocations(), 2u * ROOM_COUNT);
+
+  // Packed arrays were reserved up front
+  scope.Reset();
+  graph.Finalize();
+  EXPECT_EQ(scope.GetAllocations(), 0u);
+}
+
+TEST(AllocationBudgetTest, GeneratePathStaysWithinBudget) {
+  // Per run: one node per room and one allocation per edge (a room's first
+  // edge creates its edge list, a branch's second edge grows it), plus a few
+  // fixed buffers
+  constexpr uint64_t FIXED = 8;
+
+  for (const float branchProbability : {0.0f, 0.3f}) {
+    PathGenerator::Config config;
+    config.minRooms = 200;
+    config.maxRooms = 200;
+    config.branchProbability = branchProbability;
+
+    PathGenerator generator(uint64_t{7});
+    generator.SetConfig(config);
+    generator.GeneratePath();  // Warm up the generator's scratch buffers
+
+    AllocationScope scope;
+    RunGraph graph = generator.GeneratePath();
+    EXPECT_LE(scope.GetAllocations(), graph.GetNodeCount() + graph.GetEdgeCount() + FIXED)
+        << "branchProbability " << branchProbability;
+  }
+}
+
+TEST(AllocationBudgetTest, StreamedStartRoomIsIndependentOfLength) {
+  // Only the coroutine frame is allocated before the first room, however long the run
+  for (const int rooms : {50, 100'000}) {
+    PathGenerator::Config config;
+    config.minRooms = rooms;
+    config.maxRooms = rooms;
+    PathGenerator generator(uint64_t{7});
+    generator.SetConfig(config);
+
+    AllocationScope scope;
+    RunStream stream = generator.GenerateStream();
+    ASSERT_TRUE(stream.Next());
+    EXPECT_EQ(scope.GetAllocations(), 1u) << rooms << " rooms";
+  }
+}
+
+TEST(AllocationBudgetTest, ValidateReusesScratch) {
+  PathGenerator generator(uint64_t{11});
+  RunGraph graph = generator.GeneratePath();
+
+  GraphValidator validator;
+  AllocationScope scope;
+  EXPECT_TRUE(validator.Validate(graph).isValid);
+  EXPECT_LE(scope.GetAllocations(), 16u);  // Scratch growth on first use
+
+  scope.Reset();
+  validator.Validate(graph);
+  EXPECT_EQ(scope.GetAllocations(), 0u);
+}
+
+TEST(AllocationBudgetTest, FeedsGenerationStats) {
+  if constexpr (!Stats::ENABLED) GTEST_SKIP() << "Built with TARTARUS_ENABLE_STATS=OFF";
+
+  Stats::SetAllocationCounter(&TestUtils::ReadAllocationCount);
+  GenerationStats stats;
+  PathGenerator generator(uint64_t{5});
+  generator.SetStats(&stats);
+  generator.GeneratePath();
+
+  AllocationScope scope;
+  RunGraph graph = generator.GeneratePath();
+  const uint64_t counted = scope.GetAllocations();
+  Stats::SetAllocationCounter(nullptr);
+
+  EXPECT_GT(stats.allocations, 0u);
+  EXPECT_EQ(stats.allocations, counted);
+}
@@ -0,0 +1,393 @@
+#include <gtest/gtest.h>
+
+#include <filesystem>
+#include <fstream>
+#include <sstream>
+
+#include "../test_utils.h"
+#include "generation/PathGenerator.h"
+#include "io/Endian.h"
+#include "io/MappedFile.h"
+#include "io/PackedRunArchive.h"
+#include "io/RunArchive.h"
+#include "io/RunGraphBinary.h"
+
+namespace {
+std::span<const std::byte> AsBytes(const std::string& data) {
+  return {reinterpret_cast<const std::byte*>(data.data()), data.size()};
+}
+
+RunGraph BuildDecoratedGraph() {
+  RunGraph graph;
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  auto* shop = graph.AddRoom("shop", Room::Type::Shop);
+  auto* boss = graph.AddRoom("boss", Room::Type::Boss);
+
+  start->GetRoom()->AddExit({10.0f, 0.0f}, Room::Direction::North);
+  start->GetRoom()->AddExit({0.0f, 5.5f}, Room::Direction::West);
+  start->GetRoom()->AddReward(Reward::Data(Reward::Type::Boon, Reward::God::Zeus));
+  start->SetOnCriticalPath(true);
+  shop->GetRoom()->SetBiome(Biome::Type::Asphodel);
+  shop->GetRoom()->SetDifficulty(2.5f);
+  shop->GetRoom()->AddReward(Reward::Data(Reward::Type::Gold, 150));
+  shop->SetDepth(1);
+  boss->SetDepth(2);
+  boss->SetOnCriticalPath(true);
+
+  graph.SetStartNode(start);
+  graph.Connect(start, shop);
+  graph.Connect(start, boss);
+  graph.Connect(shop, boss);
+  return graph;
+}
+
+using TestUtils::GenerateRun;
+}  // namespace
+
+/**
+ * Test Suite: Binary RunGraph format
+ * Testing serialization and zero-copy views
+ */
+
+TEST(BinaryFormatTest, HeaderStartsWithMagicAndVersion) {
+  auto bytes = RunGraphBinary::Serialize(BuildDecoratedGraph());
+
+  ASSERT_GE(bytes.size(), RunGraphBinary::HEADER_SIZE);
+  EXPECT_EQ(static_cast<char>(bytes[0]), 'T');
+  EXPECT_EQ(static_cast<char>(bytes[3]), 'B');
+  EXPECT_EQ(static_cast<uint8_t>(bytes[4]), RunGraphBinary::VERSION);
+  EXPECT_EQ(bytes.size() % RunGraphBinary::ALIGNMENT, 0u);
+}
+
+TEST(BinaryFormatTest, ViewReadsRoomsWithoutDeserializing) {
+  auto bytes = RunGraphBinary::Serialize(BuildDecoratedGraph());
+  RunGraphView view(bytes);
+
+  ASSERT_TRUE(view.VerifyIntegrity());
+  EXPECT_EQ(view.GetNodeCount(), 3);
+  EXPECT_EQ(view.GetEdgeCount(), 3);
+  EXPECT_EQ(view.GetStartIndex(), 0u);
+
+  auto start = view.GetNode(0);
+  EXPECT_EQ(start.GetId(), "start");
+  EXPECT_TRUE(start.IsOnCriticalPath());
+  ASSERT_EQ(start.GetExitCount(), 2);
+  EXPECT_EQ(start.GetExit(1).direction, Room::Direction::West);
+  EXPECT_FLOAT_EQ(start.GetExit(1).position.y, 5.5f);
+  ASSERT_EQ(start.GetRewardCount(), 1);
+  EXPECT_EQ(start.GetReward(0).god, Reward::God::Zeus);
+
+  auto shop = view.GetNode(1);
+  EXPECT_EQ(shop.GetType(), Room::Type::Shop);
+  EXPECT_EQ(shop.GetBiome(), Biome::Type::Asphodel);
+  EXPECT_FLOAT_EQ(shop.GetDifficulty(), 2.5f);
+  EXPECT_EQ(shop.GetDepth(), 1);
+  EXPECT_EQ(shop.GetReward(0).quantity, 150);
+
+  EXPECT_EQ(view.GetDegree(0), 2u);
+  EXPECT_EQ(view.GetSuccessor(0, 1), 2u);
+  EXPECT_EQ(view.GetDegree(2), 0u);
+}
+
+TEST(BinaryFormatTest, RoundTripsGeneratedRun) {
+  auto original = GenerateRun(42);
+  auto bytes = RunGraphBinary::Serialize(original);
+
+  auto copy = RunGraphView(bytes).ToRunGraph();
+
+  ASSERT_EQ(copy.GetNodeCount(), original.GetNodeCount());
+  ASSERT_EQ(copy.GetEdgeCount(), original.GetEdgeCount());
+  for (RunGraph::NodeIndex i = 0; i < original.GetNodeCount(); ++i) {
+    EXPECT_EQ(copy.GetNode(i)->GetRoom()->GetId(), original.GetNode(i)->GetRoom()->GetId());
+    EXPECT_EQ(copy.GetNode(i)->GetRoom()->GetType(), original.GetNode(i)->GetRoom()->GetType());
+    EXPECT_EQ(copy.GetNode(i)->GetDepth(), original.GetNode(i)->GetDepth());
+  }
+  EXPECT_EQ(copy.GetEdgeTargets().size(), original.GetEdgeTargets().size());
+  EXPECT_TRUE(std::equal(copy.GetEdgeTargets().begin(), copy.GetEdgeTargets().end(),
+                         original.GetEdgeTargets().begin()));
+  EXPECT_EQ(copy.GetStartNode(), copy.GetNode(0));
+}
+
+TEST(BinaryFormatTest, RejectsBadMagicAndTruncation) {
+  auto bytes = RunGraphBinary::Serialize(BuildDecoratedGraph());
+
+  auto truncated = std::span<const std::byte>(bytes).first(bytes.size() - 8);
+  EXPECT_THROW(RunGraphView{truncated}, std::runtime_error);
+
+  bytes[0] = std::byte{'X'};
+  EXPECT_THROW(RunGraphView{bytes}, std::runtime_error);
+}
+
+TEST(BinaryFormatTest, DetectsCorruptEdgeTargets) {
+  auto bytes = RunGraphBinary::Serialize(BuildDecoratedGraph());
+  RunGraphView view(bytes);
+  ASSERT_TRUE(view.VerifyIntegrity());
+
+  // Point the last edge target far outside the graph
+  const size_t edgeTargets = Endian::LoadLE<uint32_t>(bytes.data() + 48);
+  Endian::StoreLE<uint32_t>(bytes.data() + edgeTargets + 2 * sizeof(uint32_t), 999);
+
+  EXPECT_FALSE(RunGraphView(bytes).VerifyIntegrity());
+}
+
+TEST(BinaryFormatTest, DetectsCorruptExitAndRewardBytes) {
+  const auto bytes = RunGraphBinary::Serialize(BuildDecoratedGraph());
+  const size_t exits = Endian::LoadLE<uint32_t>(bytes.data() + 52);
+  const size_t rewards = Endian::LoadLE<uint32_t>(bytes.data() + 56);
+
+  // Direction byte of the second exit, then type and god of the first reward
+  for (const size_t offset : {exits + RunGraphBinary::EXIT_RECORD_SIZE + 8, rewards, rewards + 1}) {
+    for (const uint8_t value : {uint8_t{0x20}, uint8_t{0xFF}}) {
+      auto corrupt = bytes;
+      corrupt[offset] = std::byte{value};
+      EXPECT_FALSE(RunGraphView(corrupt).VerifyIntegrity()) << "offset " << offset;
+    }
+  }
+
+  // The largest valid values still pass
+  auto edge = bytes;
+  edge[exits + 8] = static_cast<std::byte>(Room::Direction::West);
+  edge[rewards + 1] = static_cast<std::byte>(Reward::God::Chaos);
+  EXPECT_TRUE(RunGraphView(edge).VerifyIntegrity());
+  edge[exits + 8] = static_cast<std::byte>(static_cast<uint8_t>(Room::Direction::West) + 1);
+  EXPECT_FALSE(RunGraphView(edge).VerifyIntegrity());
+}
+
+/**
+ * Test Suite: Run archives
+ * Testing multi-run archives and memory-mapped loading
+ */
+
+TEST(RunArchiveTest, RandomAccessToRuns) {
+  std::ostringstream out(std::ios::binary);
+  RunArchiveWriter writer(out);
+  for (uint32_t seed = 1; seed <= 5; ++seed) {
+    writer.Add(GenerateRun(seed));
+  }
+  writer.Finish();
+  EXPECT_THROW(writer.Add(GenerateRun(6)), std::logic_error);
+
+  const std::string data = out.str();
+  RunArchiveView archive(AsBytes(data));
+
+  ASSERT_EQ(archive.GetRunCount(), 5);
+  for (uint32_t seed = 1; seed <= 5; ++seed) {
+    auto expected = GenerateRun(seed);
+    auto run = archive.GetRun(seed - 1);
+    EXPECT_EQ(run.GetNodeCount(), expected.GetNodeCount());
+    EXPECT_EQ(run.GetNode(3).GetType(), expected.GetNode(3)->GetRoom()->GetType());
+  }
+  EXPECT_THROW(archive.GetRun(5), std::out_of_range);
+}
+
+TEST(RunArchiveTest, RejectsUnfinishedArchive) {
+  std::ostringstream out(std::ios::binary);
+  RunArchiveWriter writer(out);
+  writer.Add(GenerateRun(1));
+
+  const std::string data = out.str();
+  EXPECT_THROW(RunArchiveView{AsBytes(data)}, std::runtime_error);
+}
+
+TEST(RunArchiveTest, LoadsThroughMemoryMapping) {
+  const auto path = std::filesystem::temp_directory_path() / "tartarus_archive_test.bin";
+  {
+    std::ofstream file(path, std::ios::binary);
+    RunArchiveWriter writer(file);
+    writer.Add(GenerateRun(7));
+    writer.Add(GenerateRun(8));
+    writer.Finish();
+  }
+
+  {
+    MappedFile mapped(path.string());
+    RunArchiveView archive(mapped.GetBytes());
+
+    ASSERT_EQ(archive.GetRunCount(), 2);
+    auto run = archive.GetRun(1);
+    EXPECT_TRUE(run.VerifyIntegrity());
+    EXPECT_EQ(run.GetNode(0).GetId(), "room_1");
+    EXPECT_EQ(run.GetNodeCount(), GenerateRun(8).GetNodeCount());
+  }
+
+  std::filesystem::remove(path);
+  EXPECT_THROW(MappedFile(path.string()), std::runtime_error);
+}
+
+/**
+ * Test Suite: Packed run archives
+ * Testing the bit-packed codec, its size and random access
+ */
+
+namespace {
+void ExpectSameRun(const RunGraph& copy, const RunGraph& original) {
+  ASSERT_EQ(copy.GetNodeCount(), original.GetNodeCount());
+  ASSERT_EQ(copy.GetEdgeCount(), original.GetEdgeCount());
+  for (RunGraph::NodeIndex i = 0; i < original.GetNodeCount(); ++i) {
+    const RunGraph::Node* a = copy.GetNode(i);
+    const RunGraph::Node* b = original.GetNode(i);
+    EXPECT_EQ(a->GetRoom()->GetId(), b->GetRoom()->GetId());
+    EXPECT_EQ(a->GetRoom()->GetType(), b->GetRoom()->GetType());
+    EXPECT_EQ(a->GetRoom()->GetBiome(), b->GetRoom()->GetBiome());
+    EXPECT_EQ(a->GetRoom()->GetDifficulty(), b->GetRoom()->GetDifficulty());
+    EXPECT_EQ(a->GetDepth(), b->GetDepth());
+    EXPECT_EQ(a->IsOnCriticalPath(), b->IsOnCriticalPath());
+    ASSERT_EQ(a->GetNextRooms().size(), b->GetNextRooms().size());
+    for (size_t e = 0; e < a->GetNextRooms().size(); ++e) {
+      EXPECT_EQ(a->GetNextRooms()[e]->GetIndex(), b->GetNextRooms()[e]->GetIndex());
+    }
+  }
+  ASSERT_EQ(copy.GetStartNode() != nullptr, original.GetStartNode() != nullptr);
+  if (original.GetStartNode()) {
+    EXPECT_EQ(copy.GetStartNode()->GetIndex(), original.GetStartNode()->GetIndex());
+  }
+}
+
+std::vector<std::byte> Pack(const RunGraph& graph) {
+  std::vector<std::byte> bytes;
+  PackedRunFormat::AppendTo(graph, bytes);
+  return bytes;
+}
+}  // namespace
+
+TEST(PackedRunTest, RoundTripsGeneratedRuns) {
+  PathGenerator::Config config;
+  config.branchProbability = 0.5f;
+  config.maxBranchLength = 3;
+  for (uint64_t seed = 0; seed < 20; ++seed) {
+    const RunGraph original = GenerateRun(seed, config);
+
+    const auto bytes = Pack(original);
+    PackedRun run;
+    EXPECT_EQ(PackedRunFormat::Decode(bytes, run), bytes.size());
+    EXPECT_TRUE(run.idOffsets.empty());  // Generator ids are implied
+    ExpectSameRun(run.ToRunGraph(), original);
+  }
+}
+
+TEST(PackedRunTest, RoundTripsDecoratedRooms) {
+  const RunGraph original = BuildDecoratedGraph();
+  PackedRun run;
+  PackedRunFormat::Decode(Pack(original), run);
+  const RunGraph copy = run.ToRunGraph();
+  ExpectSameRun(copy, original);
+
+  const Room* start = copy.GetNode(0)->GetRoom();
+  ASSERT_EQ(start->GetExitCount(), 2u);
+  EXPECT_EQ(start->GetExits()[1].position, glm::vec2(0.0f, 5.5f));
+  EXPECT_EQ(start->GetExits()[1].direction, Room::Direction::West);
+  ASSERT_EQ(start->GetRewards().size(), 1u);
+  EXPECT_EQ(start->GetRewards()[0].god, Reward::God::Zeus);
+  EXPECT_EQ(copy.GetNode(1)->GetRoom()->GetRewards()[0].quantity, 150);
+  EXPECT_TRUE(copy.GetNode(2)->GetRoom()->GetRewards().empty());
+}
+
+TEST(PackedRunTest, QuantizesDifficulty) {
+  RunGraph graph;
+  const float difficulties[] = {0.3f, -2.0f, 1000.0f};
+  for (const float difficulty : difficulties) {
+    graph.AddRoom("room", Room::Type::Combat)->GetRoom()->SetDifficulty(difficulty);
+  }
+
+  PackedRun run;
+  PackedRunFormat::Decode(Pack(graph), run);
+  EXPECT_NEAR(run.difficulties[0], 0.3f, 0.5f / PackedRunFormat::DIFFICULTY_SCALE);
+  EXPECT_EQ(run.difficulties[1], 0.0f);
+  EXPECT_EQ(run.difficulties[2], PackedRunFormat::MAX_DIFFICULTY);
+}
+
+TEST(PackedRunTest, SpansSeveralBlocks) {
+  PathGenerator::Config config;
+  config.minRooms = 1000;
+  config.maxRooms = 1000;
+  const RunGraph original = GenerateRun(9, config);
+
+  PackedRun run;
+  PackedRunFormat::Decode(Pack(original), run);
+  ExpectSameRun(run.ToRunGraph(), original);
+}
+
+TEST(PackedRunTest, IsOverTenTimesSmallerThanBinary) {
+  size_t packed = 0;
+  size_t binary = 0;
+  for (uint32_t seed = 1; seed <= 20; ++seed) {
+    const RunGraph graph = GenerateRun(seed);
+    packed += Pack(graph).size();
+    binary += RunGraphBinary::Serialize(graph).size();
+  }
+  EXPECT_LT(packed * 10, binary) << packed << " packed bytes vs " << binary;
+}
+
+TEST(PackedRunTest, RejectsTruncatedAndCorruptRuns) {
+  const auto bytes = Pack(GenerateRun(3));
+  PackedRun run;
+  for (size_t size = 0; size < bytes.size(); size += 7) {
+    EXPECT_THROW(PackedRunFormat::Decode(std::span(bytes).first(size), run), std::runtime_error)
+        << size << " bytes";
+  }
+
+  // An edge count (second header varint, one byte here) that disagrees
+  // with the degree column
+  auto corrupt = bytes;
+  ASSERT_LT(static_cast<uint8_t>(corrupt[1]), 0x7F);
+  corrupt[1] = static_cast<std::byte>(static_cast<uint8_t>(corrupt[1]) + 1);
+  EXPECT_THROW(PackedRunFormat::Decode(corrupt, run), std::runtime_error);
+}
+
+TEST(PackedRunTest, RejectsNodeCountsAboveTheLimit) {
+  // 20 bytes claiming 0xFFFFFFF0 rooms: no edges, generator ids and six
+  // constant columns of two bytes each, which would all fit
+  std::vector<std::byte> header = {std::byte{0xF0}, std::byte{0xFF}, std::byte{0xFF},
+                                   std::byte{0xFF}, std::byte{0x0F}, std::byte{0},
+                                   std::byte{0},    std::byte{1}};
+  header.resize(header.size() + 12, std::byte{0});
+  PackedRun run;
+  EXPECT_THROW(PackedRunFormat::Decode(header, run), std::runtime_error);
+  EXPECT_EQ(run.types.capacity(), 0u);
+
+  // Callers can lower the limit below a real run's size
+  const RunGraph graph = GenerateRun(3);
+  const auto bytes = Pack(graph);
+  EXPECT_THROW(PackedRunFormat::Decode(bytes, run, graph.GetNodeCount() - 1), std::runtime_error);
+  EXPECT_NO_THROW(PackedRunFormat::Decode(bytes, run, graph.GetNodeCount()));
+
+  std::ostringstream out(std::ios::binary);
+  PackedRunArchiveWriter writer(out);
+  writer.Add(graph);
+  writer.Finish();
+  const std::string data = out.str();
+  EXPECT_THROW(PackedRunArchiveView(AsBytes(data), graph.GetNodeCount() - 1).GetRun(0),
+               std::runtime_error);
+}
+
+TEST(PackedRunArchiveTest, RandomAccessToRuns) {
+  std::ostringstream out(std::ios::binary);
+  PackedRunArchiveWriter writer(out);
+  for (uint32_t seed = 1; seed <= 5; ++seed) {
+    writer.Add(GenerateRun(seed));
+  }
+  writer.Finish();
+  EXPECT_THROW(writer.Add(GenerateRun(6)), std::logic_error);
+
+  const std::string data = out.str();
+  PackedRunArchiveView archive(AsBytes(data));
+  ASSERT_EQ(archive.GetRunCount(), 5u);
+
+  PackedRun run;
+  for (uint32_t seed = 5; seed >= 1; --seed) {
+    archive.Decode(seed - 1, run);
+    ExpectSameRun(run.ToRunGraph(), GenerateRun(seed));
+  }
+  ExpectSameRun(archive.GetRun(2), GenerateRun(3));
+  EXPECT_THROW(archive.GetRun(5), std::out_of_range);
+}
+
+TEST(PackedRunArchiveTest, RejectsOtherFormats) {
+  std::ostringstream out(std::ios::binary);
+  RunArchiveWriter writer(out);
+  writer.Add(GenerateRun(1));
+  writer.Finish();
+
+  const std::string data = out.str();
+  EXPECT_THROW(PackedRunArchiveView{AsBytes(data)}, std::runtime_error);
+}
@@ -0,0 +1,123 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <vector>
+
+#include "util/CounterRng.h"
+
+/**
+ * Test Suite: Philox
+ * Known-answer vectors from the Random123 reference implementation
+ */
+
+TEST(PhiloxTest, MatchesReferenceVectors) {
+  EXPECT_EQ(Philox::Generate({0, 0, 0, 0}, {0, 0}),
+            (Philox::Counter{0x6627e8d5, 0xe169c58d, 0xbc57ac4c, 0x9b00dbd8}));
+  EXPECT_EQ(Philox::Generate({0xffffffff, 0xffffffff, 0xffffffff, 0xffffffff},
+                             {0xffffffff, 0xffffffff}),
+            (Philox::Counter{0x408f276d, 0x41c83b0e, 0xa20bc7c6, 0x6d5451fd}));
+  EXPECT_EQ(Philox::Generate({0x243f6a88, 0x85a308d3, 0x13198a2e, 0x03707344},
+                             {0xa4093822, 0x299f31d0}),
+            (Philox::Counter{0xd16cfe09, 0x94fdcceb, 0x5001e420, 0x24126ea1}));
+}
+
+TEST(PhiloxTest, IsUsableAtCompileTime) {
+  constexpr Philox::Counter block = Philox::Generate({0, 0, 0, 0}, {0, 0});
+  static_assert(block[0] == 0x6627e8d5);
+}
+
+/**
+ * Test Suite: CounterRng
+ * Testing keyed streams, skip-ahead and portable distributions
+ */
+
+TEST(CounterRngTest, SameKeyGivesSameSequence) {
+  CounterRng a(42, 7, 1);
+  CounterRng b(42, 7, 1);
+  for (int i = 0; i < 100; ++i) {
+    EXPECT_EQ(a(), b());
+  }
+}
+
+TEST(CounterRngTest, KeysSelectIndependentStreams) {
+  CounterRng base(42, 0, 0);
+  CounterRng otherSeed(43, 0, 0);
+  CounterRng otherIndex(42, 1, 0);
+  CounterRng otherStream(42, 0, 1);
+
+  int same = 0;
+  for (int i = 0; i < 64; ++i) {
+    const uint32_t value = base();
+    same += value == otherSeed();
+    same += value == otherIndex();
+    same += value == otherStream();
+  }
+  EXPECT_EQ(same, 0);
+}
+
+TEST(CounterRngTest, DiscardSkipsAhead) {
+  CounterRng sequential(9, 3);
+  std::vector<uint32_t> values;
+  for (int i = 0; i < 1000; ++i) values.push_back(sequential());
+
+  for (uint64_t skip : {0u, 1u, 3u, 4u, 5u, 999u}) {
+    CounterRng jumped(9, 3);
+    jumped.Discard(skip);
+    EXPECT_EQ(jumped.GetPosition(), skip);
+    EXPECT_EQ(jumped(), values[skip]) << "skip " << skip;
+  }
+}
+
+TEST(CounterRngTest, ProducesPinnedValues) {
+  // Guards cross-toolchain reproducibility: these must never change
+  CounterRng rng(0, 0);
+  EXPECT_EQ(rng(), 0x6627e8d5u);
+  EXPECT_EQ(rng(), 0xe169c58du);
+
+  CounterRng bounded(42, 5, 1);
+  std::vector<uint32_t> values;
+  for (int i = 0; i < 8; ++i) values.push_back(bounded.Bounded(101));
+  EXPECT_EQ(values, (std::vector<uint32_t>{84, 60, 51, 94, 82, 84, 83, 5}));
+}
+
+TEST(CounterRngTest, UniformIntStaysInRange) {
+  CounterRng rng(1, 2, 3);
+  std::vector<int> counts(7, 0);
+  for (int i = 0; i < 7000; ++i) {
+    const int value = rng.UniformInt(-3, 3);
+    ASSERT_GE(value, -3);
+    ASSERT_LE(value, 3);
+    ++counts[value + 3];
+  }
+  for (int count : counts) {
+    EXPECT_GT(count, 800);
+    EXPECT_LT(count, 1200);
+  }
+
+  EXPECT_EQ(rng.UniformInt(5, 5), 5);
+
+  // The full 32-bit span takes one raw output unchanged
+  CounterRng raw(1, 2, 4);
+  CounterRng wide(1, 2, 4);
+  EXPECT_EQ(static_cast<uint32_t>(wide.UniformInt(INT32_MIN, INT32_MAX)) ^ 0x80000000u, raw());
+}
+
+TEST(CounterRngTest, UniformFloatIsHalfOpen) {
+  CounterRng rng(11, 0);
+  for (int i = 0; i < 10000; ++i) {
+    const float value = rng.UniformFloat();
+    ASSERT_GE(value, 0.0f);
+    ASSERT_LT(value, 1.0f);
+  }
+}
+
+TEST(PortableRandomTest, WorksWithStandardEngines) {
+  // mt19937's output is fully specified by the standard, so this is portable too
+  std::mt19937 a(5);
+  std::mt19937 b(5);
+  for (int i = 0; i < 100; ++i) {
+    const uint32_t value = PortableRandom::Bounded(a, 10);
+    EXPECT_LT(value, 10u);
+    EXPECT_EQ(value, PortableRandom::Bounded(b, 10));
+  }
+}
@@ -0,0 +1,231 @@
+#include <gtest/gtest.h>
+
+#include <random>
+#include <stdexcept>
+#include <vector>
+
+#include "core/GraphValidator.h"
+#include "generation/PathGenerator.h"
+#include "util/GenerationStats.h"
+
+namespace {
+uint64_t fakeAllocations = 0;
+uint64_t ReadFakeAllocations() { return fakeAllocations += 3; }
+}  // namespace
+
+/**
+ * Test Suite: StatsHistogram
+ * Testing bucket accuracy, percentiles and merging
+ */
+
+TEST(StatsHistogramTest, EmptyHistogramReportsZero) {
+  StatsHistogram histogram;
+  EXPECT_EQ(histogram.GetCount(), 0u);
+  EXPECT_EQ(histogram.GetMin(), 0u);
+  EXPECT_EQ(histogram.GetMax(), 0u);
+  EXPECT_EQ(histogram.GetPercentile(50.0), 0u);
+}
+
+TEST(StatsHistogramTest, SmallValuesAreExact) {
+  StatsHistogram histogram;
+  for (uint64_t value = 0; value < 16; ++value) {
+    histogram.Record(value);
+  }
+  EXPECT_EQ(histogram.GetPercentile(0.0), 0u);
+  EXPECT_EQ(histogram.GetPercentile(50.0), 7u);
+  EXPECT_EQ(histogram.GetPercentile(100.0), 15u);
+}
+
+TEST(StatsHistogramTest, PercentilesWithinBucketPrecision) {
+  StatsHistogram histogram;
+  for (uint64_t value = 1; value <= 1000; ++value) {
+    histogram.Record(value);
+  }
+
+  EXPECT_EQ(histogram.GetCount(), 1000u);
+  EXPECT_EQ(histogram.GetMin(), 1u);
+  EXPECT_EQ(histogram.GetMax(), 1000u);
+  EXPECT_DOUBLE_EQ(histogram.GetMean(), 500.5);
+
+  const auto p50 = static_cast<double>(histogram.GetPercentile(50.0));
+  const auto p99 = static_cast<double>(histogram.GetPercentile(99.0));
+  EXPECT_GE(p50, 500.0);
+  EXPECT_LE(p50, 500.0 * 1.0625);
+  EXPECT_GE(p99, 990.0);
+  EXPECT_LE(p99, 1000.0);
+  EXPECT_EQ(histogram.GetPercentile(100.0), 1000u);
+}
+
+TEST(StatsHistogramTest, HandlesFullRange) {
+  StatsHistogram histogram;
+  histogram.Record(UINT64_MAX);
+  histogram.Record(uint64_t{1} << 40);
+  EXPECT_EQ(histogram.GetPercentile(100.0), UINT64_MAX);
+  EXPECT_GE(histogram.GetPercentile(50.0), uint64_t{1} << 40);
+}
+
+TEST(StatsHistogramTest, MergeMatchesRecordingEverything) {
+  StatsHistogram left;
+  StatsHistogram right;
+  StatsHistogram combined;
+  std::mt19937 rng(7);
+  for (int i = 0; i < 2000; ++i) {
+    const uint64_t value = rng() % 100000;
+    (i % 2 ? left : right).Record(value);
+    combined.Record(value);
+  }
+
+  left.Merge(right);
+  EXPECT_EQ(left.GetCount(), combined.GetCount());
+  EXPECT_EQ(left.GetMin(), combined.GetMin());
+  EXPECT_EQ(left.GetMax(), combined.GetMax());
+  for (const double percentile : {1.0, 50.0, 90.0, 99.0, 99.9}) {
+    EXPECT_EQ(left.GetPercentile(percentile), combined.GetPercentile(percentile));
+  }
+}
+
+/**
+ * Test Suite: StatsAggregator
+ * Testing latency histograms and counter totals across runs
+ */
+
+TEST(StatsAggregatorTest, AggregatesLatencyAndCounters) {
+  StatsAggregator aggregator;
+  for (uint64_t run = 1; run <= 100; ++run) {
+    GenerationStats stats;
+    stats.phaseNanos[static_cast<size_t>(GenerationStats::Phase::Build)] = run * 1000;
+    stats.phaseNanos[static_cast<size_t>(GenerationStats::Phase::Finalize)] = 100;
+    stats.roomsCreated = 10;
+    stats.backtracks = run % 2;
+    aggregator.Add(stats);
+  }
+
+  EXPECT_EQ(aggregator.GetRunCount(), 100u);
+  EXPECT_EQ(aggregator.GetTotals().roomsCreated, 1000u);
+  EXPECT_EQ(aggregator.GetTotals().backtracks, 50u);
+  EXPECT_EQ(aggregator.GetTotals().GetPhaseNanos(GenerationStats::Phase::Finalize), 10000u);
+
+  const StatsHistogram& total = aggregator.GetTotalLatency();
+  EXPECT_NEAR(static_cast<double>(total.GetPercentile(50.0)), 50100.0, 50100.0 * 0.0625);
+  EXPECT_NEAR(static_cast<double>(total.GetPercentile(99.0)), 99100.0, 99100.0 * 0.0625);
+  EXPECT_EQ(aggregator.GetPhaseLatency(GenerationStats::Phase::Finalize).GetMax(), 100u);
+}
+
+TEST(StatsAggregatorTest, MergeCombinesRuns) {
+  StatsAggregator first;
+  StatsAggregator second;
+  GenerationStats stats;
+  stats.rngDraws = 5;
+  first.Add(stats);
+  second.Add(stats);
+  second.Add(stats);
+
+  first.Merge(second);
+  EXPECT_EQ(first.GetRunCount(), 3u);
+  EXPECT_EQ(first.GetTotals().rngDraws, 15u);
+}
+
+/**
+ * Test Suite: Generation stats collection
+ * Testing that the generator and validator fill attached stats
+ */
+
+TEST(GenerationStatsTest, GeneratorFillsStats) {
+  if constexpr (!Stats::ENABLED) GTEST_SKIP() << "Built with TARTARUS_ENABLE_STATS=OFF";
+
+  PathGenerator::Config config;
+  config.minRooms = 30;
+  config.maxRooms = 30;
+  config.branchProbability = 0.5f;
+
+  GenerationStats stats;
+  PathGenerator generator(uint64_t{99});
+  generator.SetConfig(config);
+  generator.SetStats(&stats);
+  RunGraph graph = generator.GeneratePath();
+
+  EXPECT_EQ(stats.roomsCreated, graph.GetNodeCount());
+  EXPECT_EQ(stats.edgesCreated, graph.GetEdgeCount());
+  EXPECT_GE(stats.rngDraws, 31u);  // Length plus one word per critical room
+  EXPECT_GT(stats.GetTotalNanos(), 0u);
+  EXPECT_EQ(stats.GetPhaseNanos(GenerationStats::Phase::Validate), 0u);
+  EXPECT_EQ(stats.allocations, 0u);  // No counter installed
+
+  // Each run overwrites the record
+  const uint64_t rooms = stats.roomsCreated;
+  generator.GeneratePath();
+  EXPECT_EQ(stats.roomsCreated, rooms);
+}
+
+TEST(GenerationStatsTest, SequentialEngineCountsDraws) {
+  if constexpr (!Stats::ENABLED) GTEST_SKIP() << "Built with TARTARUS_ENABLE_STATS=OFF";
+
+  PathGenerator::Config config;
+  config.minRooms = 20;
+  config.maxRooms = 20;
+  config.branchProbability = 0.0f;
+
+  std::mt19937 engine(5);
+  GenerationStats stats;
+  PathGenerator generator(engine);
+  generator.SetConfig(config);
+  generator.SetStats(&stats);
+  generator.GeneratePath();
+
+  // One bounded draw for the length (20 of 1 rejects nothing), one word per room
+  EXPECT_GE(stats.rngDraws, 21u);
+}
+
+TEST(GenerationStatsTest, ReadsInstalledAllocationCounter) {
+  if constexpr (!Stats::ENABLED) GTEST_SKIP() << "Built with TARTARUS_ENABLE_STATS=OFF";
+
+  Stats::SetAllocationCounter(&ReadFakeAllocations);
+  GenerationStats stats;
+  PathGenerator generator(uint64_t{1});
+  generator.SetStats(&stats);
+  generator.GeneratePath();
+  Stats::SetAllocationCounter(nullptr);
+
+  EXPECT_EQ(stats.allocations, 3u);
+}
+
+TEST(GenerationStatsTest, ValidatorAccumulatesValidatePhase) {
+  if constexpr (!Stats::ENABLED) GTEST_SKIP() << "Built with TARTARUS_ENABLE_STATS=OFF";
+
+  GenerationStats stats;
+  PathGenerator generator(uint64_t{3});
+  generator.SetStats(&stats);
+  RunGraph graph = generator.GeneratePath();
+
+  GraphValidator validator;
+  validator.SetStats(&stats);
+  EXPECT_TRUE(validator.Validate(graph).isValid);
+  const uint64_t once = stats.GetPhaseNanos(GenerationStats::Phase::Validate);
+  EXPECT_GT(once, 0u);
+  validator.Validate(graph);
+  EXPECT_GT(stats.GetPhaseNanos(GenerationStats::Phase::Validate), once);
+  EXPECT_GT(stats.roomsCreated, 0u);  // Validation does not reset generation counters
+}
+
+TEST(GenerationStatsTest, BatchFillsOneRecordPerSeed) {
+  if constexpr (!Stats::ENABLED) GTEST_SKIP() << "Built with TARTARUS_ENABLE_STATS=OFF";
+
+  const std::vector<uint64_t> seeds = {1, 2, 3, 4, 5, 6, 7, 8};
+  std::vector<GenerationStats> stats(seeds.size());
+  auto runs = PathGenerator::GenerateBatch(seeds, PathGenerator::Config{}, 4, stats);
+
+  StatsAggregator aggregator;
+  for (size_t i = 0; i < seeds.size(); ++i) {
+    EXPECT_EQ(stats[i].roomsCreated, runs[i].GetNodeCount());
+    aggregator.Add(stats[i]);
+  }
+  EXPECT_EQ(aggregator.GetRunCount(), seeds.size());
+  EXPECT_GT(aggregator.GetTotalLatency().GetPercentile(99.0), 0u);
+}
+
+TEST(GenerationStatsTest, BatchRejectsMismatchedStats) {
+  const std::vector<uint64_t> seeds = {1, 2, 3};
+  std::vector<GenerationStats> stats(2);
+  EXPECT_THROW(PathGenerator::GenerateBatch(seeds, PathGenerator::Config{}, 1, stats),
+               std::invalid_argument);
+}
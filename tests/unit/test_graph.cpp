@@ -1,6 +1,11 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+
+#include "../test_utils.h"
 #include "core/GraphValidator.h"
+#include "core/IncrementalValidator.h"
+#include "core/ReachabilityIndex.h"
 #include "core/RunGraph.h"
 
 /**
@@ -124,6 +129,418 @@ TEST(RunGraphTest, GetAllNodesReturnsAllNodes) {
   EXPECT_EQ(nodes.size(), 3);
 }
 
+/**
+ * Test Suite: Finalized Storage
+ * Testing contiguous node storage and CSR edges
+ */
+
+TEST(RunGraphFinalizeTest, AssignsSequentialIndices) {
+  RunGraph graph;
+
+  auto* first = graph.AddRoom("first", Room::Type::Combat);
+  auto* second = graph.AddRoom("second", Room::Type::Boss);
+
+  EXPECT_EQ(first->GetIndex(), 0u);
+  EXPECT_EQ(second->GetIndex(), 1u);
+}
+
+TEST(RunGraphFinalizeTest, PacksEdgesIntoCsrArrays) {
+  RunGraph graph;
+
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  auto* branch1 = graph.AddRoom("branch1", Room::Type::Combat);
+  auto* branch2 = graph.AddRoom("branch2", Room::Type::Treasure);
+  auto* end = graph.AddRoom("end", Room::Type::Boss);
+
+  graph.SetStartNode(start);
+  graph.Connect(start, branch1);
+  graph.Connect(start, branch2);
+  graph.Connect(branch1, end);
+  graph.Connect(branch2, end);
+
+  graph.Finalize();
+
+  ASSERT_TRUE(graph.IsFinalized());
+  EXPECT_EQ(graph.GetNodeCount(), 4);
+  EXPECT_EQ(graph.GetEdgeCount(), 4);
+
+  auto offsets = graph.GetEdgeOffsets();
+  auto targets = graph.GetEdgeTargets();
+  ASSERT_EQ(offsets.size(), 5);
+  EXPECT_EQ(offsets[0], 0u);
+  EXPECT_EQ(offsets[1], 2u);
+  EXPECT_EQ(offsets[4], 4u);
+  EXPECT_EQ(targets[0], 1u);
+  EXPECT_EQ(targets[1], 2u);
+  EXPECT_EQ(targets[2], 3u);
+}
+
+TEST(RunGraphFinalizeTest, PreservesRoomsAndTraversal) {
+  RunGraph graph;
+
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  auto* boss = graph.AddRoom("boss", Room::Type::Boss);
+  start->SetDepth(0);
+  boss->SetDepth(1);
+  graph.SetStartNode(start);
+  graph.Connect(start, boss);
+
+  graph.Finalize();
+
+  const auto* packedStart = graph.GetStartNode();
+  ASSERT_NE(packedStart, nullptr);
+  EXPECT_EQ(packedStart, graph.GetNode(0));
+  EXPECT_EQ(packedStart->GetRoom()->GetId(), "start");
+  ASSERT_EQ(packedStart->GetNextRooms().size(), 1);
+  EXPECT_EQ(packedStart->GetNextRooms()[0], graph.GetNode(1));
+  EXPECT_EQ(packedStart->GetNextRooms()[0]->GetRoom()->GetType(), Room::Type::Boss);
+  EXPECT_EQ(graph.GetNode(1)->GetDepth(), 1);
+  EXPECT_TRUE(graph.GetNode(1)->GetNextRooms().empty());
+}
+
+TEST(RunGraphFinalizeTest, NodesAreContiguous) {
+  RunGraph graph;
+  for (int i = 0; i < 16; ++i) {
+    graph.AddRoom("room_" + std::to_string(i), Room::Type::Combat);
+  }
+
+  graph.Finalize();
+
+  for (RunGraph::NodeIndex i = 1; i < 16; ++i) {
+    EXPECT_EQ(graph.GetNode(i), graph.GetNode(i - 1) + 1);
+  }
+}
+
+TEST(RunGraphFinalizeTest, FinalizedGraphRejectsMutation) {
+  RunGraph graph;
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  graph.SetStartNode(start);
+  graph.Finalize();
+
+  EXPECT_THROW(graph.AddRoom("late", Room::Type::Combat), std::logic_error);
+  EXPECT_THROW(graph.GetNode(0)->AddConnection(graph.GetNode(0)), std::logic_error);
+}
+
+TEST(RunGraphFinalizeTest, RejectsEdgesToForeignNodes) {
+  RunGraph graph;
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  RunGraph::Node outsider(std::make_unique<Room>("outsider", Room::Type::Boss));
+  start->AddConnection(&outsider);
+
+  EXPECT_THROW(graph.Finalize(), std::invalid_argument);
+  EXPECT_FALSE(graph.IsFinalized());
+}
+
+TEST(RunGraphFinalizeTest, FinalizedGraphValidates) {
+  RunGraph graph;
+
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  auto* boss = graph.AddRoom("boss", Room::Type::Boss);
+  graph.SetStartNode(start);
+  graph.Connect(start, boss);
+  graph.Finalize();
+
+  GraphValidator validator;
+  EXPECT_TRUE(validator.Validate(graph).isValid);
+}
+
+/**
+ * Test Suite: Path Analysis
+ * Testing cached distances and critical path computation
+ */
+
+namespace {
+// start -> a -> b -> boss, with a shortcut start -> boss and a side room off a
+struct ShortcutGraph {
+  RunGraph graph;
+  RunGraph::Node* start = graph.AddRoom("start", Room::Type::Combat);
+  RunGraph::Node* a = graph.AddRoom("a", Room::Type::Elite);
+  RunGraph::Node* b = graph.AddRoom("b", Room::Type::Shop);
+  RunGraph::Node* boss = graph.AddRoom("boss", Room::Type::Boss);
+  RunGraph::Node* side = graph.AddRoom("side", Room::Type::Treasure);
+
+  ShortcutGraph() {
+    graph.SetStartNode(start);
+    graph.Connect(start, a);
+    graph.Connect(a, b);
+    graph.Connect(b, boss);
+    graph.Connect(start, boss);
+    graph.Connect(a, side);
+  }
+};
+}  // namespace
+
+TEST(RunGraphPathTest, ComputesShortestAndLongestDistances) {
+  ShortcutGraph fixture;
+  const auto shortest = fixture.graph.GetDistances(RunGraph::DepthMetric::Shortest);
+  const auto longest = fixture.graph.GetDistances(RunGraph::DepthMetric::Longest);
+
+  EXPECT_EQ(std::vector<int>(shortest.begin(), shortest.end()), (std::vector<int>{0, 1, 2, 1, 2}));
+  EXPECT_EQ(std::vector<int>(longest.begin(), longest.end()), (std::vector<int>{0, 1, 2, 3, 2}));
+}
+
+TEST(RunGraphPathTest, CriticalPathIsLongestPathToBoss) {
+  ShortcutGraph fixture;
+  const auto path = fixture.graph.GetCriticalPath();
+  EXPECT_EQ(std::vector<RunGraph::NodeIndex>(path.begin(), path.end()),
+            (std::vector<RunGraph::NodeIndex>{0, 1, 2, 3}));
+
+  fixture.graph.MarkCriticalPath();
+  EXPECT_TRUE(fixture.b->IsOnCriticalPath());
+  EXPECT_FALSE(fixture.side->IsOnCriticalPath());
+}
+
+TEST(RunGraphPathTest, AssignsDepths) {
+  ShortcutGraph fixture;
+  fixture.graph.AssignDepths(RunGraph::DepthMetric::Shortest);
+  EXPECT_EQ(fixture.boss->GetDepth(), 1);
+  fixture.graph.AssignDepths();
+  EXPECT_EQ(fixture.boss->GetDepth(), 3);
+  EXPECT_EQ(fixture.side->GetDepth(), 2);
+}
+
+TEST(RunGraphPathTest, EqualLengthBranchesPreferLowerIndices) {
+  // The spine 0 -> 1 -> 2 and the branch 0 -> 3 -> 2 tie; the spine wins
+  RunGraph graph;
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  auto* middle = graph.AddRoom("middle", Room::Type::Combat);
+  auto* boss = graph.AddRoom("boss", Room::Type::Boss);
+  auto* branch = graph.AddRoom("branch", Room::Type::Treasure);
+  graph.SetStartNode(start);
+  graph.Connect(start, middle);
+  graph.Connect(middle, boss);
+  graph.Connect(start, branch);
+  graph.Connect(branch, boss);
+
+  const auto path = graph.GetCriticalPath();
+  EXPECT_EQ(std::vector<RunGraph::NodeIndex>(path.begin(), path.end()),
+            (std::vector<RunGraph::NodeIndex>{0, 1, 2}));
+}
+
+TEST(RunGraphPathTest, UnreachableNodesAndMissingBoss) {
+  RunGraph graph;
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  auto* next = graph.AddRoom("next", Room::Type::Combat);
+  graph.AddRoom("isolated_boss", Room::Type::Boss);
+  graph.SetStartNode(start);
+  graph.Connect(start, next);
+
+  EXPECT_EQ(graph.GetDistances(RunGraph::DepthMetric::Longest)[2], RunGraph::UNREACHABLE);
+  EXPECT_TRUE(graph.GetCriticalPath().empty());
+}
+
+TEST(RunGraphPathTest, MutationInvalidatesCache) {
+  ShortcutGraph fixture;
+  EXPECT_EQ(fixture.graph.GetDistances(RunGraph::DepthMetric::Longest)[3], 3);
+
+  auto* detour = fixture.graph.AddRoom("detour", Room::Type::Combat);
+  fixture.graph.Connect(fixture.side, detour);
+  fixture.graph.Connect(detour, fixture.boss);
+  EXPECT_EQ(fixture.graph.GetDistances(RunGraph::DepthMetric::Longest)[3], 4);
+  EXPECT_EQ(fixture.graph.GetCriticalPath().size(), 5u);
+
+  fixture.graph.SetStartNode(fixture.a);
+  EXPECT_EQ(fixture.graph.GetDistances(RunGraph::DepthMetric::Longest)[0], RunGraph::UNREACHABLE);
+}
+
+TEST(RunGraphPathTest, FinalizedGraphComputesCacheOnce) {
+  ShortcutGraph fixture;
+  fixture.graph.Finalize();
+  ASSERT_TRUE(fixture.graph.PrecomputePaths());
+
+  const auto first = fixture.graph.GetDistances(RunGraph::DepthMetric::Longest);
+  const auto second = fixture.graph.GetDistances(RunGraph::DepthMetric::Longest);
+  EXPECT_EQ(first.data(), second.data());
+  EXPECT_EQ(first[3], 3);
+  EXPECT_EQ(fixture.graph.GetCriticalPath().size(), 4u);
+}
+
+TEST(RunGraphPathTest, RequiresStartAndAcyclicGraph) {
+  RunGraph graph;
+  auto* a = graph.AddRoom("a", Room::Type::Combat);
+  auto* b = graph.AddRoom("b", Room::Type::Boss);
+  EXPECT_THROW(graph.GetDistances(RunGraph::DepthMetric::Shortest), std::logic_error);
+
+  graph.SetStartNode(a);
+  graph.Connect(a, b);
+  graph.Connect(b, a);
+  EXPECT_THROW(graph.GetCriticalPath(), std::logic_error);
+
+  // Finalizing a cyclic graph still succeeds; queries keep reporting the cycle
+  graph.Finalize();
+  EXPECT_THROW(graph.GetDistances(RunGraph::DepthMetric::Longest), std::logic_error);
+}
+
+TEST(RunGraphPathTest, IgnoresCyclesUnreachableFromStart) {
+  ShortcutGraph fixture;
+  auto* x = fixture.graph.AddRoom("x", Room::Type::Combat);
+  auto* y = fixture.graph.AddRoom("y", Room::Type::Combat);
+  fixture.graph.Connect(x, y);
+  fixture.graph.Connect(y, x);
+  fixture.graph.Connect(y, fixture.boss);
+
+  // The validator reports the component as disconnected, not as a cycle
+  GraphValidator validator;
+  const auto result = validator.Validate(fixture.graph);
+  EXPECT_TRUE(result.HasError(GraphValidator::ValidationError::DisconnectedNode));
+  EXPECT_FALSE(result.HasError(GraphValidator::ValidationError::CycleDetected));
+  const auto longest = fixture.graph.GetDistances(RunGraph::DepthMetric::Longest);
+  EXPECT_EQ(longest[3], 3);
+  EXPECT_EQ(longest[x->GetIndex()], RunGraph::UNREACHABLE);
+  EXPECT_EQ(fixture.graph.GetCriticalPath().size(), 4u);
+
+  // Once reachable, the cycle is reported again
+  fixture.graph.Connect(fixture.side, x);
+  EXPECT_THROW(fixture.graph.GetCriticalPath(), std::logic_error);
+}
+
+TEST(RunGraphPathTest, IgnoresForeignEdges) {
+  RunGraph graph;
+  RunGraph other;
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  auto* boss = graph.AddRoom("boss", Room::Type::Boss);
+  auto* foreign = other.AddRoom("foreign", Room::Type::Combat);
+  graph.SetStartNode(start);
+  graph.Connect(start, foreign);
+  graph.Connect(start, boss);
+
+  EXPECT_EQ(graph.GetCriticalPath().size(), 2u);
+}
+
+/**
+ * Test Suite: Reachability Index
+ * Both representations must agree with a graph search
+ */
+
+namespace {
+std::vector<bool> ReachableFrom(const RunGraph& graph, RunGraph::NodeIndex from) {
+  std::vector<bool> seen(graph.GetNodeCount(), false);
+  std::vector<const RunGraph::Node*> stack = {graph.GetNode(from)};
+  seen[from] = true;
+  while (!stack.empty()) {
+    const RunGraph::Node* node = stack.back();
+    stack.pop_back();
+    for (const RunGraph::Node* next : node->GetNextRooms()) {
+      if (!seen[next->GetIndex()]) {
+        seen[next->GetIndex()] = true;
+        stack.push_back(next);
+      }
+    }
+  }
+  return seen;
+}
+
+// Spine of spineLength rooms; every third room starts a one-room branch
+// that rejoins two rooms later
+RunGraph BuildBranchingRun(int spineLength) {
+  RunGraph graph;
+  std::vector<RunGraph::Node*> spine;
+  for (int i = 0; i < spineLength; ++i) {
+    spine.push_back(graph.AddRoom("room_" + std::to_string(i), Room::Type::Combat));
+    if (i > 0) graph.Connect(spine[i - 1], spine[i]);
+  }
+  for (int i = 0; i + 2 < spineLength; i += 3) {
+    auto* branch = graph.AddRoom("branch_" + std::to_string(i), Room::Type::Treasure);
+    graph.Connect(spine[i], branch);
+    graph.Connect(branch, spine[i + 2]);
+  }
+  graph.Finalize();
+  return graph;
+}
+
+void ExpectMatchesSearch(const RunGraph& graph, const ReachabilityIndex& index) {
+  for (RunGraph::NodeIndex from = 0; from < graph.GetNodeCount(); ++from) {
+    const std::vector<bool> expected = ReachableFrom(graph, from);
+    for (RunGraph::NodeIndex to = 0; to < graph.GetNodeCount(); ++to) {
+      ASSERT_EQ(index.CanReach(from, to), expected[to]) << from << " -> " << to;
+    }
+  }
+}
+}  // namespace
+
+TEST(ReachabilityIndexTest, AnswersChainQueriesInBothModes) {
+  RunGraph graph;
+  RunGraph::Node* previous = nullptr;
+  for (int i = 0; i < 5; ++i) {
+    auto* node = graph.AddRoom("room_" + std::to_string(i), Room::Type::Combat);
+    if (previous) graph.Connect(previous, node);
+    previous = node;
+  }
+
+  for (const size_t budget : {ReachabilityIndex::DEFAULT_MEMORY_BUDGET, size_t{0}}) {
+    ReachabilityIndex index(graph, budget);
+    EXPECT_EQ(index.GetMode(), budget ? ReachabilityIndex::Mode::Closure
+                                      : ReachabilityIndex::Mode::Intervals);
+    EXPECT_TRUE(index.CanReach(0, 4));
+    EXPECT_TRUE(index.CanReach(2, 2));
+    EXPECT_FALSE(index.CanReach(4, 0));
+    EXPECT_TRUE(index.CanReach(graph.GetNode(1), graph.GetNode(3)));
+  }
+}
+
+TEST(ReachabilityIndexTest, MatchesSearchOnRandomDags) {
+  TestUtils::SeededRandom random(2024);
+  for (int trial = 0; trial < 20; ++trial) {
+    RunGraph graph;
+    std::vector<RunGraph::Node*> nodes;
+    const int nodeCount = random.RandomInt(1, 80);
+    for (int i = 0; i < nodeCount; ++i) {
+      nodes.push_back(graph.AddRoom("room_" + std::to_string(i), Room::Type::Combat));
+    }
+    // Edges from lower to higher positions in a shuffled order keep it acyclic
+    std::vector<int> order(nodeCount);
+    for (int i = 0; i < nodeCount; ++i) order[i] = i;
+    std::shuffle(order.begin(), order.end(), random.GetEngine());
+    const int edgeCount = random.RandomInt(0, nodeCount * 2);
+    for (int e = 0; e < edgeCount && nodeCount > 1; ++e) {
+      int a = random.RandomInt(0, nodeCount - 1);
+      int b = random.RandomInt(0, nodeCount - 1);
+      if (a == b) continue;
+      if (a > b) std::swap(a, b);
+      graph.Connect(nodes[order[a]], nodes[order[b]]);
+    }
+
+    ExpectMatchesSearch(graph, ReachabilityIndex(graph));
+    ExpectMatchesSearch(graph, ReachabilityIndex(graph, 0));
+    graph.Finalize();
+    ExpectMatchesSearch(graph, ReachabilityIndex(graph, 0));
+    if (::testing::Test::HasFailure()) FAIL() << "trial " << trial;
+  }
+}
+
+TEST(ReachabilityIndexTest, FallsBackToIntervalsAboveBudget) {
+  RunGraph graph = BuildBranchingRun(2000);
+  const size_t closureBytes = ReachabilityIndex::ClosureBytes(graph.GetNodeCount());
+
+  ReachabilityIndex closure(graph, closureBytes);
+  ReachabilityIndex intervals(graph, closureBytes - 1);
+  EXPECT_EQ(closure.GetMode(), ReachabilityIndex::Mode::Closure);
+  EXPECT_EQ(intervals.GetMode(), ReachabilityIndex::Mode::Intervals);
+
+  // Runs need only a few intervals per node
+  EXPECT_LT(intervals.GetMemoryBytes(), 40 * graph.GetNodeCount());
+  for (RunGraph::NodeIndex from = 0; from < graph.GetNodeCount(); from += 97) {
+    for (RunGraph::NodeIndex to = 0; to < graph.GetNodeCount(); to += 13) {
+      ASSERT_EQ(closure.CanReach(from, to), intervals.CanReach(from, to)) << from << " -> " << to;
+    }
+  }
+}
+
+TEST(ReachabilityIndexTest, RejectsCycles) {
+  RunGraph graph;
+  auto* a = graph.AddRoom("a", Room::Type::Combat);
+  auto* b = graph.AddRoom("b", Room::Type::Combat);
+  graph.Connect(a, b);
+  graph.Connect(b, a);
+  EXPECT_THROW(ReachabilityIndex index(graph), std::invalid_argument);
+}
+
+TEST(ReachabilityIndexTest, HandlesEmptyGraph) {
+  RunGraph graph;
+  EXPECT_EQ(ReachabilityIndex(graph).GetNodeCount(), 0u);
+  EXPECT_EQ(ReachabilityIndex(graph, 0).GetNodeCount(), 0u);
+}
+
 /**
  * Test Suite: Graph Validation
  * Testing graph validation logic
@@ -244,4 +661,243 @@ TEST(GraphValidatorTest, AllowsBranchinPaths) {
   auto result = validator.Validate(graph);
 
   EXPECT_TRUE(result.isValid) << "Branching paths should be valid";
-}
\ No newline at end of file
+}
+/**
+ * Test Suite: Large Graph Validation
+ * Testing the validator stays linear and non-recursive on huge runs
+ */
+
+namespace {
+constexpr int LARGE_GRAPH_SIZE = 1'000'000;
+
+// Builds start -> ... -> boss with LARGE_GRAPH_SIZE rooms
+RunGraph BuildLongChain() {
+  RunGraph graph;
+  graph.Reserve(LARGE_GRAPH_SIZE);
+
+  RunGraph::Node* previous = nullptr;
+  for (int i = 0; i < LARGE_GRAPH_SIZE; ++i) {
+    auto type = (i == LARGE_GRAPH_SIZE - 1) ? Room::Type::Boss : Room::Type::Combat;
+    auto* node = graph.AddRoom("room_" + std::to_string(i + 1), type);
+    if (previous) {
+      graph.Connect(previous, node);
+    } else {
+      graph.SetStartNode(node);
+    }
+    previous = node;
+  }
+  return graph;
+}
+}  // namespace
+
+TEST(GraphValidatorLargeTest, ValidatesMillionRoomChain) {
+  RunGraph graph = BuildLongChain();
+
+  GraphValidator validator;
+  auto result = validator.Validate(graph);
+
+  EXPECT_TRUE(result.isValid);
+}
+
+TEST(GraphValidatorLargeTest, ValidatesFinalizedMillionRoomChain) {
+  RunGraph graph = BuildLongChain();
+  graph.Finalize();
+
+  GraphValidator validator;
+  auto result = validator.Validate(graph);
+
+  EXPECT_TRUE(result.isValid);
+}
+
+TEST(GraphValidatorLargeTest, DetectsCycleAtEndOfMillionRoomChain) {
+  RunGraph graph = BuildLongChain();
+  auto* last = graph.GetNode(LARGE_GRAPH_SIZE - 1);
+  graph.Connect(last, graph.GetNode(LARGE_GRAPH_SIZE / 2));
+  graph.Finalize();
+
+  GraphValidator validator;
+  auto result = validator.Validate(graph);
+
+  EXPECT_FALSE(result.isValid);
+  EXPECT_TRUE(result.HasError(GraphValidator::ValidationError::CycleDetected));
+  EXPECT_FALSE(result.HasError(GraphValidator::ValidationError::DisconnectedNode));
+}
+
+TEST(GraphValidatorLargeTest, ValidatesMillionRoomDiamondLattice) {
+  // Pairs of parallel rooms that all merge back: every node has two
+  // predecessors, which would make a naive DFS revisit shared subgraphs
+  RunGraph graph;
+  graph.Reserve(LARGE_GRAPH_SIZE + 1);
+
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  graph.SetStartNode(start);
+  RunGraph::Node* left = start;
+  RunGraph::Node* right = start;
+  for (int i = 0; i < LARGE_GRAPH_SIZE / 2 - 1; ++i) {
+    auto* nextLeft = graph.AddRoom("left_" + std::to_string(i), Room::Type::Combat);
+    auto* nextRight = graph.AddRoom("right_" + std::to_string(i), Room::Type::Elite);
+    graph.Connect(left, nextLeft);
+    graph.Connect(left, nextRight);
+    if (right != left) {
+      graph.Connect(right, nextLeft);
+      graph.Connect(right, nextRight);
+    }
+    left = nextLeft;
+    right = nextRight;
+  }
+  auto* boss = graph.AddRoom("boss", Room::Type::Boss);
+  graph.Connect(left, boss);
+  graph.Connect(right, boss);
+  graph.Finalize();
+
+  ASSERT_GE(graph.GetNodeCount(), static_cast<size_t>(LARGE_GRAPH_SIZE - 1));
+
+  GraphValidator validator;
+  auto result = validator.Validate(graph);
+
+  EXPECT_TRUE(result.isValid);
+}
+
+/**
+ * Test Suite: Incremental Validation
+ * Incremental state must always agree with a full validation
+ */
+
+namespace {
+void ExpectSameResult(const GraphValidator::ValidationResult& incremental,
+                      const GraphValidator::ValidationResult& full) {
+  EXPECT_EQ(incremental.isValid, full.isValid);
+  EXPECT_EQ(incremental.errors, full.errors);
+  EXPECT_EQ(incremental.errorMessages, full.errorMessages);
+}
+}  // namespace
+
+TEST(IncrementalValidatorTest, TracksChainAsItGrows) {
+  RunGraph graph;
+  IncrementalValidator incremental(graph);
+
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  EXPECT_TRUE(incremental.Validate().HasError(GraphValidator::ValidationError::NoStartNode));
+
+  graph.SetStartNode(start);
+  auto* middle = graph.AddRoom("middle", Room::Type::Shop);
+  auto* boss = graph.AddRoom("boss", Room::Type::Boss);
+  EXPECT_TRUE(incremental.Validate().HasError(GraphValidator::ValidationError::DisconnectedNode));
+  EXPECT_EQ(incremental.GetDeadEndCount(), 2u);
+
+  graph.Connect(start, middle);
+  graph.Connect(middle, boss);
+
+  EXPECT_TRUE(incremental.Validate().isValid);
+  EXPECT_EQ(incremental.GetReachableCount(), 3u);
+  EXPECT_EQ(incremental.GetBossCount(), 1u);
+  EXPECT_EQ(incremental.GetDeadEndCount(), 0u);
+}
+
+TEST(IncrementalValidatorTest, ReordersBackwardEdges) {
+  RunGraph graph;
+  IncrementalValidator incremental(graph);
+
+  // Added in reverse so every edge initially points backwards in the order
+  auto* boss = graph.AddRoom("boss", Room::Type::Boss);
+  auto* middle = graph.AddRoom("middle", Room::Type::Combat);
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  graph.SetStartNode(start);
+  graph.Connect(middle, boss);
+  graph.Connect(start, middle);
+
+  EXPECT_TRUE(incremental.Validate().isValid);
+  const auto order = incremental.GetTopologicalOrder();
+  ASSERT_EQ(order.size(), 3u);
+  EXPECT_EQ(order[0], start->GetIndex());
+  EXPECT_EQ(order[1], middle->GetIndex());
+  EXPECT_EQ(order[2], boss->GetIndex());
+
+  graph.Connect(boss, start);
+  EXPECT_TRUE(incremental.HasCycle());
+  EXPECT_TRUE(incremental.GetTopologicalOrder().empty());
+  EXPECT_TRUE(incremental.Validate().HasError(GraphValidator::ValidationError::CycleDetected));
+}
+
+TEST(IncrementalValidatorTest, SyncsWithExistingGraphAndDetaches) {
+  RunGraph graph;
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  auto* boss = graph.AddRoom("boss", Room::Type::Boss);
+  graph.SetStartNode(start);
+  graph.Connect(start, boss);
+
+  {
+    IncrementalValidator incremental(graph);
+    EXPECT_EQ(graph.GetMutationObserver(), &incremental);
+    EXPECT_THROW(IncrementalValidator second(graph), std::logic_error);
+    EXPECT_TRUE(incremental.Validate().isValid);
+  }
+  EXPECT_EQ(graph.GetMutationObserver(), nullptr);
+}
+
+TEST(IncrementalValidatorTest, ForeignEdgeIsDisconnected) {
+  RunGraph graph;
+  RunGraph other;
+  IncrementalValidator incremental(graph);
+
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  auto* boss = graph.AddRoom("boss", Room::Type::Boss);
+  auto* foreign = other.AddRoom("foreign", Room::Type::Combat);
+  graph.SetStartNode(start);
+  graph.Connect(start, boss);
+  graph.Connect(start, foreign);
+
+  GraphValidator validator;
+  ExpectSameResult(incremental.Validate(), validator.Validate(graph));
+
+  graph.SetStartNode(foreign);
+  ExpectSameResult(incremental.Validate(), validator.Validate(graph));
+}
+
+TEST(IncrementalValidatorTest, RandomEditsMatchFullValidation) {
+  constexpr int EDIT_COUNT = 400;
+
+  for (uint32_t seed = 1; seed <= 25; ++seed) {
+    TestUtils::SeededRandom random(seed);
+    RunGraph graph;
+    IncrementalValidator incremental(graph);
+    GraphValidator validator;
+    std::vector<RunGraph::Node*> nodes;
+
+    // Mostly forward edges so many graphs stay acyclic for a while
+    const int backwardPercent = random.RandomInt(0, 3);
+    for (int edit = 0; edit < EDIT_COUNT; ++edit) {
+      const int action = random.RandomInt(0, 99);
+      if (nodes.empty() || action < 30) {
+        const Room::Type type =
+            random.RandomInt(0, 9) == 0 ? Room::Type::Boss : Room::Type::Combat;
+        nodes.push_back(graph.AddRoom("room_" + std::to_string(nodes.size()), type));
+      } else if (action < 33) {
+        graph.SetStartNode(nodes[random.RandomInt(0, static_cast<int>(nodes.size()) - 1)]);
+      } else {
+        int from = random.RandomInt(0, static_cast<int>(nodes.size()) - 1);
+        int to = random.RandomInt(0, static_cast<int>(nodes.size()) - 1);
+        if (from > to && random.RandomInt(0, 99) >= backwardPercent) {
+          std::swap(from, to);
+        }
+        graph.Connect(nodes[from], nodes[to]);
+      }
+
+      ExpectSameResult(incremental.Validate(), validator.Validate(graph));
+      if (!incremental.HasCycle()) {
+        // Every edge must point forward in the maintained order
+        const auto order = incremental.GetTopologicalOrder();
+        std::vector<size_t> position(order.size());
+        for (size_t i = 0; i < order.size(); ++i) position[order[i]] = i;
+        for (const auto* node : nodes) {
+          for (const auto* next : node->GetNextRooms()) {
+            ASSERT_LT(position[node->GetIndex()], position[next->GetIndex()]) << "seed " << seed;
+          }
+        }
+      }
+      if (::testing::Test::HasFailure()) {
+        FAIL() << "seed " << seed << ", edit " << edit;
+      }
+    }
+  }
+}
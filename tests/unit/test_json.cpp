@@ -0,0 +1,207 @@
+#include <gtest/gtest.h>
+
+#include <sstream>
+#include <vector>
+
+#include "../test_utils.h"
+#include "generation/PathGenerator.h"
+#include "io/JsonSax.h"
+#include "io/RunJson.h"
+
+namespace {
+using TestUtils::GenerateRun;
+
+/**
+ * Records SAX events as compact tokens for assertions
+ */
+struct EventRecorder {
+  std::vector<std::string> events;
+
+  void StartObject() { events.push_back("{"); }
+  void EndObject() { events.push_back("}"); }
+  void StartArray() { events.push_back("["); }
+  void EndArray() { events.push_back("]"); }
+  void Key(std::string_view key) { events.push_back("k:" + std::string(key)); }
+  void String(std::string_view value) { events.push_back("s:" + std::string(value)); }
+  void Integer(int64_t value) { events.push_back("i:" + std::to_string(value)); }
+  void Double(double value) { events.push_back("d:" + std::to_string(value)); }
+  void Bool(bool value) { events.push_back(value ? "true" : "false"); }
+  void Null() { events.push_back("null"); }
+};
+}  // namespace
+
+/**
+ * Test Suite: SAX parser
+ * Testing event order, escapes and error reporting
+ */
+
+TEST(JsonSaxTest, ReportsEventsInOrder) {
+  EventRecorder recorder;
+  std::string scratch;
+  JsonSax::Parse(R"({"a":[1,-2.5,true,null],"b":{},"c":"x"})", recorder, scratch);
+
+  std::vector<std::string> expected = {"{",    "k:a", "[", "i:1", "d:-2.500000", "true", "null",
+                                       "]",    "k:b", "{", "}",   "k:c",         "s:x",  "}"};
+  EXPECT_EQ(recorder.events, expected);
+}
+
+TEST(JsonSaxTest, DecodesEscapes) {
+  EventRecorder recorder;
+  std::string scratch;
+  JsonSax::Parse(R"(["a\"b\\c\n", "\u00e9\ud83d\ude00"])", recorder, scratch);
+
+  ASSERT_EQ(recorder.events.size(), 4);
+  EXPECT_EQ(recorder.events[1], "s:a\"b\\c\n");
+  EXPECT_EQ(recorder.events[2], "s:\xC3\xA9\xF0\x9F\x98\x80");
+}
+
+TEST(JsonSaxTest, RejectsMalformedInput) {
+  EventRecorder recorder;
+  std::string scratch;
+  EXPECT_THROW(JsonSax::Parse(R"({"a":1,})", recorder, scratch), JsonSax::ParseError);
+  EXPECT_THROW(JsonSax::Parse(R"([1 2])", recorder, scratch), JsonSax::ParseError);
+  EXPECT_THROW(JsonSax::Parse(R"({"a":1} x)", recorder, scratch), JsonSax::ParseError);
+  EXPECT_THROW(JsonSax::Parse(R"(["unterminated)", recorder, scratch), JsonSax::ParseError);
+  EXPECT_THROW(JsonSax::Parse(std::string(JsonSax::MAX_DEPTH + 1, '['), recorder, scratch),
+               JsonSax::ParseError);
+}
+
+/**
+ * Test Suite: Run JSON
+ * Testing round trips of rewards, rooms and runs
+ */
+
+TEST(RunJsonTest, RoundTripsReward) {
+  std::string json;
+  RunJson::AppendReward(json, Reward::Data(Reward::Type::Boon, Reward::God::Artemis));
+  EXPECT_EQ(json, R"({"type":"Boon","god":"Artemis","quantity":1})");
+
+  auto reward = RunJson::ParseReward(json);
+  EXPECT_EQ(reward.type, Reward::Type::Boon);
+  EXPECT_EQ(reward.god, Reward::God::Artemis);
+}
+
+TEST(RunJsonTest, RoundTripsRoom) {
+  Room room("quote\"room", Room::Type::Fountain);
+  room.SetBiome(Biome::Type::Elysium);
+  room.SetDifficulty(1.75f);
+  room.AddExit({3.5f, -2.0f}, Room::Direction::East);
+  room.AddReward(Reward::Data(Reward::Type::Gold, 80));
+
+  std::string json;
+  RunJson::AppendRoom(json, room);
+  auto parsed = RunJson::ParseRoom(json);
+
+  EXPECT_EQ(parsed.GetId(), "quote\"room");
+  EXPECT_EQ(parsed.GetType(), Room::Type::Fountain);
+  EXPECT_EQ(parsed.GetBiome(), Biome::Type::Elysium);
+  EXPECT_FLOAT_EQ(parsed.GetDifficulty(), 1.75f);
+  ASSERT_EQ(parsed.GetExitCount(), 1);
+  EXPECT_FLOAT_EQ(parsed.GetExits()[0].position.y, -2.0f);
+  EXPECT_TRUE(parsed.HasExit(Room::Direction::East));
+  ASSERT_EQ(parsed.GetRewards().size(), 1);
+  EXPECT_EQ(parsed.GetRewards()[0].quantity, 80);
+}
+
+TEST(RunJsonTest, RoundTripsGeneratedRun) {
+  auto original = GenerateRun(42);
+
+  std::string json;
+  RunJson::AppendRun(json, original);
+  EXPECT_EQ(json.find('\n'), std::string::npos);
+
+  auto parsed = RunJson::ParseRun(json);
+  ASSERT_EQ(parsed.GetNodeCount(), original.GetNodeCount());
+  ASSERT_EQ(parsed.GetEdgeCount(), original.GetEdgeCount());
+  EXPECT_EQ(parsed.GetStartNode(), parsed.GetNode(0));
+  for (RunGraph::NodeIndex i = 0; i < original.GetNodeCount(); ++i) {
+    EXPECT_EQ(parsed.GetNode(i)->GetRoom()->GetId(), original.GetNode(i)->GetRoom()->GetId());
+    EXPECT_EQ(parsed.GetNode(i)->GetRoom()->GetType(), original.GetNode(i)->GetRoom()->GetType());
+    EXPECT_EQ(parsed.GetNode(i)->GetDepth(), original.GetNode(i)->GetDepth());
+  }
+}
+
+TEST(RunJsonTest, SkipsUnknownKeys) {
+  auto graph = RunJson::ParseRun(
+      R"({"version":3,"meta":{"tool":["x",{"y":1}]},"start":0,)"
+      R"("rooms":[{"id":"a","type":"Combat","notes":[1,2],"next":[1]},{"id":"b","type":"Boss"}]})");
+
+  ASSERT_EQ(graph.GetNodeCount(), 2);
+  EXPECT_EQ(graph.GetNode(1)->GetRoom()->GetType(), Room::Type::Boss);
+  EXPECT_EQ(graph.GetStartNode()->GetNextRooms()[0], graph.GetNode(1));
+}
+
+TEST(RunJsonTest, RejectsSchemaErrors) {
+  EXPECT_THROW(RunJson::ParseRun(R"({"rooms":[{"id":"a"}]})"), std::runtime_error);
+  EXPECT_THROW(RunJson::ParseRun(R"({"rooms":[{"id":"a","type":"Combat","next":[5]}]})"),
+               std::runtime_error);
+  EXPECT_THROW(RunJson::ParseRun(R"({"rooms":[{"id":"a","type":"Dragon"}]})"), std::runtime_error);
+  EXPECT_THROW(RunJson::ParseRun("[]"), std::runtime_error);
+  EXPECT_THROW(RunJson::ParseRoom("42"), std::runtime_error);
+}
+
+TEST(RunJsonTest, RejectsNonIntegerEdges) {
+  for (const char* next : {"1.5", "\"1\"", "true", "null", "{}", "[1]"}) {
+    const std::string json = std::string(R"({"start":0,"rooms":[{"id":"a","type":"Combat","next":[)") +
+                             next + R"(]},{"id":"b","type":"Boss"}]})";
+    EXPECT_THROW(RunJson::ParseRun(json), std::runtime_error) << next;
+  }
+}
+
+TEST(RunJsonTest, RejectsOverlongRoomIds) {
+  const std::string id(RoomId::MAX_LENGTH + 1, 'x');
+  EXPECT_THROW(RunJson::ParseRoom(R"({"id":")" + id + R"(","type":"Combat"})"), std::runtime_error);
+  EXPECT_NO_THROW(RunJson::ParseRoom(R"({"id":")" + id.substr(1) + R"(","type":"Combat"})"));
+}
+
+TEST(RunJsonTest, RejectsStartNodesOutsideTheGraph) {
+  RunGraph graph;
+  RunGraph other;
+  graph.AddRoom("a", Room::Type::Boss);
+  graph.SetStartNode(other.AddRoom("foreign", Room::Type::Combat));
+
+  std::string json = "prefix";
+  EXPECT_THROW(RunJson::AppendRun(json, graph), std::invalid_argument);
+  EXPECT_EQ(json, "prefix");
+}
+
+/**
+ * Test Suite: NDJSON streaming
+ * Testing one-run-per-line files
+ */
+
+TEST(NdjsonTest, StreamsManyRuns) {
+  std::stringstream stream;
+  {
+    NdjsonRunWriter writer(stream);
+    for (uint32_t seed = 1; seed <= 20; ++seed) {
+      writer.Write(GenerateRun(seed));
+    }
+    writer.Flush();
+  }
+
+  NdjsonRunReader reader(stream);
+  RunGraph graph;
+  uint32_t seed = 1;
+  while (reader.Next(graph)) {
+    EXPECT_EQ(graph.GetNodeCount(), GenerateRun(seed).GetNodeCount()) << "Seed " << seed;
+    ++seed;
+  }
+  EXPECT_EQ(seed, 21u);
+  EXPECT_EQ(reader.GetLineNumber(), 20u);
+}
+
+TEST(NdjsonTest, ReportsLineNumberOfBadRun) {
+  std::stringstream stream;
+  stream << R"({"rooms":[]})" << "\n\n" << R"({"rooms":[{"id":"a"}]})" << "\n";
+
+  NdjsonRunReader reader(stream);
+  RunGraph graph;
+  ASSERT_TRUE(reader.Next(graph));
+  try {
+    reader.Next(graph);
+    FAIL() << "Expected a parse error";
+  } catch (const std::runtime_error& e) {
+    EXPECT_NE(std::string(e.what()).find("line 3"), std::string::npos) << e.what();
+  }
+}
@@ -0,0 +1,236 @@
+#include <gtest/gtest.h>
+
+#include <map>
+#include <stdexcept>
+#include <string>
+#include <vector>
+
+#include "core/PathCounter.h"
+#include "generation/PathGenerator.h"
+#include "util/WideUint.h"
+
+namespace {
+using Wide = WideUint<4>;
+
+Wide PowerOfTwo(size_t exponent) {
+  Wide value;
+  value.SetWord(exponent / 64, uint64_t{1} << (exponent % 64));
+  return value;
+}
+
+// start, then diamondCount diamonds (split into two rooms, merge), then a boss
+RunGraph BuildDiamonds(int diamondCount) {
+  RunGraph graph;
+  auto* previous = graph.AddRoom("start", Room::Type::Combat);
+  graph.SetStartNode(previous);
+  for (int i = 0; i < diamondCount; ++i) {
+    const std::string suffix = std::to_string(i);
+    auto* left = graph.AddRoom("left_" + suffix, Room::Type::Combat);
+    auto* right = graph.AddRoom("right_" + suffix, Room::Type::Treasure);
+    auto* merge = graph.AddRoom("merge_" + suffix, Room::Type::Combat);
+    graph.Connect(previous, left);
+    graph.Connect(previous, right);
+    graph.Connect(left, merge);
+    graph.Connect(right, merge);
+    previous = merge;
+  }
+  graph.Connect(previous, graph.AddRoom("boss", Room::Type::Boss));
+  graph.Finalize();
+  return graph;
+}
+
+uint64_t CountByEnumeration(const RunGraph& graph, const RunGraph::Node* node) {
+  if (node->GetRoom()->GetType() == Room::Type::Boss) return 1;
+  uint64_t count = 0;
+  for (const RunGraph::Node* next : node->GetNextRooms()) {
+    count += CountByEnumeration(graph, next);
+  }
+  return count;
+}
+}  // namespace
+
+/**
+ * Test Suite: WideUint
+ * Testing carries, checked overflow and conversions
+ */
+
+TEST(WideUintTest, AddsAndSubtractsAcrossWords) {
+  Wide value = UINT64_MAX;
+  value += 1;
+  EXPECT_EQ(value, PowerOfTwo(64));
+  EXPECT_EQ(value.BitWidth(), 65u);
+  EXPECT_FALSE(value.FitsUint64());
+
+  value -= 1;
+  EXPECT_EQ(value, Wide(UINT64_MAX));
+  EXPECT_TRUE(value.FitsUint64());
+  EXPECT_EQ(PowerOfTwo(200) - 1 + 1, PowerOfTwo(200));
+}
+
+TEST(WideUintTest, ComparesMostSignificantWordFirst) {
+  EXPECT_LT(Wide(UINT64_MAX), PowerOfTwo(64));
+  EXPECT_GT(PowerOfTwo(130), PowerOfTwo(129) + PowerOfTwo(128));
+  EXPECT_LE(Wide(5), Wide(5));
+  EXPECT_TRUE(Wide().IsZero());
+}
+
+TEST(WideUintTest, ThrowsOnOverflow) {
+  Wide value = PowerOfTwo(255);
+  EXPECT_THROW(value += PowerOfTwo(255), std::overflow_error);
+}
+
+TEST(WideUintTest, FormatsDecimal) {
+  EXPECT_EQ(Wide().ToString(), "0");
+  EXPECT_EQ(Wide(1'000'000'000'000'000'000ULL).ToString(), "1000000000000000000");
+  EXPECT_EQ(PowerOfTwo(64).ToString(), "18446744073709551616");
+  EXPECT_EQ(PowerOfTwo(128).ToString(), "340282366920938463463374607431768211456");
+  EXPECT_DOUBLE_EQ(PowerOfTwo(100).ToDouble(), 1267650600228229401496703205376.0);
+}
+
+/**
+ * Test Suite: PathCounter
+ * Testing route counts and uniform route sampling
+ */
+
+TEST(PathCounterTest, CountsDiamondRoutes) {
+  RunGraph graph = BuildDiamonds(3);
+  PathCounter counter(graph);
+  EXPECT_EQ(counter.GetPathCount(), Wide(8));
+  EXPECT_EQ(counter.GetPathCountFrom(graph.GetNodeCount() - 1), Wide(1));  // Boss
+}
+
+TEST(PathCounterTest, MatchesEnumerationOnGeneratedRuns) {
+  PathGenerator::Config config;
+  config.branchProbability = 0.6f;
+  config.maxBranchLength = 3;
+  for (uint64_t seed = 0; seed < 10; ++seed) {
+    PathGenerator generator(seed);
+    generator.SetConfig(config);
+    RunGraph graph = generator.GeneratePath();
+
+    PathCounter counter(graph);
+    ASSERT_TRUE(counter.GetPathCount().FitsUint64());
+    EXPECT_EQ(counter.GetPathCount().ToUint64(), CountByEnumeration(graph, graph.GetStartNode()))
+        << "seed " << seed;
+  }
+}
+
+TEST(PathCounterTest, RoutesEndAtTheFirstBoss) {
+  RunGraph graph;
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  auto* boss = graph.AddRoom("boss", Room::Type::Boss);
+  auto* after = graph.AddRoom("after", Room::Type::Combat);
+  auto* finalBoss = graph.AddRoom("final", Room::Type::Boss);
+  auto* deadEnd = graph.AddRoom("dead_end", Room::Type::Treasure);
+  graph.SetStartNode(start);
+  graph.Connect(start, boss);
+  graph.Connect(boss, after);
+  graph.Connect(after, finalBoss);
+  graph.Connect(start, deadEnd);
+
+  PathCounter counter(graph);
+  EXPECT_EQ(counter.GetPathCount(), Wide(1));
+
+  std::vector<RunGraph::NodeIndex> path;
+  CounterRng rng(1, 0);
+  ASSERT_TRUE(counter.Sample(rng, path));
+  EXPECT_EQ(path, (std::vector<RunGraph::NodeIndex>{0, 1}));
+}
+
+TEST(PathCounterTest, NoBossMeansNoRoutes) {
+  RunGraph graph;
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  graph.Connect(start, graph.AddRoom("next", Room::Type::Combat));
+  graph.SetStartNode(start);
+
+  PathCounter counter(graph);
+  EXPECT_TRUE(counter.GetPathCount().IsZero());
+  std::vector<RunGraph::NodeIndex> path;
+  CounterRng rng(1, 0);
+  EXPECT_FALSE(counter.Sample(rng, path));
+  EXPECT_TRUE(path.empty());
+}
+
+TEST(PathCounterTest, SamplesUniformly) {
+  // Three routes of different shapes: start-a-c-boss, start-a-d-boss, start-b-boss
+  RunGraph graph;
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  auto* a = graph.AddRoom("a", Room::Type::Combat);
+  auto* b = graph.AddRoom("b", Room::Type::Combat);
+  auto* c = graph.AddRoom("c", Room::Type::Combat);
+  auto* d = graph.AddRoom("d", Room::Type::Combat);
+  auto* boss = graph.AddRoom("boss", Room::Type::Boss);
+  graph.SetStartNode(start);
+  graph.Connect(start, a);
+  graph.Connect(start, b);
+  graph.Connect(a, c);
+  graph.Connect(a, d);
+  graph.Connect(c, boss);
+  graph.Connect(d, boss);
+  graph.Connect(b, boss);
+
+  PathCounter counter(graph);
+  ASSERT_EQ(counter.GetPathCount(), Wide(3));
+
+  std::vector<RunGraph::NodeIndex> nodes;
+  std::vector<uint32_t> offsets;
+  constexpr size_t SAMPLES = 30'000;
+  counter.SampleBatch(7, SAMPLES, nodes, offsets);
+  ASSERT_EQ(offsets.size(), SAMPLES + 1);
+
+  std::map<std::vector<RunGraph::NodeIndex>, size_t> routes;
+  for (size_t i = 0; i < SAMPLES; ++i) {
+    routes[std::vector<RunGraph::NodeIndex>(nodes.begin() + offsets[i],
+                                            nodes.begin() + offsets[i + 1])]++;
+  }
+  ASSERT_EQ(routes.size(), 3u);
+  for (const auto& [route, hits] : routes) {
+    EXPECT_EQ(route.front(), 0u);
+    EXPECT_EQ(route.back(), 5u);
+    EXPECT_NEAR(static_cast<double>(hits) / SAMPLES, 1.0 / 3.0, 0.015);
+  }
+}
+
+TEST(PathCounterTest, BatchRoutesAreReproducibleAlone) {
+  RunGraph graph = BuildDiamonds(10);
+  PathCounter counter(graph);
+
+  std::vector<RunGraph::NodeIndex> nodes;
+  std::vector<uint32_t> offsets;
+  counter.SampleBatch(99, 50, nodes, offsets);
+
+  std::vector<RunGraph::NodeIndex> route;
+  CounterRng rng(99, 42);
+  ASSERT_TRUE(counter.Sample(rng, route));
+  EXPECT_EQ(route, std::vector<RunGraph::NodeIndex>(nodes.begin() + offsets[42],
+                                                    nodes.begin() + offsets[43]));
+}
+
+TEST(PathCounterTest, CountsBeyond64Bits) {
+  RunGraph graph = BuildDiamonds(100);
+  PathCounter counter(graph);
+  EXPECT_EQ(counter.GetPathCount(), PowerOfTwo(100));
+  EXPECT_EQ(counter.GetPathCount().ToString(), "1267650600228229401496703205376");
+
+  // Wide sampling still takes each side of a diamond about half the time
+  std::vector<RunGraph::NodeIndex> nodes;
+  std::vector<uint32_t> offsets;
+  counter.SampleBatch(3, 2000, nodes, offsets);
+  size_t leftTurns = 0;
+  for (size_t i = 0; i < 2000; ++i) {
+    ASSERT_EQ(offsets[i + 1] - offsets[i], 202u);  // start, 100 x (side, merge), boss
+    leftTurns += nodes[offsets[i] + 1] == 1;       // First diamond's left room
+  }
+  EXPECT_NEAR(static_cast<double>(leftTurns) / 2000, 0.5, 0.05);
+}
+
+TEST(PathCounterTest, ReportsCountsTooLargeToRepresent) {
+  RunGraph graph = BuildDiamonds(256);
+  EXPECT_THROW(PathCounter counter(graph), std::overflow_error);
+}
+
+TEST(PathCounterTest, RequiresStartNode) {
+  RunGraph graph;
+  graph.AddRoom("boss", Room::Type::Boss);
+  EXPECT_THROW(PathCounter counter(graph), std::logic_error);
+}
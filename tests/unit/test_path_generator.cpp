@@ -1,5 +1,9 @@
 #include <gtest/gtest.h>
 
+#include <algorithm>
+#include <stdexcept>
+#include <vector>
+
 #include "../test_utils.h"
 #include "core/GraphValidator.h"
 #include "generation/PathGenerator.h"
@@ -69,6 +73,39 @@ TEST(PathGeneratorTest, GeneratesLinearPath) {
   EXPECT_NE(graph.GetStartNode(), nullptr);
 }
 
+TEST(PathGeneratorTest, GeneratesSequentialRoomIds) {
+  TestUtils::SeededRandom rng(42);
+  PathGenerator generator(rng.GetEngine());
+
+  PathGenerator::Config config;
+  config.minRooms = 12;
+  config.maxRooms = 12;
+  generator.SetConfig(config);
+
+  auto graph = generator.GeneratePath();
+
+  EXPECT_EQ(graph.GetNode(0)->GetRoom()->GetId(), "room_1");
+  EXPECT_EQ(graph.GetNode(9)->GetRoom()->GetId(), "room_10");
+  EXPECT_EQ(graph.GetNode(11)->GetRoom()->GetId(), "room_12");
+}
+
+TEST(PathGeneratorTest, GeneratedGraphIsFinalized) {
+  TestUtils::SeededRandom rng(42);
+  PathGenerator generator(rng.GetEngine());
+
+  PathGenerator::Config config;
+  config.minRooms = 10;
+  config.maxRooms = 10;
+  config.branchProbability = 0.0f;
+  generator.SetConfig(config);
+
+  auto graph = generator.GeneratePath();
+
+  EXPECT_TRUE(graph.IsFinalized());
+  EXPECT_EQ(graph.GetEdgeCount(), 9);
+  EXPECT_EQ(graph.GetStartNode(), graph.GetNode(0));
+}
+
 TEST(PathGeneratorTest, LinearPathEndsWithBoss) {
   TestUtils::SeededRandom rng(42);
   PathGenerator generator(rng.GetEngine());
@@ -77,6 +114,8 @@ TEST(PathGeneratorTest, LinearPathEndsWithBoss) {
   config.minRooms = 5;
   config.maxRooms = 5;
   config.branchProbability = 0.0f;
+  config.guaranteedShops = 0;  // Five rooms cannot hold the default guarantees
+  config.guaranteedFountains = 0;
 
   generator.SetConfig(config);
 
@@ -124,6 +163,8 @@ TEST(PathGeneratorTest, PathDepthsAreCorrect) {
   config.minRooms = 5;
   config.maxRooms = 5;
   config.branchProbability = 0.0f;
+  config.guaranteedShops = 0;  // Five rooms cannot hold the default guarantees
+  config.guaranteedFountains = 0;
 
   generator.SetConfig(config);
 
@@ -228,4 +269,758 @@ TEST(PathGeneratorTest, RespectsRoomCountRange) {
     EXPECT_GE(roomCount, config.minRooms);
     EXPECT_LE(roomCount, config.maxRooms);
   }
-}
\ No newline at end of file
+}
+/**
+ * Test Suite: Branching Generation
+ * Testing side branches that merge back into the critical path
+ */
+
+TEST(PathGeneratorBranchTest, PathAnalysisReproducesGeneratorMetadata) {
+  PathGenerator::Config config;
+  config.branchProbability = 0.5f;
+  PathGenerator generator(uint64_t{17});
+  generator.SetConfig(config);
+  RunGraph graph = generator.GeneratePath();
+
+  std::vector<int> depths;
+  std::vector<bool> critical;
+  for (RunGraph::NodeIndex i = 0; i < graph.GetNodeCount(); ++i) {
+    depths.push_back(graph.GetNode(i)->GetDepth());
+    critical.push_back(graph.GetNode(i)->IsOnCriticalPath());
+  }
+
+  graph.AssignDepths(RunGraph::DepthMetric::Longest);
+  graph.MarkCriticalPath();
+  for (RunGraph::NodeIndex i = 0; i < graph.GetNodeCount(); ++i) {
+    EXPECT_EQ(graph.GetNode(i)->GetDepth(), depths[i]) << "node " << i;
+    EXPECT_EQ(graph.GetNode(i)->IsOnCriticalPath(), critical[i]) << "node " << i;
+  }
+  // Branches rejoin after as many rooms as they bypass, so no shortcut exists
+  const auto shortest = graph.GetDistances(RunGraph::DepthMetric::Shortest);
+  EXPECT_EQ(std::vector<int>(shortest.begin(), shortest.end()), depths);
+}
+
+TEST(PathGeneratorBranchTest, BranchedRunsAreValid) {
+  PathGenerator::Config config;
+  config.branchProbability = 0.5f;
+  config.maxBranchLength = 3;
+  GraphValidator validator;
+
+  for (uint64_t seed = 0; seed < 50; ++seed) {
+    PathGenerator generator(seed);
+    generator.SetConfig(config);
+    auto graph = generator.GeneratePath();
+
+    auto result = validator.Validate(graph);
+    EXPECT_TRUE(result.isValid) << "seed " << seed;
+  }
+}
+
+TEST(PathGeneratorBranchTest, CriticalPathComesFirstAndIsFlagged) {
+  TestUtils::SeededRandom rng(42);
+  PathGenerator generator(rng.GetEngine());
+  PathGenerator::Config config;
+  config.minRooms = 30;
+  config.maxRooms = 30;
+  config.branchProbability = 1.0f;
+  generator.SetConfig(config);
+
+  auto graph = generator.GeneratePath();
+  ASSERT_GT(graph.GetNodeCount(), 30u);
+
+  for (RunGraph::NodeIndex i = 0; i < graph.GetNodeCount(); ++i) {
+    const auto* node = graph.GetNode(i);
+    EXPECT_EQ(node->IsOnCriticalPath(), i < 30) << "node " << i;
+    if (i < 30) {
+      EXPECT_EQ(node->GetDepth(), static_cast<int>(i));
+    }
+    // Every edge goes one step deeper, so branches rejoin at the right depth
+    for (const auto* next : node->GetNextRooms()) {
+      EXPECT_EQ(next->GetDepth(), node->GetDepth() + 1);
+    }
+  }
+  EXPECT_EQ(graph.GetNode(29)->GetRoom()->GetType(), Room::Type::Boss);
+}
+
+TEST(PathGeneratorBranchTest, EdgeCountMatchesBranches) {
+  PathGenerator::Config config;
+  config.minRooms = 40;
+  config.maxRooms = 40;
+  config.branchProbability = 0.3f;
+  PathGenerator generator(uint64_t{99});
+  generator.SetConfig(config);
+
+  auto graph = generator.GeneratePath();
+
+  // Chain edges, plus one edge per branch room, plus one entry edge per branch
+  size_t branchEntries = 0;
+  for (RunGraph::NodeIndex i = 0; i < 40; ++i) {
+    branchEntries += graph.GetNode(i)->GetNextRooms().size() - (i < 39 ? 1 : 0);
+  }
+  const size_t branchRooms = graph.GetNodeCount() - 40;
+  EXPECT_GT(branchEntries, 0u);
+  EXPECT_EQ(graph.GetEdgeCount(), 39 + branchRooms + branchEntries);
+}
+
+TEST(PathGeneratorBranchTest, BranchesDoNotChangeCriticalRooms) {
+  PathGenerator::Config linear;
+  linear.minRooms = linear.maxRooms = 25;
+  linear.branchProbability = 0.0f;
+  PathGenerator::Config branched = linear;
+  branched.branchProbability = 0.6f;
+
+  PathGenerator linearGen(uint64_t{3});
+  linearGen.SetConfig(linear);
+  PathGenerator branchedGen(uint64_t{3});
+  branchedGen.SetConfig(branched);
+  auto linearGraph = linearGen.GeneratePath();
+  auto branchedGraph = branchedGen.GeneratePath();
+
+  ASSERT_EQ(linearGraph.GetNodeCount(), 25u);
+  ASSERT_GT(branchedGraph.GetNodeCount(), 25u);
+  for (RunGraph::NodeIndex i = 0; i < 25; ++i) {
+    EXPECT_EQ(linearGraph.GetNode(i)->GetRoom()->GetType(),
+              branchedGraph.GetNode(i)->GetRoom()->GetType());
+  }
+}
+
+/**
+ * Test Suite: Placement Constraints
+ * Testing guaranteed rooms and depth rules on the critical path
+ */
+
+namespace {
+int CountType(std::span<const Room::Type> types, Room::Type type) {
+  return static_cast<int>(std::count(types.begin(), types.end(), type));
+}
+
+bool HasAdjacent(std::span<const Room::Type> types, Room::Type type) {
+  for (size_t i = 1; i < types.size(); ++i) {
+    if (types[i] == type && types[i - 1] == type) return true;
+  }
+  return false;
+}
+}  // namespace
+
+TEST(PlacementSolverTest, AddsMissingGuaranteedRooms) {
+  const PlacementConstraint constraints[] = {
+      {.type = Room::Type::Shop, .minCount = 2, .minSpacing = 2},
+      {.type = Room::Type::Fountain, .minCount = 3},
+  };
+  PlacementSolver solver(constraints);
+
+  std::vector<Room::Type> types(30, Room::Type::Combat);
+  std::vector<uint8_t> locked(30, 0);
+  locked.front() = locked.back() = 1;
+  types.back() = Room::Type::Boss;
+
+  auto result = solver.Solve(types, locked);
+  ASSERT_TRUE(result.IsSatisfied());
+  EXPECT_EQ(CountType(types, Room::Type::Shop), 2);
+  EXPECT_EQ(CountType(types, Room::Type::Fountain), 3);
+  EXPECT_EQ(types.front(), Room::Type::Combat);
+  EXPECT_EQ(types.back(), Room::Type::Boss);
+
+  // Guaranteed rooms are spread out rather than packed before the boss
+  const auto firstShop = std::find(types.begin(), types.end(), Room::Type::Shop);
+  EXPECT_LT(firstShop - types.begin(), 15);
+}
+
+TEST(PlacementSolverTest, EnforcesSpacingAndMaximum) {
+  const PlacementConstraint constraints[] = {
+      {.type = Room::Type::Shop, .maxCount = 3, .minSpacing = 2},
+  };
+  PlacementSolver solver(constraints);
+
+  std::vector<Room::Type> types(12, Room::Type::Shop);
+  std::vector<uint8_t> locked(12, 0);
+  auto result = solver.Solve(types, locked);
+
+  ASSERT_TRUE(result.IsSatisfied());
+  EXPECT_LE(CountType(types, Room::Type::Shop), 3);
+  EXPECT_FALSE(HasAdjacent(types, Room::Type::Shop));
+}
+
+TEST(PlacementSolverTest, RespectsDepthWindow) {
+  const PlacementConstraint constraints[] = {
+      {.type = Room::Type::Fountain, .minCount = 2, .minDepth = 10, .maxDepth = 15},
+  };
+  PlacementSolver solver(constraints);
+
+  std::vector<Room::Type> types(20, Room::Type::Fountain);
+  std::vector<uint8_t> locked(20, 0);
+  ASSERT_TRUE(solver.Solve(types, locked).IsSatisfied());
+
+  for (size_t depth = 0; depth < types.size(); ++depth) {
+    if (types[depth] == Room::Type::Fountain) {
+      EXPECT_GE(depth, 10u);
+      EXPECT_LE(depth, 15u);
+    }
+  }
+  EXPECT_GE(CountType(types, Room::Type::Fountain), 2);
+}
+
+TEST(PlacementSolverTest, ReportsUnsatisfiableConstraints) {
+  const PlacementConstraint constraints[] = {
+      {.type = Room::Type::Shop, .minCount = 4, .minSpacing = 2},
+  };
+  PlacementSolver solver(constraints);
+
+  std::vector<Room::Type> types(6, Room::Type::Combat);
+  const std::vector<Room::Type> original = types;
+  std::vector<uint8_t> locked(6, 0);
+  auto result = solver.Solve(types, locked);
+
+  EXPECT_EQ(result.status, PlacementSolver::Status::Unsatisfiable);
+  EXPECT_EQ(result.conflictingType, Room::Type::Shop);
+  EXPECT_EQ(types, original);
+}
+
+TEST(PlacementSolverTest, ReportsCompetingTypesAfterSearch) {
+  // Each type fits alone, but not both in four rooms
+  const PlacementConstraint constraints[] = {
+      {.type = Room::Type::Shop, .minCount = 2},
+      {.type = Room::Type::Fountain, .minCount = 3},
+  };
+  PlacementSolver solver(constraints);
+
+  std::vector<Room::Type> types(4, Room::Type::Combat);
+  std::vector<uint8_t> locked(4, 0);
+  auto result = solver.Solve(types, locked);
+
+  EXPECT_EQ(result.status, PlacementSolver::Status::Unsatisfiable);
+  EXPECT_GT(result.backtracks, 0u);
+
+  PlacementSolver bounded(constraints, 1);
+  EXPECT_EQ(bounded.Solve(types, locked).status, PlacementSolver::Status::BudgetExhausted);
+}
+
+TEST(PlacementSolverTest, LongRunsNeedNoBacktracking) {
+  const PlacementConstraint constraints[] = {
+      {.type = Room::Type::Shop, .minCount = 50, .minSpacing = 2},
+      {.type = Room::Type::Fountain, .minCount = 50},
+  };
+  PlacementSolver solver(constraints, 0);
+
+  std::vector<Room::Type> types(100'000, Room::Type::Combat);
+  std::vector<uint8_t> locked(types.size(), 0);
+  auto result = solver.Solve(types, locked);
+
+  ASSERT_TRUE(result.IsSatisfied());
+  EXPECT_EQ(result.backtracks, 0u);
+  EXPECT_EQ(CountType(types, Room::Type::Shop), 50);
+}
+
+TEST(PlacementSolverTest, RejectsContradictoryConstraints) {
+  const PlacementConstraint counts[] = {{.type = Room::Type::Shop, .minCount = 3, .maxCount = 2}};
+  EXPECT_THROW(PlacementSolver{counts}, std::invalid_argument);
+
+  const PlacementConstraint merged[] = {{.type = Room::Type::Shop, .minCount = 3},
+                                        {.type = Room::Type::Shop, .maxCount = 1}};
+  EXPECT_THROW(PlacementSolver{merged}, std::invalid_argument);
+
+  const PlacementConstraint spacing[] = {{.type = Room::Type::Shop, .minSpacing = 0}};
+  EXPECT_THROW(PlacementSolver{spacing}, std::invalid_argument);
+}
+
+TEST(PlacementSolverTest, GeneratedRunsMeetGuarantees) {
+  PathGenerator::Config config;
+  config.guaranteedShops = 3;
+  config.guaranteedFountains = 2;
+
+  for (uint64_t seed = 0; seed < 100; ++seed) {
+    PathGenerator generator(seed);
+    generator.SetConfig(config);
+    auto graph = generator.GeneratePath();
+
+    std::vector<Room::Type> critical;
+    for (RunGraph::NodeIndex i = 0; i < graph.GetNodeCount(); ++i) {
+      if (graph.GetNode(i)->IsOnCriticalPath()) {
+        critical.push_back(graph.GetNode(i)->GetRoom()->GetType());
+      }
+    }
+    EXPECT_GE(CountType(critical, Room::Type::Shop), 3) << "seed " << seed;
+    EXPECT_GE(CountType(critical, Room::Type::Fountain), 2) << "seed " << seed;
+    EXPECT_FALSE(HasAdjacent(critical, Room::Type::Shop)) << "seed " << seed;
+    EXPECT_EQ(critical.back(), Room::Type::Boss);
+  }
+}
+
+TEST(PlacementSolverTest, GeneratorRejectsImpossibleGuarantees) {
+  // Three free depths cannot hold two spaced shops and three fountains
+  PathGenerator::Config config;
+  config.minRooms = 5;
+  config.maxRooms = 50;
+  PathGenerator generator(uint64_t{1});
+  EXPECT_THROW(generator.SetConfig(config), std::invalid_argument);
+  EXPECT_EQ(generator.GetConfig().minRooms, PathGenerator::Config{}.minRooms);
+
+  // Long enough for every guarantee once the shortest run is
+  config.minRooms = 8;
+  generator.SetConfig(config);
+  for (uint64_t seed = 0; seed < 50; ++seed) {
+    generator.SetSeed(seed);
+    EXPECT_NO_THROW(generator.GeneratePath()) << "seed " << seed;
+  }
+}
+
+/**
+ * Test Suite: Batch Generation
+ * Testing parallel generation stays deterministic per seed
+ */
+
+namespace {
+void ExpectSameGraph(const RunGraph& a, const RunGraph& b) {
+  ASSERT_EQ(a.GetNodeCount(), b.GetNodeCount());
+  ASSERT_EQ(a.GetEdgeCount(), b.GetEdgeCount());
+  for (RunGraph::NodeIndex i = 0; i < a.GetNodeCount(); ++i) {
+    const auto* nodeA = a.GetNode(i);
+    const auto* nodeB = b.GetNode(i);
+    EXPECT_EQ(nodeA->GetRoom()->GetId(), nodeB->GetRoom()->GetId());
+    EXPECT_EQ(nodeA->GetRoom()->GetType(), nodeB->GetRoom()->GetType());
+    EXPECT_EQ(nodeA->GetDepth(), nodeB->GetDepth());
+    ASSERT_EQ(nodeA->GetNextRooms().size(), nodeB->GetNextRooms().size());
+    for (size_t e = 0; e < nodeA->GetNextRooms().size(); ++e) {
+      EXPECT_EQ(nodeA->GetNextRooms()[e]->GetIndex(), nodeB->GetNextRooms()[e]->GetIndex());
+    }
+  }
+}
+}  // namespace
+
+TEST(PathGeneratorBatchTest, MatchesSequentialGeneration) {
+  std::vector<uint64_t> seeds = {1, 42, 123, 9001, 77, uint64_t{1} << 40};
+  PathGenerator::Config config;
+  config.branchProbability = 0.5f;
+
+  auto batch = PathGenerator::GenerateBatch(seeds, config, 2);
+
+  ASSERT_EQ(batch.size(), seeds.size());
+  for (size_t i = 0; i < seeds.size(); ++i) {
+    PathGenerator generator(seeds[i]);
+    generator.SetConfig(config);
+    auto expected = generator.GeneratePath();
+
+    ExpectSameGraph(batch[i], expected);
+  }
+}
+
+TEST(PathGeneratorBatchTest, IdenticalAcrossThreadCounts) {
+  std::vector<uint64_t> seeds(64);
+  for (size_t i = 0; i < seeds.size(); ++i) {
+    seeds[i] = i * 7919 + 3;
+  }
+  PathGenerator::Config config;
+
+  auto single = PathGenerator::GenerateBatch(seeds, config, 1);
+  auto multi = PathGenerator::GenerateBatch(seeds, config, 4);
+
+  ASSERT_EQ(single.size(), multi.size());
+  for (size_t i = 0; i < single.size(); ++i) {
+    ExpectSameGraph(single[i], multi[i]);
+  }
+}
+
+TEST(PathGeneratorBatchTest, EmptySeedListGivesNoRuns) {
+  auto batch = PathGenerator::GenerateBatch({}, PathGenerator::Config{}, 4);
+  EXPECT_TRUE(batch.empty());
+}
+
+TEST(PathGeneratorBatchTest, RejectsInvalidConfigOnTheCallingThread) {
+  PathGenerator::Config config;
+  config.minRooms = 0;
+  const std::vector<uint64_t> seeds = {1, 2};
+  EXPECT_THROW(PathGenerator::GenerateBatch(seeds, config, 2), std::invalid_argument);
+}
+
+/**
+ * Test Suite: Counter-Based Generation
+ * Testing seed-keyed generation without a shared engine
+ */
+
+TEST(PathGeneratorCounterTest, SameSeedProducesSameGraph) {
+  PathGenerator gen1(uint64_t{42});
+  PathGenerator gen2(uint64_t{42});
+  auto graph1 = gen1.GeneratePath();
+  auto graph2 = gen2.GeneratePath();
+
+  ASSERT_EQ(graph1.GetNodeCount(), graph2.GetNodeCount());
+  for (RunGraph::NodeIndex i = 0; i < graph1.GetNodeCount(); ++i) {
+    EXPECT_EQ(graph1.GetNode(i)->GetRoom()->GetType(), graph2.GetNode(i)->GetRoom()->GetType());
+  }
+}
+
+TEST(PathGeneratorCounterTest, RoomChoicesDoNotDependOnEarlierRooms) {
+  // Room types are keyed by room index, so a longer run shares the
+  // randomly chosen prefix of a shorter one
+  PathGenerator::Config shortConfig;
+  shortConfig.minRooms = shortConfig.maxRooms = 20;
+  shortConfig.miniBossInterval = 0;
+  shortConfig.guaranteedShops = 0;  // Guarantees are placed relative to run length
+  shortConfig.guaranteedFountains = 0;
+  PathGenerator::Config longConfig = shortConfig;
+  longConfig.minRooms = longConfig.maxRooms = 40;
+
+  PathGenerator shortGen(uint64_t{7});
+  shortGen.SetConfig(shortConfig);
+  PathGenerator longGen(uint64_t{7});
+  longGen.SetConfig(longConfig);
+  auto shortGraph = shortGen.GeneratePath();
+  auto longGraph = longGen.GeneratePath();
+
+  for (RunGraph::NodeIndex i = 0; i + 1 < 20; ++i) {
+    EXPECT_EQ(shortGraph.GetNode(i)->GetRoom()->GetType(),
+              longGraph.GetNode(i)->GetRoom()->GetType())
+        << "Room types differ at index " << i;
+  }
+}
+
+TEST(PathGeneratorCounterTest, SetSeedMatchesFreshGenerator) {
+  PathGenerator reused(uint64_t{1});
+  reused.GeneratePath();
+  reused.SetSeed(99);
+  auto graph1 = reused.GeneratePath();
+
+  PathGenerator fresh(uint64_t{99});
+  auto graph2 = fresh.GeneratePath();
+
+  ASSERT_EQ(graph1.GetNodeCount(), graph2.GetNodeCount());
+  for (RunGraph::NodeIndex i = 0; i < graph1.GetNodeCount(); ++i) {
+    EXPECT_EQ(graph1.GetNode(i)->GetRoom()->GetType(), graph2.GetNode(i)->GetRoom()->GetType());
+  }
+}
+
+TEST(PathGeneratorCounterTest, SetSeedRequiresCounterMode) {
+  std::mt19937 rng(1);
+  PathGenerator generator(rng);
+  EXPECT_THROW(generator.SetSeed(5), std::logic_error);
+}
+
+TEST(PathGeneratorCounterTest, OutputIsPinnedAcrossToolchains) {
+  PathGenerator::Config config;
+  config.minRooms = 5;
+  config.maxRooms = 60;
+  config.guaranteedFountains = 1;  // All a five-room run has space for
+  PathGenerator generator(uint64_t{2024});
+  generator.SetConfig(config);
+  auto graph = generator.GeneratePath();
+
+  std::string types;
+  for (RunGraph::NodeIndex i = 0; i < graph.GetNodeCount(); ++i) {
+    types += Room::TypeToString(graph.GetNode(i)->GetRoom()->GetType())[0];
+  }
+  EXPECT_EQ(types, "CSECCCCECEMCCECECCCFMCTECCSCCCMCSCTECBCCSCCTCCECFSF");
+}
+
+/**
+ * Test Suite: Streaming Generation
+ * Testing that streamed runs arrive in depth order and equal GeneratePath
+ */
+
+namespace {
+PathGenerator::Config BranchyConfig() {
+  PathGenerator::Config config;
+  config.branchProbability = 0.6f;
+  config.maxBranchLength = 3;
+  return config;
+}
+
+// Drains the stream, checking each event against the finished graph
+RunGraph DrainAndCheck(RunStream& stream) {
+  std::vector<RunEvent> events;
+  for (const RunEvent& event : stream) events.push_back(event);
+  RunGraph graph = stream.TakeGraph();
+
+  std::vector<bool> seen(graph.GetNodeCount(), false);
+  size_t edges = 0;
+  int depth = 0;
+  for (const RunEvent& event : events) {
+    if (event.kind == RunEvent::Kind::Edge) {
+      EXPECT_TRUE(seen[event.index] && seen[event.target]) << "edge before its rooms";
+      const auto& next = graph.GetNode(event.index)->GetNextRooms();
+      EXPECT_NE(std::find(next.begin(), next.end(), graph.GetNode(event.target)), next.end());
+      ++edges;
+      continue;
+    }
+    EXPECT_GE(event.depth, depth) << "rooms out of depth order";
+    depth = event.depth;
+    EXPECT_FALSE(seen[event.index]);
+    seen[event.index] = true;
+    const RunGraph::Node* node = graph.GetNode(event.index);
+    EXPECT_EQ(event.type, node->GetRoom()->GetType());
+    EXPECT_EQ(event.depth, node->GetDepth());
+    EXPECT_EQ(event.onCriticalPath, node->IsOnCriticalPath());
+  }
+  EXPECT_EQ(std::count(seen.begin(), seen.end(), true), static_cast<long>(seen.size()));
+  EXPECT_EQ(edges, graph.GetEdgeCount());
+  return graph;
+}
+}  // namespace
+
+TEST(PathGeneratorStreamTest, MatchesGeneratePathWithCounterRng) {
+  for (uint64_t seed = 0; seed < 20; ++seed) {
+    PathGenerator streamed(seed);
+    PathGenerator direct(seed);
+    streamed.SetConfig(BranchyConfig());
+    direct.SetConfig(BranchyConfig());
+
+    RunStream stream = streamed.GenerateStream();
+    const RunGraph graph = DrainAndCheck(stream);
+    ExpectSameGraph(graph, direct.GeneratePath());
+    EXPECT_TRUE(graph.IsFinalized());
+  }
+}
+
+TEST(PathGeneratorStreamTest, MatchesGeneratePathWithEngine) {
+  TestUtils::SeededRandom streamedRng(77);
+  TestUtils::SeededRandom directRng(77);
+  PathGenerator streamed(streamedRng.GetEngine());
+  PathGenerator direct(directRng.GetEngine());
+  streamed.SetConfig(BranchyConfig());
+  direct.SetConfig(BranchyConfig());
+
+  // Consecutive runs share the engine, so draws must line up exactly
+  for (int run = 0; run < 10; ++run) {
+    RunStream stream = streamed.GenerateStream();
+    ExpectSameGraph(DrainAndCheck(stream), direct.GeneratePath());
+  }
+}
+
+TEST(PathGeneratorStreamTest, StartRoomComesFirst) {
+  PathGenerator generator(uint64_t{3});
+  RunStream stream = generator.GenerateStream();
+  ASSERT_TRUE(stream.Next());
+  EXPECT_EQ(stream.Get().kind, RunEvent::Kind::Room);
+  EXPECT_EQ(stream.Get().index, 0u);
+  EXPECT_EQ(stream.Get().type, Room::Type::Combat);
+  EXPECT_THROW(stream.TakeGraph(), std::logic_error);
+
+  while (stream.Next()) {
+  }
+  EXPECT_EQ(stream.TakeGraph().GetStartNode()->GetIndex(), 0u);
+  EXPECT_THROW(stream.TakeGraph(), std::logic_error);  // Already taken
+}
+
+TEST(PathGeneratorStreamTest, SingleRoomRunMatchesGeneratePath) {
+  PathGenerator::Config config;
+  config.minRooms = 1;
+  config.maxRooms = 1;
+  config.guaranteedShops = 0;
+  config.guaranteedFountains = 0;
+  PathGenerator streamed(uint64_t{4});
+  PathGenerator direct(uint64_t{4});
+  streamed.SetConfig(config);
+  direct.SetConfig(config);
+
+  RunStream stream = streamed.GenerateStream();
+  const RunGraph graph = DrainAndCheck(stream);
+  EXPECT_EQ(graph.GetNodeCount(), 1u);
+  ExpectSameGraph(graph, direct.GeneratePath());
+
+  // Empty runs, which the stream could not match, are rejected up front
+  config.minRooms = 0;
+  config.maxRooms = 0;
+  EXPECT_THROW(streamed.SetConfig(config), std::invalid_argument);
+  config.minRooms = 3;
+  config.maxRooms = 2;
+  EXPECT_THROW(streamed.SetConfig(config), std::invalid_argument);
+  EXPECT_EQ(streamed.GetConfig().maxRooms, 1);
+}
+
+/**
+ * Test Suite: Room Type Sampler
+ * Testing the alias table against its configured weights
+ */
+
+TEST(RoomTypeSamplerTest, DefaultWeightsGiveExactSplit) {
+  RoomTypeSampler sampler(PathGenerator::DEFAULT_ROOM_TYPE_WEIGHTS);
+
+  EXPECT_NEAR(sampler.GetProbability(Room::Type::Combat), 0.60, 1e-9);
+  EXPECT_NEAR(sampler.GetProbability(Room::Type::Elite), 0.15, 1e-9);
+  EXPECT_NEAR(sampler.GetProbability(Room::Type::Treasure), 0.10, 1e-9);
+  EXPECT_NEAR(sampler.GetProbability(Room::Type::Shop), 0.07, 1e-9);
+  EXPECT_NEAR(sampler.GetProbability(Room::Type::Fountain), 0.08, 1e-9);
+  EXPECT_EQ(sampler.GetProbability(Room::Type::Boss), 0.0);
+}
+
+TEST(RoomTypeSamplerTest, EmpiricalFrequenciesMatchWeights) {
+  RoomTypeSampler::Weights weights{};
+  weights[static_cast<size_t>(Room::Type::Combat)] = 1.0f;
+  weights[static_cast<size_t>(Room::Type::Shop)] = 2.0f;
+  weights[static_cast<size_t>(Room::Type::Story)] = 5.0f;
+  RoomTypeSampler sampler(weights);
+
+  constexpr int SAMPLES = 80000;
+  std::array<int, Room::TYPE_COUNT> counts{};
+  CounterRng rng(3, 0);
+  for (int i = 0; i < SAMPLES; ++i) {
+    ++counts[static_cast<size_t>(sampler.Sample(rng))];
+  }
+
+  EXPECT_NEAR(counts[static_cast<size_t>(Room::Type::Combat)] / double(SAMPLES), 1.0 / 8, 0.01);
+  EXPECT_NEAR(counts[static_cast<size_t>(Room::Type::Shop)] / double(SAMPLES), 2.0 / 8, 0.01);
+  EXPECT_NEAR(counts[static_cast<size_t>(Room::Type::Story)] / double(SAMPLES), 5.0 / 8, 0.01);
+  EXPECT_EQ(counts[static_cast<size_t>(Room::Type::Elite)], 0);
+  EXPECT_EQ(counts[static_cast<size_t>(Room::Type::Boss)], 0);
+}
+
+TEST(RoomTypeSamplerTest, BulkMatchesSingleSamples) {
+  RoomTypeSampler sampler(PathGenerator::DEFAULT_ROOM_TYPE_WEIGHTS);
+  std::vector<uint32_t> words = {0u, 1u, 0x7fffffffu, 0x80000000u, 0xffffffffu};
+  CounterRng rng(9, 9);
+  for (int i = 0; i < 100; ++i) words.push_back(rng());
+
+  std::vector<Room::Type> types(words.size());
+  sampler.SampleBulk(words, types);
+  for (size_t i = 0; i < words.size(); ++i) {
+    EXPECT_EQ(types[i], sampler.Sample(words[i]));
+  }
+}
+
+TEST(RoomTypeSamplerTest, RejectsInvalidWeights) {
+  RoomTypeSampler::Weights zero{};
+  EXPECT_THROW(RoomTypeSampler{zero}, std::invalid_argument);
+
+  RoomTypeSampler::Weights negative = PathGenerator::DEFAULT_ROOM_TYPE_WEIGHTS;
+  negative[0] = -1.0f;
+  EXPECT_THROW(RoomTypeSampler{negative}, std::invalid_argument);
+
+  PathGenerator generator(uint64_t{1});
+  PathGenerator::Config config;
+  config.roomTypeWeights[static_cast<size_t>(Biome::Type::Asphodel)] = zero;
+  config.biome = Biome::Type::Asphodel;
+  EXPECT_THROW(generator.SetConfig(config), std::invalid_argument);
+}
+
+TEST(RoomTypeSamplerTest, GeneratorRejectsStructuralWeights) {
+  PathGenerator generator(uint64_t{1});
+  for (const Room::Type type : {Room::Type::MiniBoss, Room::Type::Boss}) {
+    PathGenerator::Config config;
+    // Unused biomes are checked too
+    config.roomTypeWeights[static_cast<size_t>(Biome::Type::Styx)][static_cast<size_t>(type)] = 1.0f;
+    EXPECT_THROW(generator.SetConfig(config), std::invalid_argument) << Room::TypeToString(type);
+  }
+  static_assert(!SamplesStructuralTypes(PathGenerator::DEFAULT_ROOM_TYPE_WEIGHTS));
+}
+
+TEST(RoomTypeSamplerTest, GeneratorUsesBiomeWeights) {
+  PathGenerator::Config config;
+  config.biome = Biome::Type::Elysium;
+  config.miniBossInterval = 0;
+  config.guaranteedShops = 0;
+  config.guaranteedFountains = 0;
+  RoomTypeSampler::Weights eliteOnly{};
+  eliteOnly[static_cast<size_t>(Room::Type::Elite)] = 1.0f;
+  config.roomTypeWeights[static_cast<size_t>(Biome::Type::Elysium)] = eliteOnly;
+
+  PathGenerator generator(uint64_t{5});
+  generator.SetConfig(config);
+  auto graph = generator.GeneratePath();
+
+  // Everything but the start and the boss (the only room without exits) is sampled
+  for (RunGraph::NodeIndex i = 1; i < graph.GetNodeCount(); ++i) {
+    const auto* node = graph.GetNode(i);
+    EXPECT_EQ(node->GetRoom()->GetBiome(), Biome::Type::Elysium);
+    if (!node->GetNextRooms().empty()) {
+      EXPECT_EQ(node->GetRoom()->GetType(), Room::Type::Elite);
+    }
+  }
+}
+
+/**
+ * Test Suite: Policy-Based Generation
+ * Testing that specialized instantiations generate PathGenerator's runs
+ */
+
+namespace {
+constexpr StaticGeneratorConfig ELYSIUM_CONFIG = [] {
+  StaticGeneratorConfig config;
+  config.minRooms = 25;
+  config.maxRooms = 35;
+  config.branchProbability = 0.6f;
+  config.maxBranchLength = 3;
+  config.miniBossInterval = 7;
+  config.guaranteedShops = 1;
+  config.biome = Biome::Type::Elysium;
+  config.roomTypeWeights = {50.0f, 30.0f, 0.0f, 5.0f, 5.0f, 5.0f, 5.0f, 0.0f};
+  return config;
+}();
+
+// The alias table is built at compile time
+constexpr RoomTypeSampler COMPILED_SAMPLER(PathGenerator::DEFAULT_ROOM_TYPE_WEIGHTS);
+static_assert(COMPILED_SAMPLER.Sample(0u) == Room::Type::Combat);
+}  // namespace
+
+TEST(PolicyGeneratorTest, StaticDefaultMatchesRuntime) {
+  StaticPathGenerator<StaticGeneratorConfig{}> specialized(uint64_t{0});
+  PathGenerator runtime(uint64_t{0});
+  for (uint64_t seed = 0; seed < 50; ++seed) {
+    specialized.SetSeed(seed);
+    runtime.SetSeed(seed);
+    ExpectSameGraph(specialized.GeneratePath(), runtime.GeneratePath());
+  }
+}
+
+TEST(PolicyGeneratorTest, StaticCustomConfigMatchesRuntime) {
+  StaticPathGenerator<ELYSIUM_CONFIG> specialized(uint64_t{0});
+  PathGenerator runtime(uint64_t{0});
+  runtime.SetConfig(ELYSIUM_CONFIG.ToConfig());
+  EXPECT_EQ(specialized.GetConfig().miniBossInterval, 7);
+
+  for (uint64_t seed = 0; seed < 50; ++seed) {
+    specialized.SetSeed(seed);
+    runtime.SetSeed(seed);
+    const RunGraph graph = specialized.GeneratePath();
+    ExpectSameGraph(graph, runtime.GeneratePath());
+    EXPECT_EQ(graph.GetNode(0)->GetRoom()->GetBiome(), Biome::Type::Elysium);
+  }
+
+  specialized.SetSeed(3);
+  runtime.SetSeed(3);
+  RunStream stream = specialized.GenerateStream();
+  ExpectSameGraph(DrainAndCheck(stream), runtime.GeneratePath());
+}
+
+TEST(PolicyGeneratorTest, StaticStatsMatchRuntime) {
+  if constexpr (!Stats::ENABLED) GTEST_SKIP() << "Stats are compiled out";
+  StaticPathGenerator<StaticGeneratorConfig{}> specialized(uint64_t{11});
+  PathGenerator runtime(uint64_t{11});
+  GenerationStats specializedStats;
+  GenerationStats runtimeStats;
+  specialized.SetStats(&specializedStats);
+  runtime.SetStats(&runtimeStats);
+
+  specialized.GeneratePath();
+  runtime.GeneratePath();
+  EXPECT_EQ(specializedStats.rngDraws, runtimeStats.rngDraws);
+  EXPECT_EQ(specializedStats.roomsCreated, runtimeStats.roomsCreated);
+}
+
+TEST(PolicyGeneratorTest, SequentialPolicyMatchesEngineMode) {
+  using EngineGenerator = BasicPathGenerator<GeneratorPolicy::SequentialRng, RoomTypeSampler,
+                                             GeneratorPolicy::RuntimeConfig>;
+  TestUtils::SeededRandom policyRng(21);
+  TestUtils::SeededRandom runtimeRng(21);
+  EngineGenerator specialized(policyRng.GetEngine());
+  PathGenerator runtime(runtimeRng.GetEngine());
+  specialized.SetConfig(BranchyConfig());
+  runtime.SetConfig(BranchyConfig());
+
+  for (int run = 0; run < 10; ++run) {
+    ExpectSameGraph(specialized.GeneratePath(), runtime.GeneratePath());
+  }
+}
+
+TEST(PolicyGeneratorTest, FixedSamplerMatchesAliasTable) {
+  const GeneratorPolicy::FixedSampler<ELYSIUM_CONFIG.roomTypeWeights> fixed;
+  const RoomTypeSampler runtime(ELYSIUM_CONFIG.roomTypeWeights);
+  CounterRng rng(4, 4);
+  std::vector<uint32_t> words = {0u, 0xffffffffu};
+  for (int i = 0; i < 1000; ++i) words.push_back(rng());
+
+  std::vector<Room::Type> bulk(words.size());
+  fixed.SampleBulk(words, bulk);
+  for (size_t i = 0; i < words.size(); ++i) {
+    EXPECT_EQ(fixed.Sample(words[i]), runtime.Sample(words[i]));
+    EXPECT_EQ(bulk[i], runtime.Sample(words[i]));
+  }
+}
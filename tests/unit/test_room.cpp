@@ -20,6 +20,11 @@ TEST(RoomTest, ThrowsOnEmptyId) {
   EXPECT_THROW(Room("", Room::Type::Combat), std::invalid_argument);
 }
 
+TEST(RoomTest, ThrowsOnOverlongId) {
+  std::string longId(RoomId::MAX_LENGTH + 1, 'x');
+  EXPECT_THROW(Room(longId, Room::Type::Combat), std::length_error);
+}
+
 TEST(RoomTest, TypeToStringWorks) {
   EXPECT_STREQ(Room::TypeToString(Room::Type::Combat), "Combat");
   EXPECT_STREQ(Room::TypeToString(Room::Type::Boss), "Boss");
@@ -66,6 +71,81 @@ TEST(RoomExitTest, CannotExceedMaxExits) {
   EXPECT_THROW(room.AddExit({30.0f, 0.0f}, Room::Direction::South), std::runtime_error);
 }
 
+TEST(RoomExitTest, DirectionMaskTracksExits) {
+  Room room("room_01", Room::Type::Combat);
+  EXPECT_EQ(room.GetExitMask(), 0);
+
+  room.AddExit({10.0f, 0.0f}, Room::Direction::North);
+  room.AddExit({0.0f, 10.0f}, Room::Direction::West);
+
+  EXPECT_EQ(room.GetExitMask(), Room::DirectionBit(Room::Direction::North) |
+                                    Room::DirectionBit(Room::Direction::West));
+  EXPECT_FALSE(room.HasExit(Room::Direction::South));
+  EXPECT_FALSE(room.HasExit(Room::Direction::East));
+}
+
+TEST(RoomExitTest, CanConnectThroughOppositeWalls) {
+  Room from("from", Room::Type::Combat);
+  Room to("to", Room::Type::Combat);
+  from.AddExit({10.0f, 0.0f}, Room::Direction::North);
+  to.AddExit({10.0f, 20.0f}, Room::Direction::South);
+
+  EXPECT_TRUE(from.CanConnectTo(to, Room::Direction::North));
+  EXPECT_FALSE(from.CanConnectTo(to, Room::Direction::East));
+  EXPECT_FALSE(to.CanConnectTo(from, Room::Direction::North));
+}
+
+TEST(RoomExitTest, ExitsAreCopiedWithRoom) {
+  Room room("room_01", Room::Type::Combat);
+  room.AddExit({10.0f, 0.0f}, Room::Direction::East);
+
+  Room copy = room;
+
+  ASSERT_EQ(copy.GetExitCount(), 1);
+  EXPECT_EQ(copy.GetExits()[0].direction, Room::Direction::East);
+  EXPECT_TRUE(copy.HasExit(Room::Direction::East));
+}
+
+/**
+ * Test Suite: RoomId
+ * Testing inline room identifiers
+ */
+
+TEST(RoomIdTest, StoresIdInline) {
+  std::string source = "tartarus_chamber_07";
+  RoomId id(source);
+  source.clear();
+
+  EXPECT_EQ(id.View(), "tartarus_chamber_07");
+  EXPECT_EQ(id.Size(), 19u);
+  EXPECT_FALSE(id.Empty());
+}
+
+TEST(RoomIdTest, AcceptsMaximumLength) {
+  std::string maxId(RoomId::MAX_LENGTH, 'a');
+  RoomId id(maxId);
+
+  EXPECT_EQ(id, maxId);
+}
+
+TEST(RoomIdTest, ComparesWithStringsAndIds) {
+  RoomId a("room_1");
+  RoomId b("room_2");
+
+  EXPECT_TRUE(a == "room_1");
+  EXPECT_TRUE(a == RoomId("room_1"));
+  EXPECT_FALSE(a == b);
+  EXPECT_TRUE(a < b);
+}
+
+TEST(RoomIdTest, RoomExposesIdAsStringView) {
+  Room room(RoomId("room_03"), Room::Type::Elite);
+
+  std::string_view id = room.GetId();
+  EXPECT_EQ(id, "room_03");
+  EXPECT_EQ(room.GetRoomId(), RoomId("room_03"));
+}
+
 /**
  * Test Suite: Room Metadata
  * Testing biome, difficultym and other room properties
@@ -130,7 +210,52 @@ TEST(RoomRewardTest, CanAddRewardWithMetadata) {
   auto rewards = room.GetRewards();
   ASSERT_EQ(rewards.size(), 1);
   EXPECT_EQ(rewards[0].type, Reward::Type::Boon);
-  EXPECT_EQ(rewards[0].godName, "Zeus");
+  EXPECT_EQ(rewards[0].god, Reward::God::Zeus);
+  EXPECT_EQ(rewards[0].GodName(), "Zeus");
+}
+
+TEST(RoomRewardTest, RejectsUnknownGodName) {
+  EXPECT_THROW(Reward::Data(Reward::Type::Boon, "Hades"), std::invalid_argument);
+}
+
+TEST(RoomRewardTest, RewardWithoutGodHasEmptyName) {
+  Reward::Data gold(Reward::Type::Gold, 50);
+
+  EXPECT_EQ(gold.god, Reward::God::None);
+  EXPECT_TRUE(gold.GodName().empty());
+  EXPECT_EQ(gold.quantity, 50);
+}
+
+TEST(RoomRewardTest, TypicalRewardsStayInline) {
+  Room room("room_01", Room::Type::Combat);
+  room.AddReward(Reward::Data(Reward::Type::Boon, Reward::God::Athena));
+  room.AddReward(Reward::Type::Gold);
+  room.AddReward(Reward::Type::Pom);
+
+  EXPECT_TRUE(room.GetRewards().IsInline());
+
+  Room copy = room;
+  ASSERT_EQ(copy.GetRewards().size(), 3);
+  EXPECT_EQ(copy.GetRewards()[0].GodName(), "Athena");
+  EXPECT_EQ(copy.GetRewards()[2].type, Reward::Type::Pom);
+}
+
+TEST(RoomRewardTest, RewardListGrowsPastInlineCapacity) {
+  Room room("room_01", Room::Type::Combat);
+  for (size_t i = 0; i < Reward::List::INLINE_CAPACITY + 2; ++i) {
+    room.AddReward(Reward::Data(Reward::Type::Gold, static_cast<int>(i)));
+  }
+
+  const auto& rewards = room.GetRewards();
+  EXPECT_FALSE(rewards.IsInline());
+  ASSERT_EQ(rewards.size(), Reward::List::INLINE_CAPACITY + 2);
+  for (size_t i = 0; i < rewards.size(); ++i) {
+    EXPECT_EQ(rewards[i].quantity, static_cast<int>(i));
+  }
+
+  room.ClearRewards();
+  EXPECT_TRUE(room.GetRewards().empty());
+  EXPECT_TRUE(room.GetRewards().IsInline());
 }
 
 TEST(RoomRewardTest, CanClearRewards) {
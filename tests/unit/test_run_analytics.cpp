@@ -0,0 +1,167 @@
+#include <gtest/gtest.h>
+
+#include <numeric>
+
+#include "analytics/RunAnalytics.h"
+#include "generation/PathGenerator.h"
+
+/**
+ * Test Suite: RoomTable
+ * Testing the flat per-room layout
+ */
+
+TEST(RoomTableTest, FlattensRoomsInIndexOrder) {
+  RunGraph graph;
+  auto* start = graph.AddRoom("start", Room::Type::Combat);
+  auto* shop = graph.AddRoom("shop", Room::Type::Shop);
+  start->SetOnCriticalPath(true);
+  shop->SetDepth(1);
+  shop->GetRoom()->SetDifficulty(1.5f);
+  shop->GetRoom()->AddReward(Reward::Type::Gold);
+  shop->GetRoom()->AddReward(Reward::Type::Pom);
+  graph.Connect(start, shop);
+
+  RoomTable table;
+  table.Assign(graph);
+  ASSERT_EQ(table.GetRoomCount(), 2u);
+  EXPECT_EQ(table.types[1], static_cast<uint8_t>(Room::Type::Shop));
+  EXPECT_EQ(table.depths[1], 1u);
+  EXPECT_EQ(table.difficulties[1], RoomTable::DIFFICULTY_SCALE * 3 / 2);
+  EXPECT_EQ(table.critical[0], 1);
+  EXPECT_EQ(table.critical[1], 0);
+  EXPECT_EQ(table.criticalLength, 1u);
+  EXPECT_EQ(table.rewards.size(), 2u);
+
+  // Reassigning reuses the table
+  RunGraph single;
+  single.AddRoom("only", Room::Type::Boss);
+  table.Assign(single);
+  EXPECT_EQ(table.GetRoomCount(), 1u);
+  EXPECT_TRUE(table.rewards.empty());
+}
+
+/**
+ * Test Suite: RunAnalytics
+ * Testing accumulation, merging and parallel collection
+ */
+
+TEST(RunAnalyticsTest, AccumulatesSingleRun) {
+  RunGraph graph;
+  RunGraph::Node* previous = nullptr;
+  const Room::Type types[] = {Room::Type::Combat, Room::Type::MiniBoss, Room::Type::Elite,
+                              Room::Type::MiniBoss, Room::Type::Boss};
+  for (int i = 0; i < 5; ++i) {
+    auto* node = graph.AddRoom("room_" + std::to_string(i), types[i]);
+    node->SetDepth(i);
+    node->SetOnCriticalPath(true);
+    node->GetRoom()->SetDifficulty(static_cast<float>(i + 1));
+    node->GetRoom()->AddReward(Reward::Type::Boon);
+    if (previous) graph.Connect(previous, node);
+    previous = node;
+  }
+
+  RunAnalytics analytics;
+  analytics.Add(graph);
+
+  EXPECT_EQ(analytics.GetRunCount(), 1u);
+  EXPECT_EQ(analytics.GetRoomCount(), 5u);
+  EXPECT_EQ(analytics.GetBranchRoomCount(), 0u);
+  EXPECT_EQ(analytics.GetDepthCount(), 5u);
+  EXPECT_EQ(analytics.GetTypeCount(1, Room::Type::MiniBoss), 1u);
+  EXPECT_EQ(analytics.GetTypeCount(Room::Type::MiniBoss), 2u);
+  EXPECT_DOUBLE_EQ(analytics.GetTypeFrequency(4, Room::Type::Boss), 1.0);
+  EXPECT_DOUBLE_EQ(analytics.GetMeanDifficulty(2), 3.0);
+  EXPECT_EQ(analytics.GetRewardCount(Reward::Type::Boon), 5u);
+
+  ASSERT_EQ(analytics.GetPathLengthHistogram().size(), 6u);
+  EXPECT_EQ(analytics.GetPathLengthHistogram()[5], 1u);
+  ASSERT_EQ(analytics.GetMiniBossSpacingHistogram().size(), 3u);
+  EXPECT_EQ(analytics.GetMiniBossSpacingHistogram()[2], 1u);
+
+  // Queries past the deepest room are empty rather than out of range
+  EXPECT_EQ(analytics.GetTypeCount(100, Room::Type::Combat), 0u);
+  EXPECT_DOUBLE_EQ(analytics.GetTypeFrequency(100, Room::Type::Combat), 0.0);
+}
+
+TEST(RunAnalyticsTest, MergeEqualsAddingEverything) {
+  PathGenerator generator(uint64_t{0});
+  RunAnalytics combined;
+  RunAnalytics even;
+  RunAnalytics odd;
+  for (uint64_t seed = 0; seed < 20; ++seed) {
+    generator.SetSeed(seed);
+    const RunGraph graph = generator.GeneratePath();
+    combined.Add(graph);
+    (seed % 2 ? odd : even).Add(graph);
+  }
+
+  odd.Merge(even);
+  EXPECT_EQ(odd, combined);
+}
+
+TEST(RunAnalyticsTest, CollectMatchesSequentialGeneration) {
+  PathGenerator::Config config;
+  config.branchProbability = 0.5f;
+
+  RunAnalytics expected;
+  PathGenerator generator(uint64_t{0});
+  generator.SetConfig(config);
+  for (uint64_t seed = 1000; seed < 1300; ++seed) {
+    generator.SetSeed(seed);
+    expected.Add(generator.GeneratePath());
+  }
+
+  EXPECT_EQ(RunAnalytics::Collect(config, 1000, 300, 1), expected);
+}
+
+TEST(RunAnalyticsTest, CollectIsIndependentOfThreadCount) {
+  const PathGenerator::Config config;
+  const RunAnalytics single = RunAnalytics::Collect(config, 0, 2000, 1);
+  const RunAnalytics parallel = RunAnalytics::Collect(config, 0, 2000, 4);
+  EXPECT_EQ(single, parallel);
+  EXPECT_EQ(parallel.GetRunCount(), 2000u);
+}
+
+TEST(RunAnalyticsTest, ReportsGeneratorDistributions) {
+  PathGenerator::Config config;
+  config.minRooms = 40;
+  config.maxRooms = 50;
+  config.miniBossInterval = 10;
+  const RunAnalytics analytics = RunAnalytics::Collect(config, 0, 1000, 2);
+
+  // Every run starts with combat and has a boss
+  EXPECT_DOUBLE_EQ(analytics.GetTypeFrequency(0, Room::Type::Combat), 1.0);
+  EXPECT_EQ(analytics.GetTypeCount(Room::Type::Boss), 1000u);
+
+  // Path lengths cover exactly the configured range
+  const auto lengths = analytics.GetPathLengthHistogram();
+  EXPECT_EQ(std::accumulate(lengths.begin(), lengths.end(), uint64_t{0}), 1000u);
+  ASSERT_EQ(lengths.size(), 51u);
+  for (size_t length = 0; length < 40; ++length) {
+    EXPECT_EQ(lengths[length], 0u) << "length " << length;
+  }
+  for (size_t length = 40; length <= 50; ++length) {
+    EXPECT_GT(lengths[length], 0u) << "length " << length;
+  }
+
+  // Mini-bosses sit every 10 rooms (a boss at depth 40 ends the last gap)
+  const auto spacing = analytics.GetMiniBossSpacingHistogram();
+  ASSERT_GT(spacing.size(), 10u);
+  EXPECT_EQ(std::accumulate(spacing.begin(), spacing.end(), uint64_t{0}), spacing[10]);
+
+  // Shops follow their guarantee: at least two per run
+  EXPECT_GE(analytics.GetTypeCount(Room::Type::Shop), 2000u);
+  EXPECT_GT(analytics.GetBranchRoomCount(), 0u);
+}
+
+TEST(RunAnalyticsTest, CollectRejectsInvalidConfig) {
+  PathGenerator::Config config;
+  config.roomTypeWeights[0].fill(0.0f);
+  EXPECT_THROW(RunAnalytics::Collect(config, 0, 10, 1), std::invalid_argument);
+}
+
+TEST(RunAnalyticsTest, CollectOfNoSeedsIsEmpty) {
+  const RunAnalytics analytics = RunAnalytics::Collect(PathGenerator::Config{}, 0, 0, 2);
+  EXPECT_EQ(analytics.GetRunCount(), 0u);
+  EXPECT_EQ(analytics, RunAnalytics{});
+}
@@ -0,0 +1,156 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <thread>
+#include <vector>
+
+#include "generation/RunCache.h"
+
+namespace {
+RunGraph Generate(uint64_t seed, const PathGenerator::Config& config = {}) {
+  PathGenerator generator(seed);
+  generator.SetConfig(config);
+  return generator.GeneratePath();
+}
+
+// Cached runs hold their filled path cache
+size_t EntryBytes(uint64_t seed) {
+  const RunGraph graph = Generate(seed);
+  graph.PrecomputePaths();
+  return graph.GetMemoryUsage() + RunCache::ENTRY_OVERHEAD_BYTES;
+}
+}  // namespace
+
+/**
+ * Test Suite: RunCache
+ * Testing hits, byte-bounded LRU eviction and shared handles
+ */
+
+TEST(RunCacheTest, HitsShareOneGraph) {
+  RunCache cache(1 << 20);
+  const PathGenerator::Config config;
+
+  const RunCache::Handle first = cache.GetOrGenerate(7, config);
+  const RunCache::Handle second = cache.GetOrGenerate(7, config);
+  EXPECT_EQ(first.get(), second.get());
+
+  const RunGraph expected = Generate(7);
+  ASSERT_EQ(first->GetNodeCount(), expected.GetNodeCount());
+  for (RunGraph::NodeIndex i = 0; i < expected.GetNodeCount(); ++i) {
+    EXPECT_EQ(first->GetNode(i)->GetRoom()->GetType(), expected.GetNode(i)->GetRoom()->GetType());
+  }
+
+  const RunCache::Counters counters = cache.GetCounters();
+  EXPECT_EQ(counters.hits, 1u);
+  EXPECT_EQ(counters.misses, 1u);
+  EXPECT_EQ(counters.entries, 1u);
+  EXPECT_EQ(counters.bytes, first->GetMemoryUsage() + RunCache::ENTRY_OVERHEAD_BYTES);
+}
+
+TEST(RunCacheTest, ConfigIsPartOfTheKey) {
+  PathGenerator::Config shortRuns;
+  shortRuns.minRooms = 10;
+  shortRuns.maxRooms = 10;
+  PathGenerator::Config otherWeights;
+  otherWeights.roomTypeWeights[static_cast<size_t>(otherWeights.biome)][0] = 1.0f;
+
+  const uint64_t defaultHash = RunCache::HashConfig(PathGenerator::Config{});
+  EXPECT_EQ(RunCache::HashConfig(PathGenerator::Config{}), defaultHash);
+  EXPECT_NE(RunCache::HashConfig(shortRuns), defaultHash);
+  EXPECT_NE(RunCache::HashConfig(otherWeights), defaultHash);
+
+  RunCache cache(1 << 20);
+  const auto normal = cache.GetOrGenerate(3, PathGenerator::Config{});
+  const auto shortRun = cache.GetOrGenerate(3, shortRuns);
+  EXPECT_NE(normal.get(), shortRun.get());
+  EXPECT_EQ(shortRun->GetCriticalPath().size(), 10u);
+  EXPECT_EQ(cache.GetCounters().misses, 2u);
+}
+
+TEST(RunCacheTest, EvictsLeastRecentlyUsedByBytes) {
+  // Exactly seeds 0-2 fit
+  RunCache cache(EntryBytes(0) + EntryBytes(1) + EntryBytes(2), 1);
+  const PathGenerator::Config config;
+  const uint64_t hash = RunCache::HashConfig(config);
+
+  for (uint64_t seed = 0; seed < 3; ++seed) {
+    cache.GetOrGenerate(seed, config, hash);
+  }
+  ASSERT_EQ(cache.GetCounters().evictions, 0u);
+
+  // Seed 0 becomes the most recent, so seed 1 is evicted
+  ASSERT_NE(cache.Find({0, hash}), nullptr);
+  cache.GetOrGenerate(3, config, hash);
+  EXPECT_GE(cache.GetCounters().evictions, 1u);
+  EXPECT_EQ(cache.Find({1, hash}), nullptr);
+  EXPECT_NE(cache.Find({0, hash}), nullptr);
+  EXPECT_LE(cache.GetCounters().bytes, cache.GetByteBudget());
+}
+
+TEST(RunCacheTest, HandlesOutliveEviction) {
+  RunCache cache(EntryBytes(1), 1);
+  const RunCache::Handle kept = cache.GetOrGenerate(1, PathGenerator::Config{});
+  const size_t rooms = kept->GetNodeCount();
+
+  cache.GetOrGenerate(2, PathGenerator::Config{});
+  cache.GetOrGenerate(3, PathGenerator::Config{});
+  cache.Clear();
+  EXPECT_EQ(cache.GetCounters().entries, 0u);
+  EXPECT_EQ(cache.GetCounters().bytes, 0u);
+  EXPECT_EQ(kept->GetNodeCount(), rooms);
+  EXPECT_FALSE(kept->GetCriticalPath().empty());
+}
+
+TEST(RunCacheTest, OversizedRunsAreReturnedUncached) {
+  RunCache cache(64, 1);
+  const RunCache::Handle run = cache.GetOrGenerate(1, PathGenerator::Config{});
+  ASSERT_NE(run, nullptr);
+  EXPECT_EQ(cache.GetCounters().entries, 0u);
+  EXPECT_EQ(cache.GetCounters().evictions, 0u);
+}
+
+TEST(RunCacheTest, InsertKeepsTheExistingRun) {
+  RunCache cache(1 << 20);
+  const RunCache::Key key{5, 9};
+  const auto first = cache.Insert(key, Generate(5));
+  EXPECT_EQ(cache.Insert(key, Generate(6)).get(), first.get());
+
+  RunGraph unfinalized;
+  unfinalized.AddRoom("room", Room::Type::Combat);
+  EXPECT_THROW(cache.Insert({1, 1}, std::move(unfinalized)), std::invalid_argument);
+  EXPECT_THROW(RunCache(1024, 0), std::invalid_argument);
+}
+
+TEST(RunCacheTest, ConcurrentCallersShareHandles) {
+  constexpr int THREADS = 4;
+  constexpr uint64_t SEEDS = 32;
+  RunCache cache(16 << 20, 4);
+  const PathGenerator::Config config;
+  std::vector<std::vector<RunCache::Handle>> seen(THREADS);
+
+  std::vector<std::thread> threads;
+  for (int t = 0; t < THREADS; ++t) {
+    threads.emplace_back([&, t] {
+      for (int round = 0; round < 3; ++round) {
+        for (uint64_t seed = 0; seed < SEEDS; ++seed) {
+          seen[t].push_back(cache.GetOrGenerate((seed * 7 + t) % SEEDS, config));
+        }
+      }
+    });
+  }
+  for (auto& thread : threads) thread.join();
+
+  // Nothing was evicted, so every caller got the one cached graph per seed
+  std::vector<const RunGraph*> bySeed(SEEDS, nullptr);
+  for (int t = 0; t < THREADS; ++t) {
+    for (size_t i = 0; i < seen[t].size(); ++i) {
+      const uint64_t seed = ((i % SEEDS) * 7 + t) % SEEDS;
+      if (!bySeed[seed]) bySeed[seed] = seen[t][i].get();
+      EXPECT_EQ(seen[t][i].get(), bySeed[seed]) << "seed " << seed;
+    }
+  }
+  const RunCache::Counters counters = cache.GetCounters();
+  EXPECT_EQ(counters.entries, SEEDS);
+  EXPECT_EQ(counters.evictions, 0u);
+  EXPECT_EQ(counters.hits + counters.misses, THREADS * 3 * SEEDS);
+}
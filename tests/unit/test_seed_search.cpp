@@ -0,0 +1,227 @@
+#include <gtest/gtest.h>
+
+#include <stdexcept>
+#include <vector>
+
+#include "generation/PathGenerator.h"
+#include "generation/SeedSearch.h"
+
+namespace {
+using Stage = RunPredicate::Stage;
+using Verdict = RunPredicate::Verdict;
+
+RunPredicate::View LengthView(int length) {
+  RunPredicate::View view;
+  view.criticalLength = length;
+  return view;
+}
+
+RunPredicate::View TypesView(const std::vector<Room::Type>& types) {
+  RunPredicate::View view;
+  view.stage = Stage::RoomTypes;
+  view.criticalLength = static_cast<int>(types.size());
+  view.criticalTypes = types;
+  return view;
+}
+
+RunPredicate DesignerQuery() {
+  return RunPredicate::AtLeast(Room::Type::Fountain, 3, 0, 20) &&
+         RunPredicate::AtMost(Room::Type::Elite, 0, 0, 5);
+}
+
+// Lowest matching seeds in [first, first + count), by full generation
+std::vector<uint64_t> BruteForce(const RunPredicate& predicate, uint64_t first, uint64_t count,
+                                 size_t wanted) {
+  PathGenerator generator(first);
+  std::vector<uint64_t> seeds;
+  for (uint64_t seed = first; seed < first + count && seeds.size() < wanted; ++seed) {
+    generator.SetSeed(seed);
+    if (predicate.Matches(generator.GeneratePath())) seeds.push_back(seed);
+  }
+  return seeds;
+}
+}  // namespace
+
+/**
+ * Test Suite: RunPredicate
+ * Testing staged verdicts and composition
+ */
+
+TEST(RunPredicateTest, RoomCountDecidesFromLengthWhenItCan) {
+  // Window of 3 rooms cannot hold 4 Fountains
+  EXPECT_EQ(RunPredicate::AtLeast(Room::Type::Fountain, 4, 0, 3).Evaluate(LengthView(40)),
+            Verdict::Reject);
+  // The window starts past the end of the run
+  EXPECT_EQ(RunPredicate::AtLeast(Room::Type::Fountain, 1, 50).Evaluate(LengthView(40)),
+            Verdict::Reject);
+  // At most 5 Elites in 5 rooms always holds
+  EXPECT_EQ(RunPredicate::AtMost(Room::Type::Elite, 5, 0, 5).Evaluate(LengthView(40)),
+            Verdict::Accept);
+  EXPECT_EQ(RunPredicate::AtMost(Room::Type::Elite, 0, 0, 5).Evaluate(LengthView(40)),
+            Verdict::Pending);
+}
+
+TEST(RunPredicateTest, RoomCountCountsOnlyItsWindow) {
+  using T = Room::Type;
+  const std::vector<T> types = {T::Combat, T::Elite, T::Fountain, T::Fountain, T::Elite, T::Boss};
+
+  EXPECT_EQ(RunPredicate::AtLeast(T::Fountain, 2, 0, 4).Evaluate(TypesView(types)),
+            Verdict::Accept);
+  EXPECT_EQ(RunPredicate::AtLeast(T::Fountain, 2, 3).Evaluate(TypesView(types)), Verdict::Reject);
+  EXPECT_EQ(RunPredicate::AtMost(T::Elite, 0, 2, 4).Evaluate(TypesView(types)), Verdict::Accept);
+  EXPECT_EQ(RunPredicate::RoomCount(T::Elite, 1, 1).Evaluate(TypesView(types)), Verdict::Reject);
+  EXPECT_EQ(RunPredicate::PathLength(6, 6).Evaluate(TypesView(types)), Verdict::Accept);
+}
+
+TEST(RunPredicateTest, CombinatorsPropagatePending) {
+  const RunPredicate pending = RunPredicate::AtMost(Room::Type::Elite, 0, 0, 5);
+  const RunPredicate accept = RunPredicate::PathLength(1, 100);
+  const RunPredicate reject = RunPredicate::PathLength(1, 10);
+  const RunPredicate::View view = LengthView(40);
+
+  EXPECT_EQ((pending && accept).Evaluate(view), Verdict::Pending);
+  EXPECT_EQ((pending && reject).Evaluate(view), Verdict::Reject);
+  EXPECT_EQ((pending || accept).Evaluate(view), Verdict::Accept);
+  EXPECT_EQ((pending || reject).Evaluate(view), Verdict::Pending);
+  EXPECT_EQ((!pending).Evaluate(view), Verdict::Pending);
+  EXPECT_EQ((!reject).Evaluate(view), Verdict::Accept);
+  EXPECT_EQ(RunPredicate::All({}).Evaluate(view), Verdict::Accept);
+  EXPECT_EQ(RunPredicate::Any({}).Evaluate(view), Verdict::Reject);
+  EXPECT_EQ(RunPredicate().Evaluate(view), Verdict::Accept);
+}
+
+TEST(RunPredicateTest, RejectsInvalidTerms) {
+  EXPECT_THROW(RunPredicate::RoomCount(Room::Type::Shop, 3, 2), std::invalid_argument);
+  EXPECT_THROW(RunPredicate::AtLeast(Room::Type::Shop, 1, 10, 5), std::invalid_argument);
+  EXPECT_THROW(RunPredicate::PathLength(10, 5), std::invalid_argument);
+  EXPECT_THROW(RunPredicate::Custom(nullptr), std::invalid_argument);
+}
+
+/**
+ * Test Suite: Predicated Generation
+ * Testing that GeneratePathIf agrees with GeneratePath and stops early
+ */
+
+TEST(PredicatedGenerationTest, AgreesWithFullGeneration) {
+  const RunPredicate query = DesignerQuery();
+  PathGenerator full(uint64_t{0});
+  PathGenerator predicated(uint64_t{0});
+  int matches = 0;
+
+  for (uint64_t seed = 0; seed < 200; ++seed) {
+    full.SetSeed(seed);
+    predicated.SetSeed(seed);
+    const RunGraph graph = full.GeneratePath();
+    const auto match = predicated.GeneratePathIf(query);
+
+    ASSERT_EQ(match.has_value(), query.Matches(graph)) << "seed " << seed;
+    if (!match) continue;
+    ++matches;
+    ASSERT_EQ(match->GetNodeCount(), graph.GetNodeCount());
+    ASSERT_EQ(match->GetEdgeCount(), graph.GetEdgeCount());
+    for (RunGraph::NodeIndex i = 0; i < graph.GetNodeCount(); ++i) {
+      EXPECT_EQ(match->GetNode(i)->GetRoom()->GetType(), graph.GetNode(i)->GetRoom()->GetType());
+    }
+  }
+  // The query is selective but not empty
+  EXPECT_GT(matches, 0);
+  EXPECT_LT(matches, 200);
+}
+
+TEST(PredicatedGenerationTest, StopsAtTheFirstRejectingStage) {
+  std::vector<Stage> stages;
+  const RunPredicate recordThenReject = RunPredicate::Custom([&](const RunPredicate::View& view) {
+    stages.push_back(view.stage);
+    return view.stage == Stage::RoomTypes ? Verdict::Reject : Verdict::Pending;
+  });
+
+  PathGenerator generator(uint64_t{5});
+  GenerationStats stats;
+  generator.SetStats(&stats);
+  EXPECT_FALSE(generator.GeneratePathIf(recordThenReject).has_value());
+  EXPECT_EQ(stages, (std::vector<Stage>{Stage::Length, Stage::RoomTypes}));
+  if constexpr (Stats::ENABLED) {
+    EXPECT_EQ(stats.roomsCreated, 0u);  // Graph never built
+  }
+}
+
+TEST(PredicatedGenerationTest, DecidedPredicatesSkipLaterStages) {
+  std::vector<Stage> stages;
+  const RunPredicate accept = RunPredicate::Custom([&](const RunPredicate::View& view) {
+    stages.push_back(view.stage);
+    return Verdict::Accept;
+  });
+
+  PathGenerator generator(uint64_t{5});
+  EXPECT_TRUE(generator.GeneratePathIf(accept).has_value());
+  EXPECT_EQ(stages, std::vector<Stage>{Stage::Length});
+}
+
+TEST(PredicatedGenerationTest, PendingAtCompletionRejects) {
+  const RunPredicate undecided =
+      RunPredicate::Custom([](const RunPredicate::View&) { return Verdict::Pending; });
+  PathGenerator generator(uint64_t{5});
+  EXPECT_FALSE(generator.GeneratePathIf(undecided).has_value());
+}
+
+/**
+ * Test Suite: SeedSearch
+ * Testing parallel search results against brute force
+ */
+
+TEST(SeedSearchTest, FindsLowestMatchingSeeds) {
+  const RunPredicate query = DesignerQuery();
+  SeedSearch::Options options;
+  options.firstSeed = 1000;
+  options.maxMatches = 10;
+  options.threadCount = 1;
+
+  const SeedSearch::Result result = SeedSearch::Find(PathGenerator::Config{}, query, options);
+  EXPECT_EQ(result.seeds, BruteForce(query, 1000, UINT64_MAX - 1000, 10));
+  EXPECT_EQ(result.seedsGenerated, result.seeds.back() - 1000 + 1);
+}
+
+TEST(SeedSearchTest, IdenticalAcrossThreadCounts) {
+  const RunPredicate query = DesignerQuery();
+  SeedSearch::Options options;
+  options.maxMatches = 25;
+
+  options.threadCount = 1;
+  const auto expected = SeedSearch::Find(PathGenerator::Config{}, query, options).seeds;
+  ASSERT_EQ(expected.size(), 25u);
+  for (unsigned threads : {2u, 4u, 8u}) {
+    options.threadCount = threads;
+    EXPECT_EQ(SeedSearch::Find(PathGenerator::Config{}, query, options).seeds, expected)
+        << threads << " threads";
+  }
+}
+
+TEST(SeedSearchTest, StopsAtTheEndOfTheRange) {
+  const RunPredicate query = DesignerQuery();
+  SeedSearch::Options options;
+  options.firstSeed = 7;
+  options.seedCount = 300;
+  options.maxMatches = 1'000'000;
+  options.threadCount = 3;
+
+  const SeedSearch::Result result = SeedSearch::Find(PathGenerator::Config{}, query, options);
+  EXPECT_EQ(result.seeds, BruteForce(query, 7, 300, SIZE_MAX));
+  EXPECT_EQ(result.seedsGenerated, 300u);
+}
+
+TEST(SeedSearchTest, ImpossibleQueryScansWholeRange) {
+  // Default runs are 40-50 rooms long
+  SeedSearch::Options options;
+  options.seedCount = 1000;
+  const SeedSearch::Result result =
+      SeedSearch::Find(PathGenerator::Config{}, RunPredicate::PathLength(60, 70), options);
+  EXPECT_TRUE(result.seeds.empty());
+  EXPECT_EQ(result.seedsGenerated, 1000u);
+}
+
+TEST(SeedSearchTest, ValidatesConfig) {
+  PathGenerator::Config config;
+  config.roomTypeWeights[static_cast<size_t>(config.biome)].fill(0.0f);
+  EXPECT_THROW(SeedSearch::Find(config, RunPredicate(), SeedSearch::Options{}),
+               std::invalid_argument);
+}
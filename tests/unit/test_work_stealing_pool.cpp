@@ -0,0 +1,79 @@
+#include <gtest/gtest.h>
+
+#include <atomic>
+#include <stdexcept>
+#include <vector>
+
+#include "util/WorkStealingPool.h"
+
+/**
+ * Test Suite: WorkStealingPool
+ * Testing that every index runs exactly once across workers
+ */
+
+TEST(WorkStealingPoolTest, ResolvesThreadCount) {
+  WorkStealingPool pool(3);
+  EXPECT_EQ(pool.GetThreadCount(), 3u);
+  EXPECT_GE(WorkStealingPool::ResolveThreadCount(0), 1u);
+}
+
+TEST(WorkStealingPoolTest, RunsEveryIndexExactlyOnce) {
+  WorkStealingPool pool(4);
+
+  std::vector<std::atomic<int>> hits(10'000);
+  pool.ParallelFor(hits.size(), [&](size_t index, unsigned worker) {
+    EXPECT_LT(worker, 4u);
+    hits[index].fetch_add(1);
+  });
+
+  for (size_t i = 0; i < hits.size(); ++i) {
+    EXPECT_EQ(hits[i].load(), 1) << "Index " << i;
+  }
+}
+
+TEST(WorkStealingPoolTest, BalancesUnevenWork) {
+  WorkStealingPool pool(4);
+
+  // All the expensive items sit in worker 0's initial range
+  std::atomic<int> total = 0;
+  pool.ParallelFor(400, [&](size_t index, unsigned) {
+    volatile int sink = 0;
+    const int spins = index < 100 ? 20'000 : 10;
+    for (int i = 0; i < spins; ++i) sink = sink + 1;
+    total.fetch_add(1);
+  });
+
+  EXPECT_EQ(total.load(), 400);
+}
+
+TEST(WorkStealingPoolTest, CanRunSeveralJobs) {
+  WorkStealingPool pool(3);
+
+  for (int job = 0; job < 20; ++job) {
+    std::atomic<size_t> sum = 0;
+    pool.ParallelFor(100, [&](size_t index, unsigned) { sum.fetch_add(index); });
+    EXPECT_EQ(sum.load(), 4950u);
+  }
+}
+
+TEST(WorkStealingPoolTest, EmptyRangeIsNoOp) {
+  WorkStealingPool pool(2);
+  bool called = false;
+  pool.ParallelFor(0, [&](size_t, unsigned) { called = true; });
+  EXPECT_FALSE(called);
+}
+
+TEST(WorkStealingPoolTest, PropagatesExceptions) {
+  WorkStealingPool pool(4);
+
+  EXPECT_THROW(pool.ParallelFor(1000,
+                                [](size_t index, unsigned) {
+                                  if (index == 500) throw std::runtime_error("boom");
+                                }),
+               std::runtime_error);
+
+  // Pool is still usable afterwards
+  std::atomic<int> count = 0;
+  pool.ParallelFor(10, [&](size_t, unsigned) { count.fetch_add(1); });
+  EXPECT_EQ(count.load(), 10);
+}